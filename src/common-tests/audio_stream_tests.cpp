@@ -0,0 +1,236 @@
+#include "common/audio_stream.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+class TestAudioStream final : public AudioStream
+{
+public:
+  using AudioStream::GetSamplesAvailable;
+  using AudioStream::ReadFrames;
+
+protected:
+  bool OpenDevice() override { return true; }
+  void PauseDevice(bool paused) override {}
+  void CloseDevice() override {}
+  void FramesAvailable() override {}
+};
+
+static constexpr u32 SAMPLE_RATE = 44100;
+static constexpr u32 CHANNELS = 2;
+static constexpr u32 BUFFER_SIZE = 256;
+
+// The ring holds twice the configured buffer size.
+static constexpr u32 RING_FRAMES = BUFFER_SIZE * 2;
+
+// Frames carry a 30-bit counter split across both channels, zero is never written.
+static void MakeFrames(std::vector<AudioStream::SampleType>* frames, u32 first, u32 count)
+{
+  frames->resize(count * CHANNELS);
+  for (u32 i = 0; i < count; i++)
+  {
+    (*frames)[i * CHANNELS + 0] = static_cast<s16>((first + i) >> 15);
+    (*frames)[i * CHANNELS + 1] = static_cast<s16>((first + i) & 0x7FFF);
+  }
+}
+
+static u32 GetFrameCounter(const AudioStream::SampleType* frame)
+{
+  return (static_cast<u32>(frame[0]) << 15) | static_cast<u32>(frame[1]);
+}
+} // namespace
+
+TEST(AudioStream, WrapsAroundRing)
+{
+  TestAudioStream stream;
+  ASSERT_TRUE(stream.Reconfigure(SAMPLE_RATE, CHANNELS, BUFFER_SIZE));
+  stream.SetSync(false);
+
+  // 300 frames doesn't divide the ring, so the copies straddle the end of it in different places.
+  static constexpr u32 CHUNK_FRAMES = 300;
+  std::vector<AudioStream::SampleType> frames;
+  std::vector<AudioStream::SampleType> read_frames(CHUNK_FRAMES * CHANNELS);
+  u32 counter = 1;
+  for (u32 i = 0; i < 4 * AudioStream::MaxSamples / (CHUNK_FRAMES * CHANNELS); i++)
+  {
+    MakeFrames(&frames, counter, CHUNK_FRAMES);
+    stream.WriteFrames(frames.data(), CHUNK_FRAMES);
+    ASSERT_EQ(stream.GetSamplesAvailable(), CHUNK_FRAMES);
+
+    stream.ReadFrames(read_frames.data(), CHUNK_FRAMES, false);
+    ASSERT_EQ(read_frames, frames);
+    ASSERT_EQ(stream.GetSamplesAvailable(), 0u);
+    counter += CHUNK_FRAMES;
+  }
+
+  ASSERT_FALSE(stream.DidUnderflow());
+  ASSERT_EQ(stream.GetUnderflowCount(), 0u);
+}
+
+TEST(AudioStream, FullRingDropsOldestFramesWithoutSync)
+{
+  TestAudioStream stream;
+  ASSERT_TRUE(stream.Reconfigure(SAMPLE_RATE, CHANNELS, BUFFER_SIZE));
+  stream.SetSync(false);
+
+  std::vector<AudioStream::SampleType> frames;
+  MakeFrames(&frames, 1, RING_FRAMES);
+  stream.WriteFrames(frames.data(), RING_FRAMES);
+  ASSERT_EQ(stream.GetSamplesAvailable(), RING_FRAMES);
+  ASSERT_EQ(stream.GetDroppedFrameCount(), 0u);
+
+  // The new frames are kept, and the consumer skips the oldest ones to make room.
+  std::vector<AudioStream::SampleType> extra_frames;
+  MakeFrames(&extra_frames, RING_FRAMES + 1, 100);
+  stream.WriteFrames(extra_frames.data(), 100);
+  ASSERT_EQ(stream.GetSamplesAvailable(), RING_FRAMES);
+  ASSERT_EQ(stream.GetDroppedFrameCount(), 100u);
+
+  std::vector<AudioStream::SampleType> expected_frames;
+  MakeFrames(&expected_frames, 101, RING_FRAMES);
+  std::vector<AudioStream::SampleType> read_frames(RING_FRAMES * CHANNELS);
+  stream.ReadFrames(read_frames.data(), RING_FRAMES, false);
+  ASSERT_EQ(read_frames, expected_frames);
+  ASSERT_EQ(stream.GetSamplesAvailable(), 0u);
+  ASSERT_FALSE(stream.DidUnderflow());
+
+  ASSERT_FLOAT_EQ(stream.GetMaxLatency(), AudioStream::GetMaxLatency(SAMPLE_RATE, RING_FRAMES));
+  ASSERT_FLOAT_EQ(stream.GetAndResetPeakLatency(), stream.GetMaxLatency());
+  ASSERT_FLOAT_EQ(stream.GetAndResetPeakLatency(), 0.0f);
+}
+
+TEST(AudioStream, FullRingDropsOldestFramesWithoutConsumer)
+{
+  TestAudioStream stream;
+  ASSERT_TRUE(stream.Reconfigure(SAMPLE_RATE, CHANNELS, BUFFER_SIZE));
+  stream.SetSync(true);
+
+  std::vector<AudioStream::SampleType> frames;
+  MakeFrames(&frames, 1, RING_FRAMES);
+  stream.WriteFrames(frames.data(), RING_FRAMES);
+  ASSERT_EQ(stream.GetSamplesAvailable(), RING_FRAMES);
+
+  // Nothing reads from a paused device, so the oldest frames are dropped straight away.
+  std::vector<AudioStream::SampleType> extra_frames;
+  MakeFrames(&extra_frames, RING_FRAMES + 1, 100);
+  stream.WriteFrames(extra_frames.data(), 100);
+  ASSERT_EQ(stream.GetSamplesAvailable(), RING_FRAMES);
+  ASSERT_EQ(stream.GetDroppedFrameCount(), 100u);
+
+  // A running device which stops reading is given up on after a bounded wait.
+  std::vector<AudioStream::SampleType> more_frames;
+  MakeFrames(&more_frames, RING_FRAMES + 101, 100);
+  stream.PauseOutput(false);
+  stream.WriteFrames(more_frames.data(), 100);
+  ASSERT_EQ(stream.GetSamplesAvailable(), RING_FRAMES);
+  ASSERT_EQ(stream.GetDroppedFrameCount(), 200u);
+
+  std::vector<AudioStream::SampleType> expected_frames;
+  MakeFrames(&expected_frames, 201, RING_FRAMES);
+  std::vector<AudioStream::SampleType> read_frames(RING_FRAMES * CHANNELS);
+  stream.ReadFrames(read_frames.data(), RING_FRAMES, false);
+  ASSERT_EQ(read_frames, expected_frames);
+
+  stream.EmptyBuffers();
+  ASSERT_EQ(stream.GetDroppedFrameCount(), 0u);
+}
+
+TEST(AudioStream, EmptyRingUnderflows)
+{
+  TestAudioStream stream;
+  ASSERT_TRUE(stream.Reconfigure(SAMPLE_RATE, CHANNELS, BUFFER_SIZE));
+  stream.SetSync(false);
+
+  std::array<AudioStream::SampleType, 64 * CHANNELS> read_frames;
+  read_frames.fill(1);
+  stream.ReadFrames(read_frames.data(), 64, false);
+  for (AudioStream::SampleType sample : read_frames)
+    ASSERT_EQ(sample, 0);
+  ASSERT_TRUE(stream.DidUnderflow());
+  ASSERT_FALSE(stream.DidUnderflow());
+  ASSERT_EQ(stream.GetUnderflowCount(), 1u);
+
+  // A partial read stretches what is there over the whole request.
+  std::vector<AudioStream::SampleType> frames;
+  MakeFrames(&frames, 1, 16);
+  stream.WriteFrames(frames.data(), 16);
+  stream.ReadFrames(read_frames.data(), 64, false);
+  u32 last_counter = 0;
+  for (u32 i = 0; i < 64; i++)
+  {
+    const u32 frame_counter = GetFrameCounter(&read_frames[i * CHANNELS]);
+    ASSERT_GE(frame_counter, last_counter);
+    ASSERT_GE(frame_counter, 1u);
+    ASSERT_LE(frame_counter, 16u);
+    last_counter = frame_counter;
+  }
+  ASSERT_EQ(stream.GetSamplesAvailable(), 0u);
+  ASSERT_EQ(stream.GetUnderflowCount(), 2u);
+
+  stream.EmptyBuffers();
+  ASSERT_EQ(stream.GetUnderflowCount(), 0u);
+  ASSERT_FALSE(stream.DidUnderflow());
+}
+
+TEST(AudioStream, EmptyBuffersWhileReading)
+{
+  TestAudioStream stream;
+  ASSERT_TRUE(stream.Reconfigure(SAMPLE_RATE, CHANNELS, BUFFER_SIZE));
+  stream.SetSync(true);
+  stream.PauseOutput(false);
+
+  // The consumer must never see the counter go backwards. Frames read before an empty can be stale, but never newer
+  // than ones read afterwards.
+  std::atomic_bool done{false};
+  std::atomic_bool out_of_order{false};
+  std::atomic<u32> frames_seen{0};
+  std::thread consumer([&]() {
+    std::array<AudioStream::SampleType, 64 * CHANNELS> read_frames;
+    u32 last_counter = 0;
+    while (!done.load())
+    {
+      stream.ReadFrames(read_frames.data(), 64, false);
+      for (u32 i = 0; i < 64; i++)
+      {
+        const u32 frame_counter = GetFrameCounter(&read_frames[i * CHANNELS]);
+        if (frame_counter == 0)
+          continue;
+
+        if (frame_counter < last_counter)
+          out_of_order.store(true);
+
+        last_counter = frame_counter;
+        frames_seen.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  static constexpr u32 CHUNK_FRAMES = 100;
+  std::vector<AudioStream::SampleType> frames;
+  u32 counter = 1;
+  for (u32 i = 0; i < 2000; i++)
+  {
+    MakeFrames(&frames, counter, CHUNK_FRAMES);
+    stream.WriteFrames(frames.data(), CHUNK_FRAMES);
+    counter += CHUNK_FRAMES;
+
+    if ((i % 7) == 0)
+      stream.EmptyBuffers();
+  }
+
+  done.store(true);
+  consumer.join();
+
+  ASSERT_FALSE(out_of_order.load());
+  ASSERT_GT(frames_seen.load(), 0u);
+
+  // The read position must not have passed the write position.
+  stream.EmptyBuffers();
+  ASSERT_EQ(stream.GetSamplesAvailable(), 0u);
+  MakeFrames(&frames, counter, CHUNK_FRAMES);
+  stream.WriteFrames(frames.data(), CHUNK_FRAMES);
+  ASSERT_EQ(stream.GetSamplesAvailable(), CHUNK_FRAMES);
+}
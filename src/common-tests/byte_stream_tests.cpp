@@ -0,0 +1,145 @@
+#include "common/byte_stream.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+// Runs of repeated bytes mixed with noise, so deflate has something to do but can't collapse it all.
+static std::vector<u8> MakeData(u32 size)
+{
+  std::vector<u8> data(size);
+  u32 seed = 0x12345678u;
+  for (u32 i = 0; i < size; i++)
+  {
+    seed = seed * 1103515245u + 12345u;
+    data[i] = ((i / 64) & 1) ? static_cast<u8>(seed >> 24) : static_cast<u8>(i / 64);
+  }
+
+  return data;
+}
+
+static std::vector<u8> Compress(const std::vector<u8>& data, int level)
+{
+  std::unique_ptr<GrowableMemoryByteStream> base = ByteStream_CreateGrowableMemoryStream();
+  std::unique_ptr<ByteStream> stream = ByteStream_CreateZlibCompressStream(base.get(), level);
+  EXPECT_NE(stream, nullptr);
+  if (!stream)
+    return {};
+
+  // Odd-sized writes, so they don't line up with the internal buffer.
+  for (u32 offset = 0; offset < static_cast<u32>(data.size());)
+  {
+    const u32 size = std::min<u32>(static_cast<u32>(data.size()) - offset, 1237);
+    EXPECT_TRUE(stream->Write2(&data[offset], size));
+    offset += size;
+  }
+
+  EXPECT_TRUE(stream->Commit());
+  EXPECT_EQ(stream->GetSize(), data.size());
+
+  const u8* compressed = base->GetMemoryPointer();
+  return std::vector<u8>(compressed, compressed + base->GetSize());
+}
+
+static bool Decompress(const std::vector<u8>& compressed, u32 compressed_size, u32 uncompressed_size,
+                       std::vector<u8>* data)
+{
+  std::unique_ptr<ReadOnlyMemoryByteStream> base =
+    ByteStream_CreateReadOnlyMemoryStream(compressed.data(), static_cast<u32>(compressed.size()));
+  std::unique_ptr<ByteStream> stream =
+    ByteStream_CreateZlibDecompressStream(base.get(), compressed_size, uncompressed_size);
+  if (!stream)
+    return false;
+
+  data->resize(uncompressed_size);
+  for (u32 offset = 0; offset < uncompressed_size;)
+  {
+    const u32 size = std::min<u32>(uncompressed_size - offset, 4099);
+    if (!stream->Read2(&(*data)[offset], size))
+      return false;
+
+    offset += size;
+  }
+
+  return (stream->GetPosition() == uncompressed_size);
+}
+} // namespace
+
+TEST(ByteStream, ZlibRoundTrip)
+{
+  const std::vector<u8> data = MakeData(300 * 1024);
+  for (const int level : {0, 1, 6, 9})
+  {
+    const std::vector<u8> compressed = Compress(data, level);
+    ASSERT_FALSE(compressed.empty());
+    if (level > 0)
+    {
+      ASSERT_LT(compressed.size(), data.size());
+    }
+
+    std::vector<u8> decompressed;
+    ASSERT_TRUE(Decompress(compressed, static_cast<u32>(compressed.size()), static_cast<u32>(data.size()),
+                           &decompressed));
+    ASSERT_EQ(decompressed, data);
+  }
+}
+
+TEST(ByteStream, ZlibReadPastEndFails)
+{
+  const std::vector<u8> data = MakeData(4096);
+  const std::vector<u8> compressed = Compress(data, 6);
+
+  std::unique_ptr<ReadOnlyMemoryByteStream> base =
+    ByteStream_CreateReadOnlyMemoryStream(compressed.data(), static_cast<u32>(compressed.size()));
+  std::unique_ptr<ByteStream> stream = ByteStream_CreateZlibDecompressStream(
+    base.get(), static_cast<u32>(compressed.size()), static_cast<u32>(data.size()));
+  ASSERT_NE(stream, nullptr);
+
+  std::vector<u8> decompressed(data.size() + 1);
+  ASSERT_FALSE(stream->Read2(decompressed.data(), static_cast<u32>(decompressed.size())));
+  ASSERT_TRUE(stream->InErrorState());
+}
+
+TEST(ByteStream, ZlibTruncatedInputFails)
+{
+  const std::vector<u8> data = MakeData(64 * 1024);
+  const std::vector<u8> compressed = Compress(data, 6);
+  std::vector<u8> decompressed;
+
+  // Sized as the whole stream, but the base stream runs out.
+  const std::vector<u8> truncated(compressed.begin(), compressed.begin() + compressed.size() / 2);
+  ASSERT_FALSE(
+    Decompress(truncated, static_cast<u32>(compressed.size()), static_cast<u32>(data.size()), &decompressed));
+
+  // The compressed size stops short of the end, even though the base stream has it all.
+  ASSERT_FALSE(
+    Decompress(compressed, static_cast<u32>(compressed.size() - 1), static_cast<u32>(data.size()), &decompressed));
+}
+
+TEST(ByteStream, ZlibCorruptInputFails)
+{
+  const std::vector<u8> data = MakeData(64 * 1024);
+  const std::vector<u8> compressed = Compress(data, 6);
+  std::vector<u8> decompressed;
+
+  // Header, deflate data, and the adler32 checksum at the end.
+  for (const size_t offset : {size_t(0), compressed.size() / 2, compressed.size() - 1})
+  {
+    std::vector<u8> corrupted = compressed;
+    corrupted[offset] ^= 0x55;
+    ASSERT_FALSE(
+      Decompress(corrupted, static_cast<u32>(corrupted.size()), static_cast<u32>(data.size()), &decompressed));
+  }
+}
+
+TEST(ByteStream, ZlibMismatchedSizeFails)
+{
+  const std::vector<u8> data = MakeData(64 * 1024);
+  const std::vector<u8> compressed = Compress(data, 6);
+  std::vector<u8> decompressed;
+
+  ASSERT_FALSE(
+    Decompress(compressed, static_cast<u32>(compressed.size()), static_cast<u32>(data.size() + 1), &decompressed));
+  ASSERT_FALSE(
+    Decompress(compressed, static_cast<u32>(compressed.size()), static_cast<u32>(data.size() - 1), &decompressed));
+}
@@ -10,6 +10,19 @@ TEST(Event, InitialStateUnsignaled)
   ASSERT_FALSE(e.TryWait(1));
 }
 
+TEST(Event, TryWaitTimesOutAfterTimeout)
+{
+  Common::Event e;
+
+  // The timeout has to be added to the current time without overflowing the nanoseconds.
+  for (u32 i = 0; i < 5; i++)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(e.TryWait(50));
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+  }
+}
+
 TEST(Event, SignalOnSameThread)
 {
   Common::Event e;
@@ -0,0 +1,105 @@
+#include "common/time_stretcher.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+static constexpr u32 SAMPLE_RATE = 44100;
+static constexpr u32 CHANNELS = 2;
+static constexpr u32 CHUNK_FRAMES = 735;
+static constexpr u32 INPUT_FRAMES = SAMPLE_RATE * 5;
+static constexpr double FREQUENCY = 440.0;
+static constexpr double AMPLITUDE = 16384.0;
+static constexpr double PI = 3.14159265358979323846;
+
+struct StretchResult
+{
+  u32 input_frames;
+  u32 output_frames;
+  s32 peak;
+  double rms;
+  double frequency;
+};
+
+// Feeds a stereo sine through the stretcher one emulated frame's worth at a time, the same as AudioStream does.
+static StretchResult StretchSine(float tempo)
+{
+  Common::TimeStretcher stretcher;
+  stretcher.Configure(SAMPLE_RATE, CHANNELS);
+  stretcher.SetTempo(tempo);
+
+  std::vector<s16> chunk(CHUNK_FRAMES * CHANNELS);
+  std::vector<s16> output;
+  for (u32 frame = 0; frame < INPUT_FRAMES; frame += CHUNK_FRAMES)
+  {
+    for (u32 i = 0; i < CHUNK_FRAMES; i++)
+    {
+      const double t = static_cast<double>(frame + i) / static_cast<double>(SAMPLE_RATE);
+      const s16 value = static_cast<s16>(std::lround(AMPLITUDE * std::sin(2.0 * PI * FREQUENCY * t)));
+      chunk[i * CHANNELS + 0] = value;
+      chunk[i * CHANNELS + 1] = value;
+    }
+    stretcher.PutFrames(chunk.data(), CHUNK_FRAMES);
+
+    const size_t pos = output.size();
+    output.resize(pos + stretcher.GetAvailableFrames() * CHANNELS);
+    const u32 received = stretcher.ReceiveFrames(output.data() + pos, stretcher.GetAvailableFrames());
+    output.resize(pos + received * CHANNELS);
+  }
+
+  StretchResult res = {};
+  res.input_frames = (INPUT_FRAMES / CHUNK_FRAMES) * CHUNK_FRAMES;
+  res.output_frames = static_cast<u32>(output.size() / CHANNELS);
+
+  double sum_squares = 0.0;
+  u32 rising_crossings = 0;
+  for (u32 i = 0; i < res.output_frames; i++)
+  {
+    const s16 left = output[i * CHANNELS + 0];
+    EXPECT_EQ(left, output[i * CHANNELS + 1]);
+    res.peak = std::max<s32>(res.peak, std::abs(static_cast<s32>(left)));
+    sum_squares += static_cast<double>(left) * static_cast<double>(left);
+    if (i > 0 && output[(i - 1) * CHANNELS] < 0 && left >= 0)
+      rising_crossings++;
+  }
+
+  if (res.output_frames > 0)
+  {
+    res.rms = std::sqrt(sum_squares / res.output_frames);
+    res.frequency = static_cast<double>(rising_crossings) * SAMPLE_RATE / res.output_frames;
+  }
+
+  return res;
+}
+
+static void CheckStretch(float tempo)
+{
+  const StretchResult res = StretchSine(tempo);
+
+  // Some of the input is held back for the next sequence and seek window, so allow a little slack.
+  const double ratio = static_cast<double>(res.input_frames) / static_cast<double>(res.output_frames);
+  EXPECT_NEAR(ratio, tempo, tempo * 0.02);
+
+  // Splices line up with the waveform, so the cross-fades shouldn't change the level or the pitch.
+  EXPECT_LE(res.peak, static_cast<s32>(AMPLITUDE * 1.05));
+  EXPECT_NEAR(res.rms, AMPLITUDE / std::sqrt(2.0), AMPLITUDE * 0.05);
+  EXPECT_NEAR(res.frequency, FREQUENCY, FREQUENCY * 0.01);
+}
+} // namespace
+
+TEST(TimeStretcher, HalfTempo)
+{
+  CheckStretch(0.5f);
+}
+
+TEST(TimeStretcher, UnchangedTempo)
+{
+  CheckStretch(1.0f);
+}
+
+TEST(TimeStretcher, DoubleTempo)
+{
+  CheckStretch(2.0f);
+}
@@ -5,7 +5,17 @@
 #include <cstring>
 Log_SetChannel(AudioStream);
 
-AudioStream::AudioStream() = default;
+// How far the stretch tempo can be pushed away from the base tempo when the buffer is completely full or empty.
+static constexpr float STRETCH_CORRECTION_RANGE = 0.25f;
+
+// Per-write smoothing of the tempo changes, so corrections don't become audible wobble.
+static constexpr float STRETCH_TEMPO_SMOOTHING = 0.05f;
+
+// How long a synchronising write waits for the device to consume frames before the oldest ones are dropped instead.
+static constexpr u32 SYNC_WAIT_TIMEOUT_MS = 100;
+static constexpr u32 SYNC_MAX_WAITS_WITHOUT_PROGRESS = 5;
+
+AudioStream::AudioStream() : m_buffer(std::make_unique<SampleType[]>(MaxSamples)) {}
 
 AudioStream::~AudioStream() = default;
 
@@ -23,6 +33,9 @@ bool AudioStream::Reconfigure(u32 output_sample_rate /*= DefaultOutputSampleRate
   if (!SetBufferSize(buffer_size))
     return false;
 
+  if (m_stretcher)
+    m_stretcher->Configure(m_output_sample_rate, m_channels);
+
   if (!OpenDevice())
   {
     EmptyBuffers();
@@ -37,8 +50,7 @@ bool AudioStream::Reconfigure(u32 output_sample_rate /*= DefaultOutputSampleRate
 
 void AudioStream::SetOutputVolume(u32 volume)
 {
-  std::unique_lock<std::mutex> lock(m_buffer_mutex);
-  m_output_volume = volume;
+  m_output_volume.store(volume);
 }
 
 void AudioStream::PauseOutput(bool paused)
@@ -67,82 +79,189 @@ void AudioStream::Shutdown()
   m_output_paused = true;
 }
 
+void AudioStream::SetTimeStretch(bool enable, float base_tempo /* = 1.0f */)
+{
+  if (!enable)
+  {
+    m_stretcher.reset();
+    return;
+  }
+
+  if (!m_stretcher)
+  {
+    m_stretcher = std::make_unique<Common::TimeStretcher>();
+    if (m_channels > 0)
+      m_stretcher->Configure(m_output_sample_rate, m_channels);
+  }
+
+  m_stretch_base_tempo = base_tempo;
+  m_stretch_tempo = base_tempo;
+  m_stretcher->SetTempo(base_tempo);
+}
+
 void AudioStream::BeginWrite(SampleType** buffer_ptr, u32* num_frames)
 {
-  m_buffer_mutex.lock();
+  if (m_stretcher)
+  {
+    *buffer_ptr = m_stretch_buffer.data();
+    *num_frames = std::min(*num_frames, static_cast<u32>(m_stretch_buffer.size()) / m_channels);
+    return;
+  }
 
-  EnsureBuffer(*num_frames * m_channels);
+  BeginRingWrite(buffer_ptr, num_frames);
+}
+
+void AudioStream::BeginRingWrite(SampleType** buffer_ptr, u32* num_frames)
+{
+  const u32 requested_samples = std::min(*num_frames * m_channels, m_max_samples);
+  if (!EnsureBuffer(requested_samples))
+  {
+    // No room and we're not allowed to wait. Drop the oldest frames, so the consumer stays as close as it can to what
+    // is being written, rather than playing out stale frames while the new ones are lost.
+    DropOldestSamples(requested_samples);
+  }
 
-  *buffer_ptr = m_buffer.GetWritePointer();
-  *num_frames = m_buffer.GetContiguousSpace() / m_channels;
+  const u32 write_index = m_write_position.load(std::memory_order_relaxed) & BUFFER_MASK;
+  const u32 contiguous_space = std::min(GetBufferSpace(), MaxSamples - write_index);
+  *buffer_ptr = &m_buffer[write_index];
+  *num_frames = contiguous_space / m_channels;
 }
 
 void AudioStream::WriteFrames(const SampleType* frames, u32 num_frames)
 {
-  const u32 num_samples = num_frames * m_channels;
+  u32 remaining_frames = num_frames;
+  while (remaining_frames > 0)
   {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex);
-    EnsureBuffer(num_samples);
-    m_buffer.PushRange(frames, num_samples);
-  }
+    SampleType* buffer_ptr;
+    u32 frames_in_this_batch = remaining_frames;
+    BeginWrite(&buffer_ptr, &frames_in_this_batch);
 
-  FramesAvailable();
+    // BeginWrite() returns all of the contiguous space, which can be more than we have left.
+    frames_in_this_batch = std::min(frames_in_this_batch, remaining_frames);
+    std::memcpy(buffer_ptr, frames, sizeof(SampleType) * frames_in_this_batch * m_channels);
+    EndWrite(frames_in_this_batch);
+
+    frames += frames_in_this_batch * m_channels;
+    remaining_frames -= frames_in_this_batch;
+  }
 }
 
 void AudioStream::EndWrite(u32 num_frames)
 {
-  m_buffer.AdvanceTail(num_frames * m_channels);
-  m_buffer_mutex.unlock();
+  if (m_stretcher)
+  {
+    m_stretcher->PutFrames(m_stretch_buffer.data(), num_frames);
+    UpdateStretchTempo();
+    WriteStretchedFrames();
+    return;
+  }
+
+  EndRingWrite(num_frames);
+}
+
+void AudioStream::EndRingWrite(u32 num_frames)
+{
+  // release so the consumer sees the sample data before the new position
+  m_write_position.fetch_add(num_frames * m_channels, std::memory_order_release);
   FramesAvailable();
 }
 
+void AudioStream::UpdateStretchTempo()
+{
+  // Steer around the base tempo so the buffer sits at the configured size, i.e. half full. This soaks up drift
+  // between the emulated and host clocks without having to drop frames or stretch out underruns.
+  const float fill = static_cast<float>(GetBufferedSamples()) / static_cast<float>(m_max_samples);
+  const float target_tempo = m_stretch_base_tempo * (1.0f + (fill - 0.5f) * 2.0f * STRETCH_CORRECTION_RANGE);
+  m_stretch_tempo += (target_tempo - m_stretch_tempo) * STRETCH_TEMPO_SMOOTHING;
+  m_stretcher->SetTempo(m_stretch_tempo);
+}
+
+void AudioStream::WriteStretchedFrames()
+{
+  u32 remaining_frames = m_stretcher->GetAvailableFrames();
+  while (remaining_frames > 0)
+  {
+    SampleType* buffer_ptr;
+    u32 frames_in_this_batch = remaining_frames;
+    BeginRingWrite(&buffer_ptr, &frames_in_this_batch);
+    frames_in_this_batch = m_stretcher->ReceiveFrames(buffer_ptr, frames_in_this_batch);
+    EndRingWrite(frames_in_this_batch);
+    remaining_frames -= frames_in_this_batch;
+  }
+}
+
 float AudioStream::GetMaxLatency(u32 sample_rate, u32 buffer_size)
 {
   return (static_cast<float>(buffer_size) / static_cast<float>(sample_rate));
 }
 
+float AudioStream::GetMaxLatency() const
+{
+  return (m_output_sample_rate > 0) ? GetMaxLatency(m_output_sample_rate, m_max_samples / m_channels) : 0.0f;
+}
+
+float AudioStream::GetCurrentLatency() const
+{
+  return (m_output_sample_rate > 0) ? GetMaxLatency(m_output_sample_rate, GetSamplesAvailable()) : 0.0f;
+}
+
+float AudioStream::GetAndResetPeakLatency()
+{
+  const u32 peak_samples = m_peak_buffered_samples.exchange(0, std::memory_order_relaxed);
+  return (m_output_sample_rate > 0) ? GetMaxLatency(m_output_sample_rate, peak_samples / m_channels) : 0.0f;
+}
+
 bool AudioStream::SetBufferSize(u32 buffer_size)
 {
   const u32 buffer_size_in_samples = buffer_size * m_channels;
   const u32 max_samples = buffer_size_in_samples * 2u;
-  if (max_samples > m_buffer.GetCapacity())
+  if (max_samples > MaxSamples)
     return false;
 
   m_buffer_size = buffer_size;
   m_max_samples = max_samples;
+  m_stretch_buffer.resize(buffer_size_in_samples);
   return true;
 }
 
 u32 AudioStream::GetSamplesAvailable() const
 {
-  // TODO: Use atomic loads
-  u32 available_samples;
-  {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex);
-    available_samples = m_buffer.GetSize();
-  }
-
-  return available_samples / m_channels;
+  return GetBufferedSamples() / m_channels;
 }
 
-u32 AudioStream::GetSamplesAvailableLocked() const
+void AudioStream::AdvanceReadPosition(u32 read_position, u32 num_samples)
 {
-  return m_buffer.GetSize() / m_channels;
+  // If the producer emptied the buffer while we were copying, its position wins.
+  m_read_position.compare_exchange_strong(read_position, read_position + num_samples, std::memory_order_release,
+                                          std::memory_order_relaxed);
+
+  // Only pay for the wakeup when the producer is actually blocked on a full buffer. The fence pairs with the one in
+  // EnsureBuffer(): either we see the waiting flag, or the producer sees the new read position.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_producer_waiting.load(std::memory_order_relaxed) && m_producer_waiting.exchange(false))
+    m_buffer_drained_event.Signal();
 }
 
 void AudioStream::ReadFrames(SampleType* samples, u32 num_frames, bool apply_volume)
 {
   const u32 total_samples = num_frames * m_channels;
-  u32 samples_copied = 0;
-  {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex);
-    samples_copied = std::min(m_buffer.GetSize(), total_samples);
-    if (samples_copied > 0)
-      m_buffer.PopRange(samples, samples_copied);
+  const u32 read_position = m_read_position.load(std::memory_order_acquire);
+  const u32 buffered_samples = m_write_position.load(std::memory_order_acquire) - read_position;
+  const u32 samples_copied = std::min(buffered_samples, total_samples);
+  if (buffered_samples > m_peak_buffered_samples.load(std::memory_order_relaxed))
+    m_peak_buffered_samples.store(buffered_samples, std::memory_order_relaxed);
 
-    m_buffer_draining_cv.notify_one();
+  if (samples_copied > 0)
+  {
+    const u32 read_index = read_position & BUFFER_MASK;
+    const u32 size_before_end = std::min(samples_copied, MaxSamples - read_index);
+    std::memcpy(samples, &m_buffer[read_index], sizeof(SampleType) * size_before_end);
+    if (size_before_end < samples_copied)
+      std::memcpy(samples + size_before_end, &m_buffer[0], sizeof(SampleType) * (samples_copied - size_before_end));
   }
 
+  AdvanceReadPosition(read_position, samples_copied);
+
   if (samples_copied < total_samples)
   {
     if (samples_copied > 0)
@@ -170,55 +289,121 @@ void AudioStream::ReadFrames(SampleType* samples, u32 num_frames, bool apply_vol
       }
 
       Log_DevPrintf("Audio buffer underflow, resampled %u frames to %u", samples_copied / m_channels, num_frames);
-      m_underflow_flag.store(true);
     }
     else
     {
       // read nothing, so zero-fill
       std::memset(samples, 0, sizeof(SampleType) * total_samples);
       Log_DevPrintf("Audio buffer underflow with no samples, added %u frames silence", num_frames);
-      m_underflow_flag.store(true);
     }
+
+    m_underflow_flag.store(true);
+    m_underflow_count.fetch_add(1, std::memory_order_relaxed);
   }
 
-  if (apply_volume && m_output_volume != FullVolume)
+  const u32 output_volume = m_output_volume.load(std::memory_order_relaxed);
+  if (apply_volume && output_volume != FullVolume)
   {
     SampleType* current_ptr = samples;
     const SampleType* end_ptr = samples + (num_frames * m_channels);
     while (current_ptr != end_ptr)
     {
-      *current_ptr = ApplyVolume(*current_ptr, m_output_volume);
+      *current_ptr = ApplyVolume(*current_ptr, output_volume);
       current_ptr++;
     }
   }
 }
 
-void AudioStream::EnsureBuffer(u32 size)
+bool AudioStream::EnsureBuffer(u32 size)
 {
   if (GetBufferSpace() >= size)
-    return;
+    return true;
 
-  if (m_sync)
+  if (!m_sync)
+    return false;
+
+  // Slow path, the buffer is full. Flag that we're waiting, then re-check so a read which happened in between
+  // doesn't leave us sleeping forever. The fence orders the flag store before the re-check, see AdvanceReadPosition().
+  u32 waits_without_progress = 0;
+  while (GetBufferSpace() < size)
   {
-    std::unique_lock<std::mutex> lock(m_buffer_mutex, std::adopt_lock);
-    m_buffer_draining_cv.wait(lock, [this, size]() { return GetBufferSpace() >= size; });
-    lock.release();
+    // Nothing will drain the buffer while the device is paused or closed.
+    if (m_output_paused || !IsDeviceOpen())
+      return false;
+
+    m_producer_waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (GetBufferSpace() >= size)
+    {
+      m_producer_waiting.store(false, std::memory_order_relaxed);
+      break;
+    }
+
+    // Give up if the device stops pulling without telling us, the caller then drops the oldest frames.
+    const u32 read_position = m_read_position.load(std::memory_order_relaxed);
+    m_buffer_drained_event.TryWait(SYNC_WAIT_TIMEOUT_MS);
+    if (m_read_position.load(std::memory_order_relaxed) != read_position)
+    {
+      waits_without_progress = 0;
+    }
+    else if (++waits_without_progress == SYNC_MAX_WAITS_WITHOUT_PROGRESS)
+    {
+      m_producer_waiting.store(false, std::memory_order_relaxed);
+      Log_WarningPrintf("Audio device stopped consuming frames, dropping oldest output");
+      return false;
+    }
   }
-  else
+
+  return true;
+}
+
+void AudioStream::DropOldestSamples(u32 size)
+{
+  // Producer side. Moving the read position is what tells the consumer to skip the frames; if it was part way through
+  // a read, its AdvanceReadPosition() then fails and it continues from here. That read can return a mix of the old
+  // and new frames, which is no worse than the discontinuity the drop causes anyway.
+  u32 read_position = m_read_position.load(std::memory_order_acquire);
+  const u32 write_position = m_write_position.load(std::memory_order_relaxed);
+  for (;;)
   {
-    m_buffer.Remove(size);
+    const u32 buffered_samples = write_position - read_position;
+    const u32 space = m_max_samples - buffered_samples;
+    if (space >= size)
+      return;
+
+    const u32 drop_samples = std::min(size - space, buffered_samples);
+    if (m_read_position.compare_exchange_weak(read_position, read_position + drop_samples, std::memory_order_acq_rel,
+                                              std::memory_order_acquire))
+    {
+      m_dropped_frame_count.fetch_add(drop_samples / m_channels, std::memory_order_relaxed);
+      return;
+    }
   }
 }
 
-void AudioStream::DropFrames(u32 count)
+void AudioStream::DropFrames(u32 num_frames)
 {
-  std::unique_lock<std::mutex> lock(m_buffer_mutex);
-  m_buffer.Remove(count);
+  const u32 read_position = m_read_position.load(std::memory_order_acquire);
+  const u32 buffered_samples = m_write_position.load(std::memory_order_acquire) - read_position;
+  AdvanceReadPosition(read_position, std::min(num_frames * m_channels, buffered_samples));
 }
 
 void AudioStream::EmptyBuffers()
 {
-  std::unique_lock<std::mutex> lock(m_buffer_mutex);
-  m_buffer.Clear();
+  // Called from the producer side, so the write position is stable.
+  const u32 write_position = m_write_position.load(std::memory_order_relaxed);
+  u32 read_position = m_read_position.load(std::memory_order_acquire);
+  while (!m_read_position.compare_exchange_weak(read_position, write_position, std::memory_order_acq_rel))
+    ;
+
+  if (m_stretcher)
+    m_stretcher->Clear();
+
   m_underflow_flag.store(false);
+  m_underflow_count.store(0, std::memory_order_relaxed);
+  m_dropped_frame_count.store(0, std::memory_order_relaxed);
+  m_peak_buffered_samples.store(0, std::memory_order_relaxed);
+
+  if (m_producer_waiting.exchange(false))
+    m_buffer_drained_event.Signal();
 }
@@ -1,13 +1,13 @@
 #pragma once
-#include "fifo_queue.h"
+#include "event.h"
+#include "time_stretcher.h"
 #include "types.h"
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 // Uses signed 16-bits samples.
+// The buffer is a single-producer (emulation thread) single-consumer (audio callback) ring, neither side takes a lock.
 
 class AudioStream
 {
@@ -22,6 +22,8 @@ public:
     FullVolume = 100
   };
 
+  static_assert((MaxSamples & (MaxSamples - 1)) == 0, "MaxSamples is a power of two");
+
   AudioStream();
   virtual ~AudioStream();
 
@@ -30,11 +32,16 @@ public:
   u32 GetBufferSize() const { return m_buffer_size; }
   s32 GetOutputVolume() const { return m_output_volume; }
   bool IsSyncing() const { return m_sync; }
+  bool IsTimeStretching() const { return static_cast<bool>(m_stretcher); }
 
   bool Reconfigure(u32 output_sample_rate = DefaultOutputSampleRate, u32 channels = 1,
                    u32 buffer_size = DefaultBufferSize);
   void SetSync(bool enable) { m_sync = enable; }
 
+  /// Passes written frames through a time-stretcher running at base_tempo, which is adjusted on the fly to hold the
+  /// buffer at its target fill. Use the emulation speed as the base tempo to keep the pitch when not running at 100%.
+  void SetTimeStretch(bool enable, float base_tempo = 1.0f);
+
   virtual void SetOutputVolume(u32 volume);
 
   void PauseOutput(bool paused);
@@ -52,11 +59,26 @@ public:
     return m_underflow_flag.compare_exchange_strong(expected, false);
   }
 
+  /// Returns the number of times the consumer has run dry since the buffers were last emptied.
+  u32 GetUnderflowCount() const { return m_underflow_count.load(std::memory_order_relaxed); }
+
+  /// Returns the number of queued frames thrown away to make room for newer ones since the buffers were last emptied.
+  u32 GetDroppedFrameCount() const { return m_dropped_frame_count.load(std::memory_order_relaxed); }
+
   static std::unique_ptr<AudioStream> CreateNullAudioStream();
 
   // Latency computation - returns values in seconds
   static float GetMaxLatency(u32 sample_rate, u32 buffer_size);
 
+  /// Latency of a completely full ring at the current configuration, which holds twice the buffer size.
+  float GetMaxLatency() const;
+
+  /// Latency of the frames currently queued.
+  float GetCurrentLatency() const;
+
+  /// Highest queued latency observed by the consumer since the last call, resets the peak.
+  float GetAndResetPeakLatency();
+
 protected:
   virtual bool OpenDevice() = 0;
   virtual void PauseDevice(bool paused) = 0;
@@ -72,28 +94,61 @@ protected:
   bool IsDeviceOpen() const { return (m_output_sample_rate > 0); }
 
   u32 GetSamplesAvailable() const;
-  u32 GetSamplesAvailableLocked() const;
   void ReadFrames(SampleType* samples, u32 num_frames, bool apply_volume);
-  void DropFrames(u32 count);
+  void DropFrames(u32 num_frames);
 
   u32 m_output_sample_rate = 0;
   u32 m_channels = 0;
   u32 m_buffer_size = 0;
 
   // volume, 0-100
-  u32 m_output_volume = FullVolume;
+  std::atomic<u32> m_output_volume{FullVolume};
 
 private:
-  ALWAYS_INLINE u32 GetBufferSpace() const { return (m_max_samples - m_buffer.GetSize()); }
-  void EnsureBuffer(u32 size);
+  static constexpr u32 CACHE_LINE_SIZE = 64;
+  static constexpr u32 BUFFER_MASK = MaxSamples - 1;
 
-  HeapFIFOQueue<SampleType, MaxSamples> m_buffer;
-  mutable std::mutex m_buffer_mutex;
-  std::condition_variable m_buffer_draining_cv;
+  ALWAYS_INLINE u32 GetBufferedSamples() const
+  {
+    // read position first, it can never overtake a later load of the write position
+    const u32 read_position = m_read_position.load(std::memory_order_acquire);
+    return m_write_position.load(std::memory_order_acquire) - read_position;
+  }
+  ALWAYS_INLINE u32 GetBufferSpace() const { return (m_max_samples - GetBufferedSamples()); }
+  bool EnsureBuffer(u32 size);
+  void DropOldestSamples(u32 size);
+  void AdvanceReadPosition(u32 read_position, u32 num_samples);
+
+  void BeginRingWrite(SampleType** buffer_ptr, u32* num_frames);
+  void EndRingWrite(u32 num_frames);
+
+  void UpdateStretchTempo();
+  void WriteStretchedFrames();
+
+  std::unique_ptr<SampleType[]> m_buffer;
   std::vector<SampleType> m_resample_buffer;
-  std::atomic_bool m_underflow_flag{false};
   u32 m_max_samples = 0;
 
+  // Positions are free-running sample counters, masked when indexing. Kept on separate cache lines so the producer and
+  // consumer don't bounce each other's line on every update.
+  alignas(CACHE_LINE_SIZE) std::atomic<u32> m_read_position{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<u32> m_write_position{0};
+
+  // Only touched when the buffer is full in sync mode.
+  alignas(CACHE_LINE_SIZE) std::atomic_bool m_producer_waiting{false};
+  Common::Event m_buffer_drained_event{true};
+
+  std::atomic_bool m_underflow_flag{false};
+  std::atomic<u32> m_underflow_count{0};
+  std::atomic<u32> m_dropped_frame_count{0};
+  std::atomic<u32> m_peak_buffered_samples{0};
+
+  // Only used from the producer side.
+  std::unique_ptr<Common::TimeStretcher> m_stretcher;
+  std::vector<SampleType> m_stretch_buffer;
+  float m_stretch_base_tempo = 1.0f;
+  float m_stretch_tempo = 1.0f;
+
   bool m_output_paused = true;
   bool m_sync = true;
 };
\ No newline at end of file
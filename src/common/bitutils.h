@@ -56,3 +56,22 @@ ALWAYS_INLINE unsigned CountTrailingZeros(T value)
     return static_cast<unsigned>(__builtin_ctz(ZeroExtend32(value)));
 #endif
 }
+
+/// Returns the number of set bits.
+template<typename T>
+ALWAYS_INLINE unsigned CountSetBits(T value)
+{
+#ifdef _MSC_VER
+  // __popcnt() needs a CPU check, so count in parallel instead.
+  u64 bits = ZeroExtend64(value);
+  bits = bits - ((bits >> 1) & UINT64_C(0x5555555555555555));
+  bits = (bits & UINT64_C(0x3333333333333333)) + ((bits >> 2) & UINT64_C(0x3333333333333333));
+  bits = (bits + (bits >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+  return static_cast<unsigned>((bits * UINT64_C(0x0101010101010101)) >> 56);
+#else
+  if constexpr (sizeof(value) >= sizeof(u64))
+    return static_cast<unsigned>(__builtin_popcountll(ZeroExtend64(value)));
+  else
+    return static_cast<unsigned>(__builtin_popcount(ZeroExtend32(value)));
+#endif
+}
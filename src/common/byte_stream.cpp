@@ -3,6 +3,7 @@
 #include "file_system.h"
 #include "log.h"
 #include "string_util.h"
+#include "zlib.h"
 #include <algorithm>
 #include <cerrno>
 #include <cstdio>
@@ -17,6 +18,7 @@
 #else
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 #endif
 
 Log_SetChannel(ByteStream);
@@ -255,9 +257,10 @@ protected:
 class AtomicUpdatedFileByteStream : public FileByteStream
 {
 public:
-  AtomicUpdatedFileByteStream(FILE* pFile, const char* originalFileName, const char* temporaryFileName)
-    : FileByteStream(pFile), m_committed(false), m_discarded(false), m_originalFileName(originalFileName),
-      m_temporaryFileName(temporaryFileName)
+  AtomicUpdatedFileByteStream(FILE* pFile, const char* originalFileName, const char* temporaryFileName,
+                              bool syncOnCommit)
+    : FileByteStream(pFile), m_committed(false), m_discarded(false), m_syncOnCommit(syncOnCommit),
+      m_originalFileName(originalFileName), m_temporaryFileName(temporaryFileName)
   {
   }
 
@@ -308,6 +311,16 @@ public:
 
     fflush(m_pFile);
 
+    // make sure the data is on disk before the rename, otherwise a crash can leave an empty file in place of the old
+    if (m_syncOnCommit)
+    {
+#ifdef WIN32
+      _commit(_fileno(m_pFile));
+#else
+      fsync(fileno(m_pFile));
+#endif
+    }
+
 #ifdef WIN32
     // move the atomic file name to the original file name
     if (!MoveFileExW(StringUtil::UTF8StringToWideString(m_temporaryFileName).c_str(),
@@ -348,6 +361,7 @@ public:
 private:
   bool m_committed;
   bool m_discarded;
+  bool m_syncOnCommit;
   std::string m_originalFileName;
   std::string m_temporaryFileName;
 };
@@ -1031,7 +1045,8 @@ std::unique_ptr<ByteStream> ByteStream_OpenFileStream(const char* fileName, u32
 
     // create the stream pointer
     std::unique_ptr<AtomicUpdatedFileByteStream> pStream =
-      std::make_unique<AtomicUpdatedFileByteStream>(pTemporaryFile, fileName, temporaryFileName);
+      std::make_unique<AtomicUpdatedFileByteStream>(pTemporaryFile, fileName, temporaryFileName,
+                                                    (openMode & BYTESTREAM_OPEN_SYNC_ON_COMMIT) != 0);
 
     // do we need to copy the existing file into this one?
     if (!(openMode & BYTESTREAM_OPEN_TRUNCATE))
@@ -1212,7 +1227,8 @@ std::unique_ptr<ByteStream> ByteStream_OpenFileStream(const char* fileName, u32
 
     // create the stream pointer
     std::unique_ptr<AtomicUpdatedFileByteStream> pStream =
-      std::make_unique<AtomicUpdatedFileByteStream>(pTemporaryFile, fileName, temporaryFileName);
+      std::make_unique<AtomicUpdatedFileByteStream>(pTemporaryFile, fileName, temporaryFileName,
+                                                    (openMode & BYTESTREAM_OPEN_SYNC_ON_COMMIT) != 0);
 
     // do we need to copy the existing file into this one?
     if (!(openMode & BYTESTREAM_OPEN_TRUNCATE))
@@ -1260,6 +1276,278 @@ std::unique_ptr<ByteStream> ByteStream_OpenFileStream(const char* fileName, u32
 
 #endif
 
+// Write-only stream which deflates everything written to it into the base stream. The base stream must outlive it.
+class ZlibCompressByteStream final : public ByteStream
+{
+public:
+  ZlibCompressByteStream(ByteStream* pBaseStream, int CompressionLevel) : m_pBaseStream(pBaseStream)
+  {
+    std::memset(&m_zstream, 0, sizeof(m_zstream));
+    m_initialized = (deflateInit(&m_zstream, CompressionLevel) == Z_OK);
+    if (!m_initialized)
+      m_errorState = true;
+  }
+
+  virtual ~ZlibCompressByteStream()
+  {
+    if (m_initialized)
+      deflateEnd(&m_zstream);
+  }
+
+  virtual bool ReadByte(u8* pDestByte) override { return false; }
+  virtual u32 Read(void* pDestination, u32 ByteCount) override { return 0; }
+  virtual bool Read2(void* pDestination, u32 ByteCount, u32* pNumberOfBytesRead /* = nullptr */) override
+  {
+    if (pNumberOfBytesRead)
+      *pNumberOfBytesRead = 0;
+
+    return false;
+  }
+
+  virtual bool WriteByte(u8 SourceByte) override { return Write2(&SourceByte, sizeof(SourceByte), nullptr); }
+
+  virtual u32 Write(const void* pSource, u32 ByteCount) override
+  {
+    return (Deflate(pSource, ByteCount, Z_NO_FLUSH) ? ByteCount : 0);
+  }
+
+  virtual bool Write2(const void* pSource, u32 ByteCount, u32* pNumberOfBytesWritten /* = nullptr */) override
+  {
+    const bool result = Deflate(pSource, ByteCount, Z_NO_FLUSH);
+    if (pNumberOfBytesWritten)
+      *pNumberOfBytesWritten = result ? ByteCount : 0;
+
+    return result;
+  }
+
+  virtual bool SeekAbsolute(u64 Offset) override { return (Offset == m_zstream.total_in); }
+  virtual bool SeekRelative(s64 Offset) override { return (Offset == 0); }
+  virtual bool SeekToEnd() override { return true; }
+  virtual u64 GetPosition() const override { return m_zstream.total_in; }
+  virtual u64 GetSize() const override { return m_zstream.total_in; }
+
+  virtual bool Flush() override { return Deflate(nullptr, 0, Z_SYNC_FLUSH); }
+
+  // finishes the deflate stream, no more data can be written afterwards
+  virtual bool Commit() override
+  {
+    if (m_finished)
+      return !m_errorState;
+
+    m_finished = Deflate(nullptr, 0, Z_FINISH);
+    return m_finished;
+  }
+
+  virtual bool Discard() override
+  {
+    m_errorState = true;
+    return true;
+  }
+
+private:
+  bool Deflate(const void* pSource, u32 ByteCount, int FlushMode)
+  {
+    if (m_errorState || m_finished)
+      return false;
+
+    m_zstream.next_in = static_cast<Bytef*>(const_cast<void*>(pSource));
+    m_zstream.avail_in = ByteCount;
+
+    // keep going until the input is consumed, or for flushes, until deflate has nothing left to give us
+    for (;;)
+    {
+      m_zstream.next_out = m_buffer;
+      m_zstream.avail_out = sizeof(m_buffer);
+
+      const int err = deflate(&m_zstream, FlushMode);
+      if (err == Z_STREAM_ERROR)
+      {
+        Log_ErrorPrintf("deflate() failed: %d", err);
+        m_errorState = true;
+        return false;
+      }
+
+      const u32 out_size = sizeof(m_buffer) - m_zstream.avail_out;
+      if (out_size > 0 && !m_pBaseStream->Write2(m_buffer, out_size))
+      {
+        m_errorState = true;
+        return false;
+      }
+
+      if (FlushMode == Z_FINISH ? (err == Z_STREAM_END) : (m_zstream.avail_out != 0 && m_zstream.avail_in == 0))
+        return true;
+    }
+  }
+
+  ByteStream* m_pBaseStream;
+  z_stream m_zstream;
+  bool m_initialized = false;
+  bool m_finished = false;
+
+  u8 m_buffer[64 * 1024];
+};
+
+// Read-only stream which inflates a fixed number of compressed bytes from the base stream.
+class ZlibDecompressByteStream final : public ByteStream
+{
+public:
+  ZlibDecompressByteStream(ByteStream* pBaseStream, u32 CompressedSize, u32 UncompressedSize)
+    : m_pBaseStream(pBaseStream), m_compressedRemaining(CompressedSize), m_uncompressedSize(UncompressedSize)
+  {
+    std::memset(&m_zstream, 0, sizeof(m_zstream));
+    m_initialized = (inflateInit(&m_zstream) == Z_OK);
+    if (!m_initialized)
+      m_errorState = true;
+  }
+
+  virtual ~ZlibDecompressByteStream()
+  {
+    if (m_initialized)
+      inflateEnd(&m_zstream);
+  }
+
+  virtual bool ReadByte(u8* pDestByte) override { return Read2(pDestByte, sizeof(u8), nullptr); }
+
+  virtual u32 Read(void* pDestination, u32 ByteCount) override
+  {
+    if (m_errorState || m_finished)
+      return 0;
+
+    // Never inflate past the size in the header, a corrupted stream could otherwise produce anything.
+    if (ByteCount > (m_uncompressedSize - m_zstream.total_out))
+    {
+      Log_ErrorPrintf("Read of %u bytes past the end of %u bytes of compressed data", ByteCount, m_uncompressedSize);
+      m_errorState = true;
+      return 0;
+    }
+
+    m_zstream.next_out = static_cast<Bytef*>(pDestination);
+    m_zstream.avail_out = ByteCount;
+
+    while (m_zstream.avail_out > 0)
+    {
+      if (m_zstream.avail_in == 0 && !FillInputBuffer())
+      {
+        m_errorState = true;
+        break;
+      }
+
+      const int err = inflate(&m_zstream, Z_NO_FLUSH);
+      if (err == Z_STREAM_END)
+      {
+        if (m_zstream.total_out != m_uncompressedSize)
+        {
+          Log_ErrorPrintf("Compressed data ended after %u of %u bytes", static_cast<u32>(m_zstream.total_out),
+                          m_uncompressedSize);
+          m_errorState = true;
+          break;
+        }
+
+        m_finished = true;
+        break;
+      }
+      else if (err != Z_OK)
+      {
+        Log_ErrorPrintf("inflate() failed: %d", err);
+        m_errorState = true;
+        break;
+      }
+    }
+
+    // All of the data has been read, so the compressed data has to end here as well.
+    if (!m_errorState && !m_finished && m_zstream.total_out == m_uncompressedSize)
+    {
+      m_finished = InflateEnd();
+      m_errorState = !m_finished;
+    }
+
+    return m_errorState ? 0 : ByteCount;
+  }
+
+  virtual bool Read2(void* pDestination, u32 ByteCount, u32* pNumberOfBytesRead /* = nullptr */) override
+  {
+    const u32 bytesRead = Read(pDestination, ByteCount);
+    if (pNumberOfBytesRead)
+      *pNumberOfBytesRead = bytesRead;
+
+    return (bytesRead == ByteCount);
+  }
+
+  virtual bool WriteByte(u8 SourceByte) override { return false; }
+  virtual u32 Write(const void* pSource, u32 ByteCount) override { return 0; }
+  virtual bool Write2(const void* pSource, u32 ByteCount, u32* pNumberOfBytesWritten /* = nullptr */) override
+  {
+    if (pNumberOfBytesWritten)
+      *pNumberOfBytesWritten = 0;
+
+    return false;
+  }
+
+  virtual bool SeekAbsolute(u64 Offset) override { return (Offset == m_zstream.total_out); }
+  virtual bool SeekRelative(s64 Offset) override { return (Offset == 0); }
+  virtual bool SeekToEnd() override { return false; }
+  virtual u64 GetPosition() const override { return m_zstream.total_out; }
+  virtual u64 GetSize() const override { return m_zstream.total_out; }
+  virtual bool Flush() override { return true; }
+  virtual bool Commit() override { return true; }
+  virtual bool Discard() override { return true; }
+
+private:
+  bool FillInputBuffer()
+  {
+    const u32 size = std::min<u32>(m_compressedRemaining, sizeof(m_buffer));
+    if (size == 0 || !m_pBaseStream->Read2(m_buffer, size))
+    {
+      Log_ErrorPrintf("Compressed data is truncated");
+      return false;
+    }
+
+    m_compressedRemaining -= size;
+    m_zstream.next_in = m_buffer;
+    m_zstream.avail_in = size;
+    return true;
+  }
+
+  bool InflateEnd()
+  {
+    // Anything which still inflates to output means the stored size was too small.
+    u8 extra_byte;
+    for (;;)
+    {
+      if (m_zstream.avail_in == 0 && !FillInputBuffer())
+        return false;
+
+      m_zstream.next_out = &extra_byte;
+      m_zstream.avail_out = sizeof(extra_byte);
+
+      const int err = inflate(&m_zstream, Z_NO_FLUSH);
+      if (m_zstream.avail_out == 0)
+      {
+        Log_ErrorPrintf("Compressed data is larger than %u bytes", m_uncompressedSize);
+        return false;
+      }
+      else if (err == Z_STREAM_END)
+      {
+        return true;
+      }
+      else if (err != Z_OK)
+      {
+        Log_ErrorPrintf("inflate() failed: %d", err);
+        return false;
+      }
+    }
+  }
+
+  ByteStream* m_pBaseStream;
+  z_stream m_zstream;
+  u32 m_compressedRemaining;
+  u32 m_uncompressedSize;
+  bool m_initialized = false;
+  bool m_finished = false;
+
+  u8 m_buffer[64 * 1024];
+};
+
 std::unique_ptr<MemoryByteStream> ByteStream_CreateMemoryStream(void* pMemory, u32 Size)
 {
   DebugAssert(pMemory != nullptr && Size > 0);
@@ -1287,6 +1575,28 @@ std::unique_ptr<GrowableMemoryByteStream> ByteStream_CreateGrowableMemoryStream(
   return std::make_unique<GrowableMemoryByteStream>(nullptr, 0);
 }
 
+std::unique_ptr<ByteStream> ByteStream_CreateZlibCompressStream(ByteStream* pBaseStream, int CompressionLevel)
+{
+  DebugAssert(pBaseStream != nullptr);
+  std::unique_ptr<ByteStream> stream = std::make_unique<ZlibCompressByteStream>(pBaseStream, CompressionLevel);
+  if (stream->InErrorState())
+    return nullptr;
+
+  return stream;
+}
+
+std::unique_ptr<ByteStream> ByteStream_CreateZlibDecompressStream(ByteStream* pBaseStream, u32 CompressedSize,
+                                                                  u32 UncompressedSize)
+{
+  DebugAssert(pBaseStream != nullptr);
+  std::unique_ptr<ByteStream> stream =
+    std::make_unique<ZlibDecompressByteStream>(pBaseStream, CompressedSize, UncompressedSize);
+  if (stream->InErrorState())
+    return nullptr;
+
+  return stream;
+}
+
 bool ByteStream_CopyStream(ByteStream* pDestinationStream, ByteStream* pSourceStream)
 {
   const u32 chunkSize = 4096;
@@ -14,6 +14,7 @@ enum BYTESTREAM_OPEN_MODE
   BYTESTREAM_OPEN_ATOMIC_UPDATE = 64, //
   BYTESTREAM_OPEN_SEEKABLE = 128,
   BYTESTREAM_OPEN_STREAMED = 256,
+  BYTESTREAM_OPEN_SYNC_ON_COMMIT = 512, // atomic updates are flushed to disk before replacing the original file
 };
 
 // interface class used by readers, writers, etc.
@@ -220,6 +221,15 @@ std::unique_ptr<ReadOnlyMemoryByteStream> ByteStream_CreateReadOnlyMemoryStream(
 // null memory stream
 std::unique_ptr<NullByteStream> ByteStream_CreateNullStream();
 
+// zlib compression stream, which deflates anything written to it into the base stream. Commit() must be called to
+// write out the end of the compressed data. Compression level is the same as zlib, i.e. 1-9.
+std::unique_ptr<ByteStream> ByteStream_CreateZlibCompressStream(ByteStream* pBaseStream, int CompressionLevel);
+
+// zlib decompression stream, which inflates CompressedSize bytes from the base stream's current position. Reads fail
+// if the data doesn't inflate to exactly UncompressedSize bytes.
+std::unique_ptr<ByteStream> ByteStream_CreateZlibDecompressStream(ByteStream* pBaseStream, u32 CompressedSize,
+                                                                  u32 UncompressedSize);
+
 // copies one stream's contents to another. rewinds source streams automatically, and returns it back to its old
 // position.
 bool ByteStream_CopyStream(ByteStream* pDestinationStream, ByteStream* pSourceStream);
@@ -125,10 +125,25 @@ void Event::WaitForMultiple(Event** events, u32 num_events)
 
 #elif defined(__linux__) || defined(__APPLE__) || defined(__HAIKU__)
 
+// Timed waits are against the monotonic clock where it's supported, so they aren't cut short or stretched when the
+// wall clock is stepped or slewed.
+#if defined(__linux__)
+static constexpr clockid_t WAIT_CLOCK = CLOCK_MONOTONIC;
+#else
+static constexpr clockid_t WAIT_CLOCK = CLOCK_REALTIME;
+#endif
+
 Event::Event(bool auto_reset /* = false */) : m_auto_reset(auto_reset)
 {
   pthread_mutex_init(&m_mutex, nullptr);
-  pthread_cond_init(&m_cv, nullptr);
+
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+#if defined(__linux__)
+  pthread_condattr_setclock(&attr, WAIT_CLOCK);
+#endif
+  pthread_cond_init(&m_cv, &attr);
+  pthread_condattr_destroy(&attr);
 }
 
 Event::~Event()
@@ -164,9 +179,14 @@ bool Event::TryWait(u32 timeout_in_ms)
   m_waiters.fetch_add(1);
 
   struct timespec ts;
-  clock_gettime(CLOCK_REALTIME, &ts);
+  clock_gettime(WAIT_CLOCK, &ts);
   ts.tv_sec += timeout_in_ms / 1000;
   ts.tv_nsec += (timeout_in_ms % 1000) * 1000000;
+  if (ts.tv_nsec >= 1000000000)
+  {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000;
+  }
 
   pthread_mutex_lock(&m_mutex);
   while (!m_signaled.load())
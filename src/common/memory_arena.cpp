@@ -2,6 +2,8 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include <cstdlib>
+#include <cstring>
 Log_SetChannel(Common::MemoryArena);
 
 #if defined(WIN32)
@@ -20,6 +22,12 @@ Log_SetChannel(Common::MemoryArena);
 #include <unistd.h>
 #endif
 
+#if defined(MAP_NORESERVE)
+#define SPARSE_MMAP_FLAGS MAP_NORESERVE
+#else
+#define SPARSE_MMAP_FLAGS 0
+#endif
+
 namespace Common {
 
 // Borrowed from Dolphin
@@ -264,6 +272,53 @@ bool MemoryArena::SetPageProtection(void* address, size_t length, bool readable,
 #endif
 }
 
+void* MemoryArena::AllocateSparseMemory(size_t size)
+{
+  void* address;
+#if defined(WIN32)
+  // Committed pages are still demand-zero, they don't join the working set until they're touched.
+  address = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+  address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | SPARSE_MMAP_FLAGS, -1, 0);
+  if (address == MAP_FAILED)
+    address = nullptr;
+#else
+  address = std::calloc(1, size);
+#endif
+
+  if (!address)
+    Log_ErrorPrintf("Failed to allocate %zu bytes of sparse memory", size);
+
+  return address;
+}
+
+void MemoryArena::FreeSparseMemory(void* address, size_t size)
+{
+#if defined(WIN32)
+  VirtualFree(address, 0, MEM_RELEASE);
+#elif defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+  munmap(address, size);
+#else
+  std::free(address);
+#endif
+}
+
+bool MemoryArena::ResetSparseMemory(void* address, size_t size)
+{
+#if defined(WIN32)
+  return (VirtualFree(address, size, MEM_DECOMMIT) &&
+          VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) == address);
+#elif defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+  // Mapping over the range replaces it with fresh zero pages. MADV_DONTNEED would do the same on Linux, but not on
+  // macOS, where the old contents can survive.
+  return (mmap(address, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_FIXED | SPARSE_MMAP_FLAGS, -1, 0) ==
+          address);
+#else
+  std::memset(address, 0, size);
+  return true;
+#endif
+}
+
 MemoryArena::View::View(MemoryArena* parent, void* base_pointer, size_t arena_offset, size_t mapping_size,
                         bool writable)
   : m_parent(parent), m_base_pointer(base_pointer), m_arena_offset(arena_offset), m_mapping_size(mapping_size),
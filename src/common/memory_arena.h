@@ -43,6 +43,13 @@ public:
 
   static bool SetPageProtection(void* address, size_t length, bool readable, bool writable, bool executable);
 
+  /// Allocates zero-filled memory which only takes up physical memory once its pages are touched.
+  static void* AllocateSparseMemory(size_t size);
+  static void FreeSparseMemory(void* address, size_t size);
+
+  /// Zeroes sparse memory by discarding its pages, which also returns them to the OS.
+  static bool ResetSparseMemory(void* address, size_t size);
+
 private:
 #if defined(WIN32)
   void* m_file_handle = nullptr;
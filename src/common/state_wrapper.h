@@ -21,10 +21,15 @@ public:
   };
 
   StateWrapper(ByteStream* stream, Mode mode, u32 version);
+
+  /// Reads/writes directly from/to a memory buffer, bypassing the stream. Running past the end is an error.
+  StateWrapper(void* buffer, u32 buffer_size, Mode mode, u32 version);
+
   StateWrapper(const StateWrapper&) = delete;
   ~StateWrapper();
 
   ByteStream* GetStream() const { return m_stream; }
+  u64 GetPosition() const { return m_stream ? m_stream->GetPosition() : m_buffer_position; }
   bool HasError() const { return m_error; }
   bool IsReading() const { return (m_mode == Mode::Read); }
   bool IsWriting() const { return (m_mode == Mode::Write); }
@@ -38,13 +43,13 @@ public:
   {
     if (m_mode == Mode::Read)
     {
-      if (m_error || (m_error |= !m_stream->Read2(value_ptr, sizeof(T))) == true)
+      if (m_error || (m_error |= !ReadData(value_ptr, sizeof(T))) == true)
         *value_ptr = static_cast<T>(0);
     }
     else
     {
       if (!m_error)
-        m_error |= !m_stream->Write2(value_ptr, sizeof(T));
+        m_error |= !WriteData(value_ptr, sizeof(T));
     }
   }
 
@@ -56,7 +61,7 @@ public:
     if (m_mode == Mode::Read)
     {
       TType temp;
-      if (m_error || (m_error |= !m_stream->Read2(&temp, sizeof(TType))) == true)
+      if (m_error || (m_error |= !ReadData(&temp, sizeof(TType))) == true)
         temp = static_cast<TType>(0);
 
       *value_ptr = static_cast<T>(temp);
@@ -66,7 +71,7 @@ public:
       TType temp;
       std::memcpy(&temp, value_ptr, sizeof(TType));
       if (!m_error)
-        m_error |= !m_stream->Write2(&temp, sizeof(TType));
+        m_error |= !WriteData(&temp, sizeof(TType));
     }
   }
 
@@ -76,13 +81,13 @@ public:
   {
     if (m_mode == Mode::Read)
     {
-      if (m_error || (m_error |= !m_stream->Read2(value_ptr, sizeof(T))) == true)
+      if (m_error || (m_error |= !ReadData(value_ptr, sizeof(T))) == true)
         std::memset(value_ptr, 0, sizeof(*value_ptr));
     }
     else
     {
       if (!m_error)
-        m_error |= !m_stream->Write2(value_ptr, sizeof(T));
+        m_error |= !WriteData(value_ptr, sizeof(T));
     }
   }
 
@@ -158,11 +163,13 @@ public:
 
     if (m_mode == Mode::Read)
     {
-      T* temp = new T[size];
-      DoArray(temp, size);
       data->Clear();
-      data->PushRange(temp, size);
-      delete[] temp;
+      for (u32 i = 0; i < size; i++)
+      {
+        T temp;
+        Do(&temp);
+        data->Push(temp);
+      }
     }
     else
     {
@@ -189,7 +196,36 @@ public:
   }
 
 private:
-  ByteStream* m_stream;
+  ALWAYS_INLINE bool ReadData(void* data, u32 size)
+  {
+    if (m_stream)
+      return m_stream->Read2(data, size);
+
+    if ((m_buffer_size - m_buffer_position) < size)
+      return false;
+
+    std::memcpy(data, m_buffer + m_buffer_position, size);
+    m_buffer_position += size;
+    return true;
+  }
+
+  ALWAYS_INLINE bool WriteData(const void* data, u32 size)
+  {
+    if (m_stream)
+      return m_stream->Write2(data, size);
+
+    if ((m_buffer_size - m_buffer_position) < size)
+      return false;
+
+    std::memcpy(m_buffer + m_buffer_position, data, size);
+    m_buffer_position += size;
+    return true;
+  }
+
+  ByteStream* m_stream = nullptr;
+  u8* m_buffer = nullptr;
+  u32 m_buffer_size = 0;
+  u32 m_buffer_position = 0;
   Mode m_mode;
   u32 m_version;
   bool m_error = false;
@@ -0,0 +1,227 @@
+#include "time_stretcher.h"
+#include "align.h"
+#include "assert.h"
+#include "cpu_detect.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace Common {
+
+TimeStretcher::TimeStretcher() = default;
+
+TimeStretcher::~TimeStretcher() = default;
+
+void TimeStretcher::Configure(u32 sample_rate, u32 channels)
+{
+  m_channels = channels;
+
+  // Keep the overlap a multiple of 4 frames, that way the correlation loop is always a whole number of vectors.
+  m_sequence_length = (sample_rate * SEQUENCE_LENGTH_MS) / 1000;
+  m_seek_window_length = (sample_rate * SEEK_WINDOW_LENGTH_MS) / 1000;
+  m_overlap_length = Common::AlignUpPow2((sample_rate * OVERLAP_LENGTH_MS) / 1000, 4);
+  m_overlap_buffer.resize(m_overlap_length * m_channels);
+
+  SetTempo(m_tempo);
+  Clear();
+}
+
+void TimeStretcher::Clear()
+{
+  m_input.clear();
+  m_input_position = 0;
+  m_output.clear();
+  m_output_position = 0;
+  m_skip_fraction = 0.0;
+  m_have_overlap = false;
+}
+
+void TimeStretcher::SetTempo(float tempo)
+{
+  m_tempo = std::clamp(tempo, MIN_TEMPO, MAX_TEMPO);
+  m_nominal_skip = static_cast<double>(m_tempo) * static_cast<double>(m_sequence_length - m_overlap_length);
+}
+
+void TimeStretcher::PutFrames(const s16* frames, u32 num_frames)
+{
+  DebugAssert(m_channels > 0);
+
+  CompactBuffers();
+
+  const u32 num_samples = num_frames * m_channels;
+  const size_t start = m_input.size();
+  m_input.resize(start + num_samples);
+  for (u32 i = 0; i < num_samples; i++)
+    m_input[start + i] = static_cast<float>(frames[i]);
+
+  const u32 required_frames = GetRequiredInputFrames();
+  while ((static_cast<u32>(m_input.size() / m_channels) - m_input_position) >= required_frames)
+    ProcessSequence();
+}
+
+u32 TimeStretcher::ReceiveFrames(s16* frames, u32 max_frames)
+{
+  const u32 num_frames = std::min(max_frames, GetAvailableFrames());
+  const u32 num_samples = num_frames * m_channels;
+  const float* src = &m_output[m_output_position * m_channels];
+  for (u32 i = 0; i < num_samples; i++)
+    frames[i] = static_cast<s16>(std::clamp(src[i], -32768.0f, 32767.0f));
+
+  m_output_position += num_frames;
+  return num_frames;
+}
+
+u32 TimeStretcher::GetRequiredInputFrames() const
+{
+  const u32 skip = static_cast<u32>(std::ceil(m_nominal_skip + m_skip_fraction));
+  return std::max(skip + m_overlap_length, m_sequence_length) + m_seek_window_length;
+}
+
+ALWAYS_INLINE static void CorrelateOverlap(const float* reference, const float* compare, u32 count, float* dot,
+                                           float* energy)
+{
+#if defined(CPU_X64)
+  __m128 vdot = _mm_setzero_ps();
+  __m128 venergy = _mm_setzero_ps();
+  for (u32 i = 0; i < count; i += 4)
+  {
+    const __m128 r = _mm_loadu_ps(reference + i);
+    const __m128 c = _mm_loadu_ps(compare + i);
+    vdot = _mm_add_ps(vdot, _mm_mul_ps(r, c));
+    venergy = _mm_add_ps(venergy, _mm_mul_ps(c, c));
+  }
+
+  // horizontal add both accumulators at once
+  const __m128 lo = _mm_unpacklo_ps(vdot, venergy);
+  const __m128 hi = _mm_unpackhi_ps(vdot, venergy);
+  const __m128 sum = _mm_add_ps(lo, hi);
+  const __m128 total = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  alignas(16) float result[4];
+  _mm_store_ps(result, total);
+  *dot = result[0];
+  *energy = result[1];
+#elif defined(CPU_AARCH64)
+  float32x4_t vdot = vdupq_n_f32(0.0f);
+  float32x4_t venergy = vdupq_n_f32(0.0f);
+  for (u32 i = 0; i < count; i += 4)
+  {
+    const float32x4_t r = vld1q_f32(reference + i);
+    const float32x4_t c = vld1q_f32(compare + i);
+    vdot = vmlaq_f32(vdot, r, c);
+    venergy = vmlaq_f32(venergy, c, c);
+  }
+
+  *dot = vaddvq_f32(vdot);
+  *energy = vaddvq_f32(venergy);
+#else
+  float sdot = 0.0f;
+  float senergy = 0.0f;
+  for (u32 i = 0; i < count; i++)
+  {
+    sdot += reference[i] * compare[i];
+    senergy += compare[i] * compare[i];
+  }
+
+  *dot = sdot;
+  *energy = senergy;
+#endif
+}
+
+u32 TimeStretcher::SeekBestOverlapPosition(const float* input, u32 start, u32 end, u32 step) const
+{
+  const u32 count = m_overlap_length * m_channels;
+  u32 best_offset = start;
+  float best_score = -1.0e30f;
+
+  for (u32 offset = start; offset < end; offset += step)
+  {
+    float dot, energy;
+    CorrelateOverlap(m_overlap_buffer.data(), input + offset * m_channels, count, &dot, &energy);
+
+    // normalize by the candidate's energy, otherwise louder sections always win
+    const float score = dot / std::sqrt(std::max(energy, 1.0f));
+    if (score > best_score)
+    {
+      best_score = score;
+      best_offset = offset;
+    }
+  }
+
+  return best_offset;
+}
+
+void TimeStretcher::ProcessSequence()
+{
+  const float* input = &m_input[m_input_position * m_channels];
+
+  if (!m_have_overlap)
+  {
+    // Nothing to fade from yet, so start the stream with the input as-is.
+    std::copy_n(input, m_overlap_length * m_channels, m_overlap_buffer.begin());
+    m_input_position += m_overlap_length;
+    m_have_overlap = true;
+    return;
+  }
+
+  // Coarse pass over the whole window, then refine around the best coarse match.
+  u32 offset = SeekBestOverlapPosition(input, 0, m_seek_window_length, COARSE_SEEK_STEP);
+  offset = SeekBestOverlapPosition(input, (offset >= COARSE_SEEK_STEP) ? (offset - COARSE_SEEK_STEP + 1) : 0,
+                                   std::min(offset + COARSE_SEEK_STEP, m_seek_window_length), 1);
+
+  const float* sequence = input + offset * m_channels;
+  const size_t output_start = m_output.size();
+  m_output.resize(output_start + (m_sequence_length - m_overlap_length) * m_channels);
+  float* out = &m_output[output_start];
+
+  // cross-fade the previous tail into the start of this sequence
+  const float fade_step = 1.0f / static_cast<float>(m_overlap_length);
+  for (u32 i = 0; i < m_overlap_length; i++)
+  {
+    const float fade_in = static_cast<float>(i) * fade_step;
+    const float fade_out = 1.0f - fade_in;
+    for (u32 c = 0; c < m_channels; c++)
+    {
+      const u32 index = i * m_channels + c;
+      out[index] = m_overlap_buffer[index] * fade_out + sequence[index] * fade_in;
+    }
+  }
+
+  // middle goes through untouched
+  const u32 middle_samples = (m_sequence_length - 2 * m_overlap_length) * m_channels;
+  std::copy_n(sequence + m_overlap_length * m_channels, middle_samples, out + m_overlap_length * m_channels);
+
+  // and the tail is kept for the next sequence
+  std::copy_n(sequence + (m_sequence_length - m_overlap_length) * m_channels, m_overlap_length * m_channels,
+              m_overlap_buffer.begin());
+
+  m_skip_fraction += m_nominal_skip;
+  const u32 skip = static_cast<u32>(m_skip_fraction);
+  m_skip_fraction -= static_cast<double>(skip);
+  m_input_position += skip;
+}
+
+void TimeStretcher::CompactBuffers()
+{
+  if (m_input_position > 0)
+  {
+    m_input.erase(m_input.begin(), m_input.begin() + static_cast<size_t>(m_input_position) * m_channels);
+    m_input_position = 0;
+  }
+
+  if (m_output_position > 0)
+  {
+    m_output.erase(m_output.begin(), m_output.begin() + static_cast<size_t>(m_output_position) * m_channels);
+    m_output_position = 0;
+  }
+}
+
+} // namespace Common
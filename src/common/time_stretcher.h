@@ -0,0 +1,61 @@
+#pragma once
+#include "types.h"
+#include <vector>
+
+namespace Common {
+
+// Changes the tempo of a stream of interleaved signed 16-bit samples without changing its pitch, using WSOLA
+// (waveform similarity overlap-add). Each output sequence is cross-faded into the previous one at the offset within a
+// small seek window where the two waveforms line up best, and the input is advanced by tempo * sequence length.
+class TimeStretcher
+{
+public:
+  TimeStretcher();
+  ~TimeStretcher();
+
+  ALWAYS_INLINE float GetTempo() const { return m_tempo; }
+  ALWAYS_INLINE u32 GetAvailableFrames() const { return static_cast<u32>(m_output.size() / m_channels) - m_output_position; }
+
+  void Configure(u32 sample_rate, u32 channels);
+  void Clear();
+
+  /// Tempo > 1 plays faster (consumes more input per output frame), < 1 slower.
+  void SetTempo(float tempo);
+
+  void PutFrames(const s16* frames, u32 num_frames);
+  u32 ReceiveFrames(s16* frames, u32 max_frames);
+
+private:
+  static constexpr u32 SEQUENCE_LENGTH_MS = 40;
+  static constexpr u32 SEEK_WINDOW_LENGTH_MS = 15;
+  static constexpr u32 OVERLAP_LENGTH_MS = 8;
+  static constexpr u32 COARSE_SEEK_STEP = 4;
+  static constexpr float MIN_TEMPO = 0.1f;
+  static constexpr float MAX_TEMPO = 8.0f;
+
+  u32 GetRequiredInputFrames() const;
+  u32 SeekBestOverlapPosition(const float* input, u32 start, u32 end, u32 step) const;
+  void ProcessSequence();
+  void CompactBuffers();
+
+  u32 m_channels = 0;
+  u32 m_sequence_length = 0;
+  u32 m_seek_window_length = 0;
+  u32 m_overlap_length = 0;
+
+  float m_tempo = 1.0f;
+  double m_nominal_skip = 0.0;
+  double m_skip_fraction = 0.0;
+
+  // Interleaved, converted to float on the way in so the correlation loop doesn't have to worry about overflow.
+  std::vector<float> m_input;
+  u32 m_input_position = 0;
+  std::vector<float> m_output;
+  u32 m_output_position = 0;
+
+  // Tail of the previous sequence, to be cross-faded with the start of the next.
+  std::vector<float> m_overlap_buffer;
+  bool m_have_overlap = false;
+};
+
+} // namespace Common
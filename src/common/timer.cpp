@@ -1,12 +1,19 @@
 #include "timer.h"
 
+#include "cpu_detect.h"
+
 #ifdef WIN32
 #include "windows_headers.h"
 #else
+#include <cerrno>
 #include <sys/time.h>
 #include <time.h>
 #endif
 
+#if defined(CPU_X64) || defined(CPU_X86)
+#include <emmintrin.h>
+#endif
+
 namespace Common {
 
 #ifdef WIN32
@@ -45,6 +52,23 @@ double Timer::ConvertValueToSeconds(Timer::Value value)
   return ((static_cast<double>(value) / s_counter_frequency) / 1000000000.0);
 }
 
+Timer::Value Timer::ConvertNanosecondsToValue(double ns)
+{
+  return static_cast<Value>(ns * s_counter_frequency);
+}
+
+void Timer::SleepUntil(Value value)
+{
+  // Sleep() only has millisecond granularity, round down and let the caller spin the remainder.
+  const Value current_value = GetValue();
+  if (value <= current_value)
+    return;
+
+  const double ms = ConvertValueToMilliseconds(value - current_value);
+  if (ms >= 1.0)
+    Sleep(static_cast<DWORD>(ms));
+}
+
 #else
 
 #if 1 // using clock_gettime()
@@ -71,6 +95,30 @@ double Timer::ConvertValueToSeconds(Timer::Value value)
   return (static_cast<double>(value) / 1000000000.0);
 }
 
+Timer::Value Timer::ConvertNanosecondsToValue(double ns)
+{
+  return static_cast<Value>(ns);
+}
+
+void Timer::SleepUntil(Value value)
+{
+#ifdef __APPLE__
+  // No clock_nanosleep(), fall back to a relative sleep.
+  const Value current_value = GetValue();
+  if (value <= current_value)
+    return;
+
+  const Value ns = value - current_value;
+  const struct timespec ts = {static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+  nanosleep(&ts, nullptr);
+#else
+  const struct timespec ts = {static_cast<time_t>(value / 1000000000), static_cast<long>(value % 1000000000)};
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+  {
+  }
+#endif
+}
+
 #else // using gettimeofday()
 
 Timer::Value Timer::GetValue()
@@ -95,9 +143,37 @@ double Timer::ConvertValueToSeconds(Timer::Value value)
   return ((double)value / 1000000.0);
 }
 
+Timer::Value Timer::ConvertNanosecondsToValue(double ns)
+{
+  return static_cast<Value>(ns / 1000.0);
+}
+
+void Timer::SleepUntil(Value value)
+{
+  const Value current_value = GetValue();
+  if (value <= current_value)
+    return;
+
+  const Value us = value - current_value;
+  const struct timespec ts = {static_cast<time_t>(us / 1000000), static_cast<long>((us % 1000000) * 1000)};
+  nanosleep(&ts, nullptr);
+}
+
+#endif
+
 #endif
 
+void Timer::SpinUntil(Value value)
+{
+  while (GetValue() < value)
+  {
+#if defined(CPU_X64) || defined(CPU_X86)
+    _mm_pause();
+#elif defined(CPU_AARCH64) && !defined(_MSC_VER)
+    asm volatile("yield");
 #endif
+  }
+}
 
 Timer::Timer()
 {
@@ -15,6 +15,14 @@ public:
   static double ConvertValueToSeconds(Value value);
   static double ConvertValueToMilliseconds(Value value);
   static double ConvertValueToNanoseconds(Value value);
+  static Value ConvertNanosecondsToValue(double ns);
+
+  /// Sleeps until the specified value is reached. An absolute deadline is used where the OS supports it, so any time
+  /// spent before the call is not added to the sleep. Wake-up can still be late by the scheduler granularity.
+  static void SleepUntil(Value value);
+
+  /// Busy-waits until the specified value is reached.
+  static void SpinUntil(Value value);
 
   void Reset();
 
@@ -22,6 +30,8 @@ public:
   double GetTimeMilliseconds() const;
   double GetTimeNanoseconds() const;
 
+  ALWAYS_INLINE Value GetStartValue() const { return m_tvStartValue; }
+
 private:
   Value m_tvStartValue;
 };
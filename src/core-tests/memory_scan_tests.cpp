@@ -0,0 +1,286 @@
+#include "core/bus.h"
+#include "core/cheats.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+class MemoryScanTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_ram.assign(Bus::RAM_SIZE, 0);
+    m_saved_ram = Bus::g_ram;
+    Bus::g_ram = m_ram.data();
+  }
+
+  void TearDown() override { Bus::g_ram = m_saved_ram; }
+
+  std::vector<u8> m_ram;
+  u8* m_saved_ram = nullptr;
+};
+
+// Start and end aren't aligned, and the range doesn't fill the last candidate word. It is small enough for every byte
+// match to be listed.
+static constexpr PhysicalMemoryAddress SCAN_START = 0x1003;
+static constexpr PhysicalMemoryAddress SCAN_END = 0x1000 + (64 * 4 * 15) + 5;
+
+static constexpr MemoryScan::Operator ALL_OPERATORS[] = {
+  MemoryScan::Operator::Equal,           MemoryScan::Operator::NotEqual,
+  MemoryScan::Operator::GreaterThan,     MemoryScan::Operator::GreaterEqual,
+  MemoryScan::Operator::LessThan,        MemoryScan::Operator::LessEqual,
+  MemoryScan::Operator::IncreasedBy,     MemoryScan::Operator::DecreasedBy,
+  MemoryScan::Operator::ChangedBy,       MemoryScan::Operator::EqualLast,
+  MemoryScan::Operator::NotEqualLast,    MemoryScan::Operator::GreaterThanLast,
+  MemoryScan::Operator::GreaterEqualLast, MemoryScan::Operator::LessThanLast,
+  MemoryScan::Operator::LessEqualLast,   MemoryScan::Operator::Any};
+
+static constexpr MemoryAccessSize ALL_SIZES[] = {MemoryAccessSize::Byte, MemoryAccessSize::HalfWord,
+                                                 MemoryAccessSize::Word};
+
+static u32 ReadValue(const u8* ptr, MemoryAccessSize size, bool is_signed)
+{
+  switch (size)
+  {
+    case MemoryAccessSize::Byte:
+      return is_signed ? SignExtend32(*ptr) : ZeroExtend32(*ptr);
+
+    case MemoryAccessSize::HalfWord:
+    {
+      u16 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return is_signed ? SignExtend32(value) : ZeroExtend32(value);
+    }
+
+    case MemoryAccessSize::Word:
+    default:
+    {
+      u32 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return value;
+    }
+  }
+}
+
+// Compares sign/zero-extended 32-bit values one at a time, which is what the scanner did before it was vectorised.
+// Differences wrap instead of overflowing.
+static bool ReferenceFilter(MemoryScan::Operator op, u32 comp_value, bool is_signed, u32 value, u32 last_value)
+{
+  using Operator = MemoryScan::Operator;
+  const s32 svalue = static_cast<s32>(value);
+  const s32 slast = static_cast<s32>(last_value);
+  const s32 scomp = static_cast<s32>(comp_value);
+  switch (op)
+  {
+    case Operator::Equal:
+      return (value == comp_value);
+    case Operator::NotEqual:
+      return (value != comp_value);
+    case Operator::GreaterThan:
+      return is_signed ? (svalue > scomp) : (value > comp_value);
+    case Operator::GreaterEqual:
+      return is_signed ? (svalue >= scomp) : (value >= comp_value);
+    case Operator::LessThan:
+      return is_signed ? (svalue < scomp) : (value < comp_value);
+    case Operator::LessEqual:
+      return is_signed ? (svalue <= scomp) : (value <= comp_value);
+    case Operator::IncreasedBy:
+      return ((value - last_value) == comp_value);
+    case Operator::DecreasedBy:
+      return ((last_value - value) == comp_value);
+    case Operator::ChangedBy:
+    {
+      if (is_signed)
+      {
+        const s64 diff = static_cast<s32>(last_value - value);
+        return static_cast<u32>(std::abs(diff)) == comp_value;
+      }
+
+      return ((last_value > value) ? (last_value - value) : (value - last_value)) == comp_value;
+    }
+    case Operator::EqualLast:
+      return (value == last_value);
+    case Operator::NotEqualLast:
+      return (value != last_value);
+    case Operator::GreaterThanLast:
+      return is_signed ? (svalue > slast) : (value > last_value);
+    case Operator::GreaterEqualLast:
+      return is_signed ? (svalue >= slast) : (value >= last_value);
+    case Operator::LessThanLast:
+      return is_signed ? (svalue < slast) : (value < last_value);
+    case Operator::LessEqualLast:
+      return is_signed ? (svalue <= slast) : (value <= last_value);
+    case Operator::Any:
+    default:
+      return true;
+  }
+}
+
+// Values near the comparison value and the size limits, so every operator sees matches on both sides.
+static u32 GetInterestingValue(std::mt19937& rng, u32 comp_value)
+{
+  static constexpr u32 values[] = {0u, 1u, 2u, 0x7Fu, 0x80u, 0xFFu, 0x7FFFu, 0x8000u, 0xFFFFu, 0x7FFFFFFFu, 0x80000000u};
+  switch (rng() % 4)
+  {
+    case 0:
+      return values[rng() % std::size(values)];
+    case 1:
+      return comp_value + (rng() % 5) - 2;
+    case 2:
+      return -comp_value + (rng() % 5) - 2;
+    default:
+      return static_cast<u32>(rng());
+  }
+}
+
+static void FillRange(std::mt19937& rng, u8* ram, MemoryAccessSize size, u32 comp_value)
+{
+  const u32 element_size = 1u << static_cast<u32>(size);
+  for (u32 address = SCAN_START & ~(element_size - 1); address < SCAN_END + element_size; address += element_size)
+  {
+    const u32 value = GetInterestingValue(rng, comp_value);
+    std::memcpy(ram + address, &value, element_size);
+  }
+}
+
+// Changes some of the values by the comparison value, so the difference operators match.
+static void ChangeRange(std::mt19937& rng, u8* ram, MemoryAccessSize size, u32 comp_value)
+{
+  const u32 element_size = 1u << static_cast<u32>(size);
+  for (u32 address = SCAN_START & ~(element_size - 1); address < SCAN_END + element_size; address += element_size)
+  {
+    u32 value = 0;
+    std::memcpy(&value, ram + address, element_size);
+    switch (rng() % 4)
+    {
+      case 0:
+        value += comp_value;
+        break;
+      case 1:
+        value -= comp_value;
+        break;
+      case 2:
+        value = GetInterestingValue(rng, comp_value);
+        break;
+      default:
+        break;
+    }
+    std::memcpy(ram + address, &value, element_size);
+  }
+}
+
+static void CheckResults(const MemoryScan& scan, const u8* ram, const std::vector<u8>& last_ram, MemoryAccessSize size,
+                         MemoryScan::Operator op, u32 comp_value, bool is_signed)
+{
+  const u32 element_size = 1u << static_cast<u32>(size);
+  u32 expected_count = 0;
+  for (u32 address = (SCAN_START + element_size - 1) & ~(element_size - 1); address < SCAN_END;
+       address += element_size)
+  {
+    const u32 value = ReadValue(ram + address, size, is_signed);
+    const u32 last_value = ReadValue(last_ram.data() + address, size, is_signed);
+    if (!ReferenceFilter(op, comp_value, is_signed, value, last_value))
+      continue;
+
+    ASSERT_LT(expected_count, scan.GetResults().size());
+    const MemoryScan::Result& res = scan.GetResult(expected_count);
+    ASSERT_EQ(res.address, address);
+    ASSERT_EQ(res.value, value);
+    expected_count++;
+  }
+
+  ASSERT_EQ(scan.GetResultCount(), expected_count);
+  ASSERT_EQ(scan.GetResults().size(), expected_count);
+}
+} // namespace
+
+TEST_F(MemoryScanTest, FirstSearchMatchesReference)
+{
+  std::mt19937 rng(1234);
+  for (const MemoryAccessSize size : ALL_SIZES)
+  {
+    for (const bool is_signed : {false, true})
+    {
+      for (const MemoryScan::Operator op : ALL_OPERATORS)
+      {
+        for (const u32 comp_value : {0u, 1u, 0x7Fu, 0x80u, 0xFFFFu, 0xFFFFFFFFu, 0x80000000u})
+        {
+          SCOPED_TRACE(testing::Message() << "size " << static_cast<u32>(size) << " signed " << is_signed << " op "
+                                          << static_cast<u32>(op) << " value " << comp_value);
+          FillRange(rng, m_ram.data(), size, comp_value);
+
+          MemoryScan scan;
+          scan.SetSize(size);
+          scan.SetValueSigned(is_signed);
+          scan.SetOperator(op);
+          scan.SetValue(comp_value);
+          scan.SetStartAddress(SCAN_START);
+          scan.SetEndAddress(SCAN_END);
+          scan.Search();
+          CheckResults(scan, m_ram.data(), m_ram, size, op, comp_value, is_signed);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(MemoryScanTest, SearchAgainMatchesReference)
+{
+  std::mt19937 rng(5678);
+  for (const MemoryAccessSize size : ALL_SIZES)
+  {
+    for (const bool is_signed : {false, true})
+    {
+      for (const MemoryScan::Operator op : ALL_OPERATORS)
+      {
+        for (const u32 comp_value : {0u, 1u, 3u, 0x80u, 0xFFFFu, 0xFFFFFFFFu, 0x80000000u})
+        {
+          SCOPED_TRACE(testing::Message() << "size " << static_cast<u32>(size) << " signed " << is_signed << " op "
+                                          << static_cast<u32>(op) << " value " << comp_value);
+          FillRange(rng, m_ram.data(), size, comp_value);
+
+          MemoryScan scan;
+          scan.SetSize(size);
+          scan.SetValueSigned(is_signed);
+          scan.SetOperator(MemoryScan::Operator::Any);
+          scan.SetStartAddress(SCAN_START);
+          scan.SetEndAddress(SCAN_END);
+          scan.Search();
+
+          const std::vector<u8> last_ram(m_ram);
+          ChangeRange(rng, m_ram.data(), size, comp_value);
+          scan.SetOperator(op);
+          scan.SetValue(comp_value);
+          scan.SearchAgain();
+          CheckResults(scan, m_ram.data(), last_ram, size, op, comp_value, is_signed);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(MemoryScanTest, ChangingSizeDiscardsSearch)
+{
+  std::mt19937 rng(1);
+  FillRange(rng, m_ram.data(), MemoryAccessSize::Word, 0);
+
+  MemoryScan scan;
+  scan.SetSize(MemoryAccessSize::HalfWord);
+  scan.SetOperator(MemoryScan::Operator::Any);
+  scan.SetStartAddress(SCAN_START);
+  scan.SetEndAddress(SCAN_END);
+  scan.Search();
+  ASSERT_GT(scan.GetResultCount(), 0u);
+
+  scan.SetSize(MemoryAccessSize::HalfWord);
+  ASSERT_GT(scan.GetResultCount(), 0u);
+
+  scan.SetSize(MemoryAccessSize::Word);
+  ASSERT_EQ(scan.GetResultCount(), 0u);
+  ASSERT_TRUE(scan.GetResults().empty());
+  scan.SearchAgain();
+  ASSERT_EQ(scan.GetResultCount(), 0u);
+}
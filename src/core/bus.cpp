@@ -72,6 +72,7 @@ union MEMCTRL
 };
 
 std::bitset<RAM_CODE_PAGE_COUNT> m_ram_code_bits{};
+std::array<u8, RAM_CODE_PAGE_COUNT> m_ram_dirty_pages{};
 u8* g_ram = nullptr;    // 2MB RAM
 u8 g_bios[BIOS_SIZE]{}; // 512K BIOS ROM
 
@@ -170,18 +171,58 @@ void Reset()
   m_MEMCTRL.common_delay.bits = 0x00031125;
   m_ram_size_reg = UINT32_C(0x00000B88);
   m_ram_code_bits = {};
+  m_ram_dirty_pages.fill(1);
   RecalculateMemoryTimings();
 }
 
-bool DoState(StateWrapper& sw)
+bool DoState(StateWrapper& sw, u8* ram_snapshot, bool incremental)
 {
   sw.Do(&m_exp1_access_time);
   sw.Do(&m_exp2_access_time);
   sw.Do(&m_bios_access_time);
   sw.Do(&m_cdrom_access_time);
   sw.Do(&m_spu_access_time);
-  sw.DoBytes(g_ram, RAM_SIZE);
-  sw.DoBytes(g_bios, BIOS_SIZE);
+  if (!ram_snapshot)
+  {
+    sw.DoBytes(g_ram, RAM_SIZE);
+    sw.DoBytes(g_bios, BIOS_SIZE);
+    if (sw.IsReading())
+      m_ram_dirty_pages.fill(1);
+  }
+  else
+  {
+    // Every path which writes RAM flags the page, including the recompiler's fastmem stores.
+    if (sw.IsReading())
+    {
+      // Flushing the whole code cache would mean recompiling everything, so only invalidate the code pages which
+      // are different in the snapshot.
+      for (u32 i = 0; i < (RAM_SIZE / HOST_PAGE_SIZE); i++)
+      {
+        if (incremental && !m_ram_dirty_pages[i])
+          continue;
+
+        const u32 offset = i * HOST_PAGE_SIZE;
+        if (m_ram_code_bits[i] && std::memcmp(g_ram + offset, ram_snapshot + offset, HOST_PAGE_SIZE) != 0)
+          CPU::CodeCache::InvalidateBlocksWithPageIndex(i);
+
+        std::memcpy(g_ram + offset, ram_snapshot + offset, HOST_PAGE_SIZE);
+      }
+    }
+    else if (incremental)
+    {
+      for (u32 i = 0; i < (RAM_SIZE / HOST_PAGE_SIZE); i++)
+      {
+        if (m_ram_dirty_pages[i])
+          std::memcpy(ram_snapshot + i * HOST_PAGE_SIZE, g_ram + i * HOST_PAGE_SIZE, HOST_PAGE_SIZE);
+      }
+    }
+    else
+    {
+      std::memcpy(ram_snapshot, g_ram, RAM_SIZE);
+    }
+
+    m_ram_dirty_pages.fill(0);
+  }
   sw.DoArray(m_MEMCTRL.regs, countof(m_MEMCTRL.regs));
   sw.Do(&m_ram_size_reg);
   sw.Do(&m_tty_line_buffer);
@@ -740,6 +781,7 @@ ALWAYS_INLINE static TickCount DoRAMAccess(u32 offset, u32& value)
     const u32 page_index = offset / HOST_PAGE_SIZE;
     if (m_ram_code_bits[page_index])
       CPU::CodeCache::InvalidateBlocksWithPageIndex(page_index);
+    m_ram_dirty_pages[page_index] = 1;
 
     if constexpr (size == MemoryAccessSize::Byte)
     {
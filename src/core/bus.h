@@ -97,7 +97,11 @@ enum : size_t
 bool Initialize();
 void Shutdown();
 void Reset();
-bool DoState(StateWrapper& sw);
+
+/// If ram_snapshot is set, RAM is copied to/from it instead of going through the state wrapper. The BIOS is skipped in
+/// this case, since it can't change while the system is running. If incremental is also set, the snapshot must match
+/// RAM as of the last snapshot save/load, so only the pages written since then are copied.
+bool DoState(StateWrapper& sw, u8* ram_snapshot, bool incremental);
 
 CPUFastmemMode GetFastmemMode();
 void UpdateFastmemViews(CPUFastmemMode mode, bool isolate_cache);
@@ -107,6 +111,8 @@ void SetExpansionROM(std::vector<u8> data);
 void SetBIOS(const std::vector<u8>& image);
 
 extern std::bitset<RAM_CODE_PAGE_COUNT> m_ram_code_bits;
+// One byte per page rather than a bitset, so the recompiler can flag fastmem stores with a plain byte store.
+extern std::array<u8, RAM_CODE_PAGE_COUNT> m_ram_dirty_pages;
 extern u8* g_ram;            // 2MB RAM
 extern u8 g_bios[BIOS_SIZE]; // 512K BIOS ROM
 
@@ -122,6 +128,24 @@ ALWAYS_INLINE static u32 GetRAMCodePageIndex(PhysicalMemoryAddress address)
   return (address & RAM_MASK) / HOST_PAGE_SIZE;
 }
 
+/// Flags the RAM pages overlapping the specified range as written since the last memory state snapshot.
+ALWAYS_INLINE static void MarkRAMPagesDirty(PhysicalMemoryAddress address, u32 size)
+{
+  if (size >= RAM_SIZE)
+  {
+    m_ram_dirty_pages.fill(1);
+    return;
+  }
+
+  const u32 end_page = GetRAMCodePageIndex(address + size - 1);
+  for (u32 page = GetRAMCodePageIndex(address);; page = (page + 1) % (RAM_SIZE / HOST_PAGE_SIZE))
+  {
+    m_ram_dirty_pages[page] = 1;
+    if (page == end_page)
+      break;
+  }
+}
+
 /// Returns true if the specified page contains code.
 bool IsRAMCodePage(u32 index);
 
@@ -6,6 +6,7 @@
 #include "common/state_wrapper.h"
 #include "dma.h"
 #include "interrupt_controller.h"
+#include "perf_timers.h"
 #include "settings.h"
 #include "spu.h"
 #include "system.h"
@@ -1781,6 +1782,8 @@ void CDROM::StopReadingWithDataEnd()
 
 void CDROM::DoSectorRead()
 {
+  PERF_TIMER_SCOPE(CDROM);
+
   if (!m_reader.WaitForReadToComplete())
     Panic("Sector read failed");
 
@@ -1,41 +1,40 @@
 #include "cheats.h"
 #include "bus.h"
 #include "common/assert.h"
+#include "common/bitutils.h"
 #include "common/byte_stream.h"
+#include "common/cpu_detect.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/string.h"
 #include "common/string_util.h"
+#include "common/timer.h"
 #include "controller.h"
 #include "cpu_code_cache.h"
 #include "cpu_core.h"
 #include "host_interface.h"
 #include "system.h"
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstring>
 #include <iomanip>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 Log_SetChannel(Cheats);
 
-using KeyValuePairVector = std::vector<std::pair<std::string, std::string>>;
-
-static bool IsValidScanAddress(PhysicalMemoryAddress address)
-{
-  if ((address & CPU::DCACHE_LOCATION_MASK) == CPU::DCACHE_LOCATION &&
-      (address & CPU::DCACHE_OFFSET_MASK) < CPU::DCACHE_SIZE)
-  {
-    return true;
-  }
-
-  address &= CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
-
-  if (address < Bus::RAM_MIRROR_END)
-    return true;
-
-  if (address >= Bus::BIOS_BASE && address < (Bus::BIOS_BASE + Bus::BIOS_SIZE))
-    return true;
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
 
-  return false;
-}
+using KeyValuePairVector = std::vector<std::pair<std::string, std::string>>;
 
 template<typename T>
 static T DoMemoryRead(PhysicalMemoryAddress address)
@@ -87,6 +86,7 @@ static void DoMemoryWrite(PhysicalMemoryAddress address, T value)
     if (old_value != value)
     {
       std::memcpy(&Bus::g_ram[address & Bus::RAM_MASK], &value, sizeof(value));
+      Bus::MarkRAMPagesDirty(address, sizeof(value));
 
       const u32 code_page_index = Bus::GetRAMCodePageIndex(address & Bus::RAM_MASK);
       if (Bus::IsRAMCodePage(code_page_index))
@@ -138,6 +138,113 @@ static u32 GetControllerButtonBits()
   return translated_bits;
 }
 
+/// A cheat instruction with its address resolved to host memory, and its branch target resolved to an op index.
+struct CheatList::CompiledOp
+{
+  enum class Code : u8
+  {
+    Write8,
+    Write16,
+    Write32,
+    Or8,
+    Or16,
+    Or32,
+    And8,
+    And16,
+    And32,
+    Add8,
+    Add16,
+    Add32,
+    WriteIfEqual16,
+    ForceRange8,
+    ForceRange16,
+    MemoryCopy,
+
+    // Branches, these continue at target when the condition fails.
+    IfEqual8,
+    IfEqual16,
+    IfEqual32,
+    IfNotEqual8,
+    IfNotEqual16,
+    IfNotEqual32,
+    IfLess8,
+    IfLess16,
+    IfLess32,
+    IfGreater8,
+    IfGreater16,
+    IfGreater32,
+    IfButtonsEqual,
+    IfButtonsNotEqual,
+    IfDelayElapsed,
+    Jump
+  };
+
+  ALWAYS_INLINE bool IsBranch() const { return (code >= Code::IfEqual8); }
+
+  Code code;
+  bool ram;
+  u16 code_page;
+  PhysicalMemoryAddress address;
+  u32 value;
+  u32 value2;
+  u32 target;
+  u8* ptr;
+};
+
+// Reads from unmapped addresses return zero.
+static u8 s_unmapped_cheat_memory[sizeof(u32)] = {};
+
+/// Returns the memory DoMemoryRead()/DoMemoryWrite() would access, or null if the access has no effect.
+static u8* GetCheatMemoryPointer(PhysicalMemoryAddress address, bool write, bool* ram)
+{
+  *ram = false;
+  if ((address & CPU::DCACHE_LOCATION_MASK) == CPU::DCACHE_LOCATION &&
+      (address & CPU::DCACHE_OFFSET_MASK) < CPU::DCACHE_SIZE)
+  {
+    return &CPU::g_state.dcache[address & CPU::DCACHE_OFFSET_MASK];
+  }
+
+  address &= CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+
+  if (address < Bus::RAM_MIRROR_END)
+  {
+    *ram = true;
+    return &Bus::g_ram[address & Bus::RAM_MASK];
+  }
+
+  if (write)
+    return nullptr;
+
+  if (address >= Bus::BIOS_BASE && address < (Bus::BIOS_BASE + Bus::BIOS_SIZE))
+    return &Bus::g_bios[address & Bus::BIOS_MASK];
+
+  return s_unmapped_cheat_memory;
+}
+
+template<typename T, typename Op>
+ALWAYS_INLINE static T ReadCompiledOpMemory(const Op& op)
+{
+  T value;
+  std::memcpy(&value, op.ptr, sizeof(value));
+  return value;
+}
+
+template<typename T, typename Op>
+ALWAYS_INLINE static void WriteCompiledOpMemory(const Op& op, T value)
+{
+  // Same as DoMemoryWrite(), only invalidate code when it changes.
+  if (ReadCompiledOpMemory<T>(op) == value)
+    return;
+
+  std::memcpy(op.ptr, &value, sizeof(value));
+  if (op.ram)
+  {
+    Bus::MarkRAMPagesDirty(op.address & Bus::RAM_MASK, sizeof(value));
+    if (Bus::IsRAMCodePage(op.code_page))
+      CPU::CodeCache::InvalidateBlocksWithPageIndex(op.code_page);
+  }
+}
+
 CheatList::CheatList() = default;
 
 CheatList::~CheatList() = default;
@@ -278,6 +385,7 @@ bool CheatList::LoadFromPCSXRString(const std::string& str)
     m_codes.push_back(std::move(current_code));
   }
 
+  m_program_dirty = true;
   Log_InfoPrintf("Loaded %zu cheats (PCSXR format)", m_codes.size());
   return !m_codes.empty();
 }
@@ -381,6 +489,7 @@ bool CheatList::LoadFromLibretroString(const std::string& str)
       m_codes.push_back(std::move(cc));
   }
 
+  m_program_dirty = true;
   Log_InfoPrintf("Loaded %zu cheats (libretro format)", m_codes.size());
   return !m_codes.empty();
 }
@@ -431,18 +540,10 @@ bool CheatList::ParseLibretroCheat(CheatCode* cc, const char* line)
   return !cc->instructions.empty();
 }
 
-void CheatList::Apply()
-{
-  for (const CheatCode& code : m_codes)
-  {
-    if (code.enabled)
-      code.Apply();
-  }
-}
-
 void CheatList::AddCode(CheatCode cc)
 {
   m_codes.push_back(std::move(cc));
+  m_program_dirty = true;
 }
 
 void CheatList::SetCode(u32 index, CheatCode cc)
@@ -450,6 +551,7 @@ void CheatList::SetCode(u32 index, CheatCode cc)
   if (index > m_codes.size())
     return;
 
+  m_program_dirty = true;
   if (index == m_codes.size())
   {
     m_codes.push_back(std::move(cc));
@@ -462,6 +564,7 @@ void CheatList::SetCode(u32 index, CheatCode cc)
 void CheatList::RemoveCode(u32 i)
 {
   m_codes.erase(m_codes.begin() + i);
+  m_program_dirty = true;
 }
 
 std::optional<CheatList::Format> CheatList::DetectFileFormat(const char* filename)
@@ -658,6 +761,7 @@ bool CheatList::LoadFromPackage(const std::string& game_code)
     if (current_code.Valid())
       m_codes.push_back(std::move(current_code));
 
+    m_program_dirty = true;
     Log_InfoPrintf("Loaded %zu codes from package for %s", m_codes.size(), game_code.c_str());
     return !m_codes.empty();
   }
@@ -698,6 +802,7 @@ void CheatList::SetCodeEnabled(u32 index, bool state)
     return;
 
   m_codes[index].enabled = state;
+  m_program_dirty = true;
   if (!state)
     m_codes[index].ApplyOnDisable();
 }
@@ -1424,287 +1529,1386 @@ void CheatCode::ApplyOnDisable() const
   }
 }
 
-static std::array<const char*, 1> s_cheat_code_type_names = {{"Gameshark"}};
-static std::array<const char*, 1> s_cheat_code_type_display_names{{TRANSLATABLE("Cheats", "Gameshark")}};
-
-const char* CheatCode::GetTypeName(Type type)
+void CheatList::Apply()
 {
-  return s_cheat_code_type_names[static_cast<u32>(type)];
-}
+  if (m_program_dirty || m_program_ram != Bus::g_ram)
+    CompileProgram();
 
-const char* CheatCode::GetTypeDisplayName(Type type)
-{
-  return s_cheat_code_type_display_names[static_cast<u32>(type)];
-}
+  using Code = CompiledOp::Code;
 
-std::optional<CheatCode::Type> CheatCode::ParseTypeName(const char* str)
-{
-  for (u32 i = 0; i < static_cast<u32>(s_cheat_code_type_names.size()); i++)
+  const CompiledOp* ops = m_program.data();
+  const u32 num_ops = static_cast<u32>(m_program.size());
+  std::optional<u32> button_bits;
+  for (u32 pc = 0; pc < num_ops;)
   {
-    if (std::strcmp(s_cheat_code_type_names[i], str) == 0)
-      return static_cast<Type>(i);
-  }
+    const CompiledOp& op = ops[pc];
+    switch (op.code)
+    {
+      case Code::Write8:
+        WriteCompiledOpMemory<u8>(op, Truncate8(op.value));
+        pc++;
+        break;
 
-  return std::nullopt;
-}
+      case Code::Write16:
+        WriteCompiledOpMemory<u16>(op, Truncate16(op.value));
+        pc++;
+        break;
 
-static std::array<const char*, 2> s_cheat_code_activation_names = {{"Manual", "EndFrame"}};
-static std::array<const char*, 2> s_cheat_code_activation_display_names{
-  {TRANSLATABLE("Cheats", "Manual"), TRANSLATABLE("Cheats", "Automatic (Frame End)")}};
+      case Code::Write32:
+        WriteCompiledOpMemory<u32>(op, op.value);
+        pc++;
+        break;
 
-const char* CheatCode::GetActivationName(Activation activation)
-{
-  return s_cheat_code_activation_names[static_cast<u32>(activation)];
-}
+      case Code::Or8:
+        WriteCompiledOpMemory<u8>(op, ReadCompiledOpMemory<u8>(op) | Truncate8(op.value));
+        pc++;
+        break;
 
-const char* CheatCode::GetActivationDisplayName(Activation activation)
-{
-  return s_cheat_code_activation_display_names[static_cast<u32>(activation)];
-}
+      case Code::Or16:
+        WriteCompiledOpMemory<u16>(op, ReadCompiledOpMemory<u16>(op) | Truncate16(op.value));
+        pc++;
+        break;
 
-std::optional<CheatCode::Activation> CheatCode::ParseActivationName(const char* str)
-{
-  for (u32 i = 0; i < static_cast<u32>(s_cheat_code_activation_names.size()); i++)
-  {
-    if (std::strcmp(s_cheat_code_activation_names[i], str) == 0)
-      return static_cast<Activation>(i);
-  }
+      case Code::Or32:
+        WriteCompiledOpMemory<u32>(op, ReadCompiledOpMemory<u32>(op) | op.value);
+        pc++;
+        break;
 
-  return std::nullopt;
-}
+      case Code::And8:
+        WriteCompiledOpMemory<u8>(op, ReadCompiledOpMemory<u8>(op) & Truncate8(op.value));
+        pc++;
+        break;
 
-MemoryScan::MemoryScan() = default;
+      case Code::And16:
+        WriteCompiledOpMemory<u16>(op, ReadCompiledOpMemory<u16>(op) & Truncate16(op.value));
+        pc++;
+        break;
 
-MemoryScan::~MemoryScan() = default;
+      case Code::And32:
+        WriteCompiledOpMemory<u32>(op, ReadCompiledOpMemory<u32>(op) & op.value);
+        pc++;
+        break;
 
-void MemoryScan::ResetSearch()
-{
-  m_results.clear();
-}
+      case Code::Add8:
+        WriteCompiledOpMemory<u8>(op, Truncate8(ReadCompiledOpMemory<u8>(op) + op.value));
+        pc++;
+        break;
 
-void MemoryScan::Search()
-{
-  m_results.clear();
+      case Code::Add16:
+        WriteCompiledOpMemory<u16>(op, Truncate16(ReadCompiledOpMemory<u16>(op) + op.value));
+        pc++;
+        break;
 
-  switch (m_size)
-  {
-    case MemoryAccessSize::Byte:
-      SearchBytes();
+      case Code::Add32:
+        WriteCompiledOpMemory<u32>(op, ReadCompiledOpMemory<u32>(op) + op.value);
+        pc++;
+        break;
+
+      case Code::WriteIfEqual16:
+      {
+        if (ReadCompiledOpMemory<u16>(op) == Truncate16(op.value))
+          WriteCompiledOpMemory<u16>(op, Truncate16(op.value2));
+        pc++;
+      }
       break;
 
-    case MemoryAccessSize::HalfWord:
-      SearchHalfwords();
+      case Code::ForceRange8:
+      {
+        const u8 value = ReadCompiledOpMemory<u8>(op);
+        if (value < Truncate8(op.value))
+          WriteCompiledOpMemory<u8>(op, Truncate8(op.value2));
+        else if (value > Truncate8(op.value >> 16))
+          WriteCompiledOpMemory<u8>(op, Truncate8(op.value2 >> 16));
+        pc++;
+      }
       break;
 
-    case MemoryAccessSize::Word:
-      SearchWords();
+      case Code::ForceRange16:
+      {
+        const u16 value = ReadCompiledOpMemory<u16>(op);
+        if (value < Truncate16(op.value))
+          WriteCompiledOpMemory<u16>(op, Truncate16(op.value2));
+        else if (value > Truncate16(op.value >> 16))
+          WriteCompiledOpMemory<u16>(op, Truncate16(op.value2 >> 16));
+        pc++;
+      }
       break;
 
-    default:
+      case Code::MemoryCopy:
+      {
+        u32 src_address = op.address;
+        u32 dst_address = op.value2;
+        for (u32 i = 0; i < op.value; i++)
+          DoMemoryWrite<u8>(dst_address++, DoMemoryRead<u8>(src_address++));
+        pc++;
+      }
       break;
-  }
-}
 
-void MemoryScan::SearchBytes()
-{
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address++)
-  {
-    if (!IsValidScanAddress(address))
-      continue;
+      case Code::IfEqual8:
+        pc = (ReadCompiledOpMemory<u8>(op) == Truncate8(op.value)) ? (pc + 1) : op.target;
+        break;
 
-    const u8 bvalue = DoMemoryRead<u8>(address);
+      case Code::IfEqual16:
+        pc = (ReadCompiledOpMemory<u16>(op) == Truncate16(op.value)) ? (pc + 1) : op.target;
+        break;
 
-    Result res;
-    res.address = address;
-    res.value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
-    res.last_value = res.value;
-    res.value_changed = false;
+      case Code::IfEqual32:
+        pc = (ReadCompiledOpMemory<u32>(op) == op.value) ? (pc + 1) : op.target;
+        break;
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
-  }
-}
+      case Code::IfNotEqual8:
+        pc = (ReadCompiledOpMemory<u8>(op) != Truncate8(op.value)) ? (pc + 1) : op.target;
+        break;
 
-void MemoryScan::SearchHalfwords()
-{
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address += 2)
-  {
-    if (!IsValidScanAddress(address))
-      continue;
+      case Code::IfNotEqual16:
+        pc = (ReadCompiledOpMemory<u16>(op) != Truncate16(op.value)) ? (pc + 1) : op.target;
+        break;
 
-    const u16 bvalue = DoMemoryRead<u16>(address);
+      case Code::IfNotEqual32:
+        pc = (ReadCompiledOpMemory<u32>(op) != op.value) ? (pc + 1) : op.target;
+        break;
 
-    Result res;
-    res.address = address;
-    res.value = m_signed ? SignExtend32(bvalue) : ZeroExtend32(bvalue);
-    res.last_value = res.value;
-    res.value_changed = false;
+      case Code::IfLess8:
+        pc = (ReadCompiledOpMemory<u8>(op) < Truncate8(op.value)) ? (pc + 1) : op.target;
+        break;
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
-  }
-}
+      case Code::IfLess16:
+        pc = (ReadCompiledOpMemory<u16>(op) < Truncate16(op.value)) ? (pc + 1) : op.target;
+        break;
 
-void MemoryScan::SearchWords()
-{
-  for (PhysicalMemoryAddress address = m_start_address; address < m_end_address; address += 4)
-  {
-    if (!IsValidScanAddress(address))
-      continue;
+      case Code::IfLess32:
+        pc = (ReadCompiledOpMemory<u32>(op) < op.value) ? (pc + 1) : op.target;
+        break;
 
-    Result res;
-    res.address = address;
-    res.value = DoMemoryRead<u32>(address);
-    res.last_value = res.value;
-    res.value_changed = false;
+      case Code::IfGreater8:
+        pc = (ReadCompiledOpMemory<u8>(op) > Truncate8(op.value)) ? (pc + 1) : op.target;
+        break;
 
-    if (res.Filter(m_operator, m_value, m_signed))
-      m_results.push_back(res);
-  }
-}
+      case Code::IfGreater16:
+        pc = (ReadCompiledOpMemory<u16>(op) > Truncate16(op.value)) ? (pc + 1) : op.target;
+        break;
 
-void MemoryScan::SearchAgain()
-{
-  ResultVector new_results;
-  new_results.reserve(m_results.size());
-  for (Result& res : m_results)
-  {
-    res.UpdateValue(m_size, m_signed);
+      case Code::IfGreater32:
+        pc = (ReadCompiledOpMemory<u32>(op) > op.value) ? (pc + 1) : op.target;
+        break;
 
-    if (res.Filter(m_operator, m_value, m_signed))
-    {
-      res.last_value = res.value;
-      new_results.push_back(res);
-    }
-  }
+      case Code::IfButtonsEqual:
+      case Code::IfButtonsNotEqual:
+      {
+        // Controllers don't change while the codes run, so only read them once.
+        if (!button_bits.has_value())
+          button_bits = GetControllerButtonBits();
 
-  m_results.swap(new_results);
-}
+        const bool equal = (button_bits.value() == op.value);
+        pc = (equal == (op.code == Code::IfButtonsEqual)) ? (pc + 1) : op.target;
+      }
+      break;
 
-void MemoryScan::UpdateResultsValues()
-{
-  for (Result& res : m_results)
-    res.UpdateValue(m_size, m_signed);
+      case Code::IfDelayElapsed:
+        pc = (((System::GetFrameNumber() * 10) / 3) >= op.value) ? (pc + 1) : op.target;
+        break;
+
+      case Code::Jump:
+      default:
+        pc = op.target;
+        break;
+    }
+  }
 }
 
-void MemoryScan::SetResultValue(u32 index, u32 value)
+void CheatList::CompileProgram()
 {
-  if (index >= m_results.size())
-    return;
-
-  Result& res = m_results[index];
-  if (res.value == value)
-    return;
+  Common::Timer timer;
 
-  switch (m_size)
+  m_program.clear();
+  for (const CheatCode& cc : m_codes)
   {
-    case MemoryAccessSize::Byte:
-      DoMemoryWrite<u8>(res.address, Truncate8(value));
-      break;
-
-    case MemoryAccessSize::HalfWord:
-      DoMemoryWrite<u16>(res.address, Truncate16(value));
-      break;
-
-    case MemoryAccessSize::Word:
-      CPU::SafeWriteMemoryWord(res.address, value);
-      break;
+    if (cc.enabled)
+      CompileCode(cc, &m_program);
   }
 
-  res.value = value;
-  res.value_changed = true;
+  m_program_ram = Bus::g_ram;
+  m_program_dirty = false;
+
+  Log_DevPrintf("Compiled %u cheat codes to %zu ops in %.2f ms", GetEnabledCodeCount(), m_program.size(),
+                timer.GetTimeMilliseconds());
 }
 
-bool MemoryScan::Result::Filter(Operator op, u32 comp_value, bool is_signed) const
+void CheatList::CompileCode(const CheatCode& cc, std::vector<CompiledOp>* program)
 {
-  switch (op)
-  {
-    case Operator::Equal:
-    {
-      return (value == comp_value);
-    }
+  using InstructionCode = CheatCode::InstructionCode;
+  using Code = CompiledOp::Code;
 
-    case Operator::NotEqual:
-    {
-      return (value != comp_value);
-    }
+  // Instructions are compiled on their own first, with branch targets as instruction indices. Failed conditions can
+  // continue partway through a two-word instruction, so the layout can't be decided until all targets are known.
+  struct CompiledInstruction
+  {
+    u32 first_op;
+    u32 num_ops;
+    u32 next;
+    u32 fail;
+  };
+
+  const u32 count = static_cast<u32>(cc.instructions.size());
+  std::vector<CompiledInstruction> compiled(count);
+  std::vector<CompiledOp> ops;
+
+  auto add_op = [&ops](Code code, PhysicalMemoryAddress address, bool write, u32 value, u32 value2 = 0) {
+    bool ram;
+    u8* ptr = GetCheatMemoryPointer(address, write, &ram);
+    if (!ptr)
+      return;
+
+    CompiledOp op = {};
+    op.code = code;
+    op.ram = ram;
+    op.code_page = static_cast<u16>(Bus::GetRAMCodePageIndex(address));
+    op.address = address;
+    op.value = value;
+    op.value2 = value2;
+    op.ptr = ptr;
+    ops.push_back(op);
+  };
+
+  for (u32 index = 0; index < count; index++)
+  {
+    const CheatCode::Instruction& inst = cc.instructions[index];
+    CompiledInstruction& ci = compiled[index];
+    ci.first_op = static_cast<u32>(ops.size());
+    ci.next = index + 1;
+    ci.fail = ci.next;
+
+    auto add_branch = [&](Code code, PhysicalMemoryAddress address, u32 value, u32 fail) {
+      if (fail == ci.next)
+        return;
+
+      add_op(code, address, false, value);
+      ops.back().target = fail;
+      ci.fail = fail;
+    };
+
+    auto skip_to_separator = [&cc, count](u32 start) {
+      // skip to the next separator (00000000 FFFF), or end
+      constexpr u64 separator_value = UINT64_C(0x000000000000FFFF);
+      while (start < count)
+      {
+        if (cc.instructions[start++].bits == separator_value)
+          break;
+      }
+      return start;
+    };
 
-    case Operator::GreaterThan:
+    switch (inst.code)
     {
-      return is_signed ? (static_cast<s32>(value) > static_cast<s32>(comp_value)) : (value > comp_value);
-    }
+      case InstructionCode::Nop:
+        break;
 
-    case Operator::GreaterEqual:
-    {
-      return is_signed ? (static_cast<s32>(value) >= static_cast<s32>(comp_value)) : (value >= comp_value);
-    }
+      case InstructionCode::ConstantWrite8:
+        add_op(Code::Write8, inst.address, true, inst.value8);
+        break;
 
-    case Operator::LessThan:
-    {
-      return is_signed ? (static_cast<s32>(value) < static_cast<s32>(comp_value)) : (value < comp_value);
-    }
+      case InstructionCode::ConstantWrite16:
+        add_op(Code::Write16, inst.address, true, inst.value16);
+        break;
 
-    case Operator::LessEqual:
-    {
-      return is_signed ? (static_cast<s32>(value) <= static_cast<s32>(comp_value)) : (value <= comp_value);
-    }
+      case InstructionCode::ExtConstantWrite32:
+        add_op(Code::Write32, inst.address, true, inst.value32);
+        break;
 
-    case Operator::IncreasedBy:
-    {
-      return is_signed ? ((static_cast<s32>(value) - static_cast<s32>(last_value)) == static_cast<s32>(comp_value)) :
-                         ((value - last_value) == comp_value);
-    }
+      case InstructionCode::ExtConstantBitSet8:
+        add_op(Code::Or8, inst.address, true, inst.value8);
+        break;
 
-    case Operator::DecreasedBy:
-    {
-      return is_signed ? ((static_cast<s32>(last_value) - static_cast<s32>(value)) == static_cast<s32>(comp_value)) :
-                         ((last_value - value) == comp_value);
-    }
+      case InstructionCode::ExtConstantBitSet16:
+        add_op(Code::Or16, inst.address, true, inst.value16);
+        break;
 
-    case Operator::ChangedBy:
-    {
-      if (is_signed)
-        return (std::abs(static_cast<s32>(last_value) - static_cast<s32>(value)) == static_cast<s32>(comp_value));
-      else
-        return ((last_value > value) ? (last_value - value) : (value - last_value)) == comp_value;
-    }
+      case InstructionCode::ExtConstantBitSet32:
+        add_op(Code::Or32, inst.address, true, inst.value32);
+        break;
 
-    case Operator::EqualLast:
-    {
-      return (value == last_value);
-    }
+      case InstructionCode::ExtConstantBitClear8:
+        add_op(Code::And8, inst.address, true, ~inst.value8);
+        break;
 
-    case Operator::NotEqualLast:
-    {
-      return (value != last_value);
-    }
+      case InstructionCode::ExtConstantBitClear16:
+        add_op(Code::And16, inst.address, true, ~inst.value16);
+        break;
+
+      case InstructionCode::ExtConstantBitClear32:
+        add_op(Code::And32, inst.address, true, ~inst.value32);
+        break;
+
+      case InstructionCode::ScratchpadWrite16:
+        add_op(Code::Write16, CPU::DCACHE_LOCATION | (inst.address & CPU::DCACHE_OFFSET_MASK), true, inst.value16);
+        break;
+
+      case InstructionCode::ExtScratchpadWrite32:
+        add_op(Code::Write32, CPU::DCACHE_LOCATION | (inst.address & CPU::DCACHE_OFFSET_MASK), true, inst.value32);
+        break;
+
+      case InstructionCode::ExtIncrement32:
+        add_op(Code::Add32, inst.address, true, inst.value32);
+        break;
+
+      case InstructionCode::ExtDecrement32:
+        add_op(Code::Add32, inst.address, true, 0u - inst.value32);
+        break;
+
+      case InstructionCode::Increment16:
+        add_op(Code::Add16, inst.address, true, inst.value16);
+        break;
+
+      case InstructionCode::Decrement16:
+        add_op(Code::Add16, inst.address, true, 0u - inst.value16);
+        break;
+
+      case InstructionCode::Increment8:
+        add_op(Code::Add8, inst.address, true, inst.value8);
+        break;
+
+      case InstructionCode::Decrement8:
+        add_op(Code::Add8, inst.address, true, 0u - inst.value8);
+        break;
+
+      case InstructionCode::ExtCompareEqual32:
+        add_branch(Code::IfEqual32, inst.address, inst.value32, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::ExtCompareNotEqual32:
+        add_branch(Code::IfNotEqual32, inst.address, inst.value32, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::ExtCompareLess32:
+        add_branch(Code::IfLess32, inst.address, inst.value32, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::ExtCompareGreater32:
+        add_branch(Code::IfGreater32, inst.address, inst.value32, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::ExtConstantWriteIfMatch16:
+      case InstructionCode::ExtConstantWriteIfMatchWithRestore16:
+        add_op(Code::WriteIfEqual16, inst.address, true, inst.value32 >> 16, inst.value32 & 0xFFFFu);
+        break;
+
+      // Range ops hold the limits and the values written outside them as low/high halves.
+      case InstructionCode::ExtConstantForceRange8:
+      {
+        const u32 limits = (inst.value32 & 0xFFu) | ((inst.value32 & 0xFF00u) << 8);
+        const u32 values = ((inst.value32 >> 16) & 0xFFu) | ((inst.value32 >> 8) & 0xFF0000u);
+        add_op(Code::ForceRange8, inst.address, true, limits, values);
+      }
+      break;
+
+      case InstructionCode::ExtConstantForceRangeLimits16:
+        add_op(Code::ForceRange16, inst.address, true, inst.value32, inst.value32);
+        break;
+
+      case InstructionCode::ExtConstantForceRangeRollRound16:
+        add_op(Code::ForceRange16, inst.address, true, inst.value32, (inst.value32 >> 16) | (inst.value32 << 16));
+        break;
+
+      case InstructionCode::ExtConstantForceRange16:
+      {
+        if ((index + 1) >= count)
+        {
+          Log_ErrorPrintf("Incomplete force range instruction");
+          ci.next = count;
+          break;
+        }
+
+        add_op(Code::ForceRange16, inst.address, true, inst.value32, cc.instructions[index + 1].value32);
+        ci.next = index + 2;
+      }
+      break;
+
+      case InstructionCode::CompareEqual16:
+        add_branch(Code::IfEqual16, inst.address, inst.value16, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareNotEqual16:
+        add_branch(Code::IfNotEqual16, inst.address, inst.value16, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareLess16:
+        add_branch(Code::IfLess16, inst.address, inst.value16, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareGreater16:
+        add_branch(Code::IfGreater16, inst.address, inst.value16, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareEqual8:
+        add_branch(Code::IfEqual8, inst.address, inst.value8, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareNotEqual8:
+        add_branch(Code::IfNotEqual8, inst.address, inst.value8, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareLess8:
+        add_branch(Code::IfLess8, inst.address, inst.value8, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareGreater8:
+        add_branch(Code::IfGreater8, inst.address, inst.value8, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::CompareButtons: // D4
+        add_branch(Code::IfButtonsEqual, 0, inst.value16, cc.GetNextNonConditionalInstruction(index));
+        break;
+
+      case InstructionCode::SkipIfNotEqual16: // C0
+        add_branch(Code::IfEqual16, inst.address, inst.value16, skip_to_separator(index + 1));
+        break;
+
+      case InstructionCode::ExtSkipIfNotEqual32: // A4
+        add_branch(Code::IfEqual32, inst.address, inst.value32, skip_to_separator(index + 1));
+        break;
+
+      case InstructionCode::SkipIfButtonsNotEqual: // D5
+        add_branch(Code::IfButtonsEqual, 0, inst.value16, skip_to_separator(index + 1));
+        break;
+
+      case InstructionCode::SkipIfButtonsEqual: // D6
+        add_branch(Code::IfButtonsNotEqual, 0, inst.value16, skip_to_separator(index + 1));
+        break;
+
+      case InstructionCode::DelayActivation: // C1
+        // A value of around 4000 or 5000 will usually give you a good 20-30 second delay before codes are activated.
+        // Frame number * 0.3 -> (20 * 60) * 10 / 3 => 4000
+        add_branch(Code::IfDelayElapsed, 0, inst.value16, count);
+        break;
+
+      case InstructionCode::Slide:
+      {
+        if ((index + 1) >= count)
+        {
+          Log_ErrorPrintf("Incomplete slide instruction");
+          ci.next = count;
+          break;
+        }
+
+        // The addresses are fixed, so unroll it into plain writes.
+        const u32 slide_count = (inst.first >> 8) & 0xFFu;
+        const u32 address_increment = inst.first & 0xFFu;
+        const u16 value_increment = Truncate16(inst.second);
+        const CheatCode::Instruction& inst2 = cc.instructions[index + 1];
+        const InstructionCode write_type = inst2.code;
+        u32 address = inst2.address;
+        u16 value = inst2.value16;
+
+        if (write_type == InstructionCode::ConstantWrite8 || write_type == InstructionCode::ConstantWrite16)
+        {
+          const Code code = (write_type == InstructionCode::ConstantWrite8) ? Code::Write8 : Code::Write16;
+          const u32 mask = (write_type == InstructionCode::ConstantWrite8) ? 0xFFu : 0xFFFFu;
+          for (u32 i = 0; i < slide_count; i++)
+          {
+            add_op(code, address, true, value & mask);
+            address += address_increment;
+            value += value_increment;
+          }
+        }
+        else
+        {
+          Log_ErrorPrintf("Invalid command in second slide parameter 0x%02X", write_type);
+        }
+
+        ci.next = index + 2;
+      }
+      break;
+
+      case InstructionCode::MemoryCopy:
+      {
+        if ((index + 1) >= count)
+        {
+          Log_ErrorPrintf("Incomplete memory copy instruction");
+          ci.next = count;
+          break;
+        }
+
+        // Copies can span regions, so these still go through DoMemoryRead()/DoMemoryWrite().
+        CompiledOp op = {};
+        op.code = Code::MemoryCopy;
+        op.address = inst.address;
+        op.value = inst.value16;
+        op.value2 = cc.instructions[index + 1].address;
+        if (op.value > 0)
+          ops.push_back(op);
+
+        ci.next = index + 2;
+      }
+      break;
+
+      default:
+      {
+        Log_ErrorPrintf("Unhandled instruction code 0x%02X (%08X %08X)", static_cast<u8>(inst.code.GetValue()),
+                        inst.first, inst.second);
+      }
+      break;
+    }
+
+    ci.num_ops = static_cast<u32>(ops.size()) - ci.first_op;
+  }
+
+  // Only lay out instructions which can run, skipping over the second words of two-word instructions.
+  std::vector<bool> reachable(count, false);
+  std::vector<u32> pending;
+  pending.push_back(0);
+  while (!pending.empty())
+  {
+    const u32 index = pending.back();
+    pending.pop_back();
+    if (index >= count || reachable[index])
+      continue;
+
+    reachable[index] = true;
+    pending.push_back(compiled[index].next);
+    pending.push_back(compiled[index].fail);
+  }
+
+  const u32 first_op = static_cast<u32>(program->size());
+  std::vector<u32> op_indices(count + 1);
+  for (u32 index = 0; index < count; index++)
+  {
+    if (!reachable[index])
+      continue;
+
+    const CompiledInstruction& ci = compiled[index];
+    op_indices[index] = static_cast<u32>(program->size());
+    program->insert(program->end(), ops.begin() + ci.first_op, ops.begin() + ci.first_op + ci.num_ops);
+
+    u32 next_laid_out = index + 1;
+    while (next_laid_out < count && !reachable[next_laid_out])
+      next_laid_out++;
+
+    if (ci.next != next_laid_out)
+    {
+      CompiledOp op = {};
+      op.code = Code::Jump;
+      op.target = ci.next;
+      program->push_back(op);
+    }
+  }
+
+  op_indices[count] = static_cast<u32>(program->size());
+  for (u32 i = first_op; i < static_cast<u32>(program->size()); i++)
+  {
+    CompiledOp& op = (*program)[i];
+    if (op.IsBranch())
+      op.target = op_indices[op.target];
+  }
+}
+
+static std::array<const char*, 1> s_cheat_code_type_names = {{"Gameshark"}};
+static std::array<const char*, 1> s_cheat_code_type_display_names{{TRANSLATABLE("Cheats", "Gameshark")}};
+
+const char* CheatCode::GetTypeName(Type type)
+{
+  return s_cheat_code_type_names[static_cast<u32>(type)];
+}
+
+const char* CheatCode::GetTypeDisplayName(Type type)
+{
+  return s_cheat_code_type_display_names[static_cast<u32>(type)];
+}
+
+std::optional<CheatCode::Type> CheatCode::ParseTypeName(const char* str)
+{
+  for (u32 i = 0; i < static_cast<u32>(s_cheat_code_type_names.size()); i++)
+  {
+    if (std::strcmp(s_cheat_code_type_names[i], str) == 0)
+      return static_cast<Type>(i);
+  }
+
+  return std::nullopt;
+}
+
+static std::array<const char*, 2> s_cheat_code_activation_names = {{"Manual", "EndFrame"}};
+static std::array<const char*, 2> s_cheat_code_activation_display_names{
+  {TRANSLATABLE("Cheats", "Manual"), TRANSLATABLE("Cheats", "Automatic (Frame End)")}};
+
+const char* CheatCode::GetActivationName(Activation activation)
+{
+  return s_cheat_code_activation_names[static_cast<u32>(activation)];
+}
+
+const char* CheatCode::GetActivationDisplayName(Activation activation)
+{
+  return s_cheat_code_activation_display_names[static_cast<u32>(activation)];
+}
+
+std::optional<CheatCode::Activation> CheatCode::ParseActivationName(const char* str)
+{
+  for (u32 i = 0; i < static_cast<u32>(s_cheat_code_activation_names.size()); i++)
+  {
+    if (std::strcmp(s_cheat_code_activation_names[i], str) == 0)
+      return static_cast<Activation>(i);
+  }
+
+  return std::nullopt;
+}
+
+MemoryScan::MemoryScan() = default;
+
+MemoryScan::~MemoryScan() = default;
+
+namespace {
+
+// Search snapshots hold one copy of each memory region, mirrors share it.
+enum : u32
+{
+  SNAPSHOT_RAM_OFFSET = 0,
+  SNAPSHOT_BIOS_OFFSET = SNAPSHOT_RAM_OFFSET + Bus::RAM_SIZE,
+  SNAPSHOT_DCACHE_OFFSET = SNAPSHOT_BIOS_OFFSET + Bus::BIOS_SIZE,
+  SNAPSHOT_SIZE = SNAPSHOT_DCACHE_OFFSET + CPU::DCACHE_SIZE
+};
+
+/// A search operator reduced to a compare on the raw values. Unsigned values are XORed with the sign bit first, so
+/// signed compares give the unsigned order, and one set of compares handles both.
+struct ScanFilter
+{
+  enum class Type : u8
+  {
+    None,
+    All,
+    Range,
+    Compare,
+    Difference
+  };
+
+  enum class Condition : u8
+  {
+    None,
+    GreaterEqual,
+    Less
+  };
+
+  /// (a - b) == value in the element size, where a is the current value, or the last value when swapped.
+  struct Term
+  {
+    u32 value;
+    bool swap;
+    Condition condition;
+  };
+
+  Type type = Type::None;
+  bool invert = false;
+  bool swap = false;
+  bool equal = false;
+  u32 bias = 0;
+  u32 low = 0;
+  u32 high = 0;
+  u32 num_terms = 0;
+  std::array<Term, 2> terms = {};
+};
+
+} // namespace
+
+static void SetScanFilterRange(ScanFilter* filter, s64 low, s64 high, s64 min_value, s64 max_value, bool invert)
+{
+  low = std::max(low, min_value);
+  high = std::min(high, max_value);
+  if (low > high)
+  {
+    filter->type = invert ? ScanFilter::Type::All : ScanFilter::Type::None;
+    return;
+  }
+
+  filter->type = ScanFilter::Type::Range;
+  filter->low = static_cast<u32>(low) ^ filter->bias;
+  filter->high = static_cast<u32>(high) ^ filter->bias;
+  filter->invert = invert;
+}
+
+static void AddScanFilterTerm(ScanFilter* filter, bool swap, u32 value, ScanFilter::Condition condition)
+{
+  filter->type = ScanFilter::Type::Difference;
+  filter->terms[filter->num_terms++] = ScanFilter::Term{value, swap, condition};
+}
+
+/// Matches the results of comparing sign/zero-extended 32-bit values.
+static ScanFilter BuildScanFilter(MemoryScan::Operator op, u32 comp_value, bool is_signed, MemoryAccessSize size)
+{
+  using Operator = MemoryScan::Operator;
+
+  const u32 bits = 8u << static_cast<u32>(size);
+  const s64 range = (INT64_C(1) << bits) - 1;
+  const s64 min_value = is_signed ? -(INT64_C(1) << (bits - 1)) : 0;
+  const s64 max_value = min_value + range;
+  const s64 comp = is_signed ? static_cast<s64>(static_cast<s32>(comp_value)) : static_cast<s64>(comp_value);
+
+  ScanFilter filter;
+  filter.bias = is_signed ? 0u : (1u << (bits - 1));
+
+  switch (op)
+  {
+    case Operator::Equal:
+    case Operator::NotEqual:
+      SetScanFilterRange(&filter, comp, comp, min_value, max_value, op == Operator::NotEqual);
+      break;
+
+    case Operator::GreaterThan:
+      SetScanFilterRange(&filter, comp + 1, max_value, min_value, max_value, false);
+      break;
+
+    case Operator::GreaterEqual:
+      SetScanFilterRange(&filter, comp, max_value, min_value, max_value, false);
+      break;
+
+    case Operator::LessThan:
+      SetScanFilterRange(&filter, min_value, comp - 1, min_value, max_value, false);
+      break;
+
+    case Operator::LessEqual:
+      SetScanFilterRange(&filter, min_value, comp, min_value, max_value, false);
+      break;
+
+    case Operator::IncreasedBy:
+    case Operator::DecreasedBy:
+    {
+      const bool swap = (op == Operator::DecreasedBy);
+      if (bits == 32)
+      {
+        // Both signed and unsigned differences wrap.
+        AddScanFilterTerm(&filter, swap, comp_value, ScanFilter::Condition::None);
+      }
+      else
+      {
+        // Differences of extended values are exact, so the wrapped difference also needs the right sign.
+        s64 diff = comp;
+        if (!is_signed && diff > range)
+          diff -= INT64_C(1) << 32;
+        if (diff >= -range && diff <= range)
+        {
+          AddScanFilterTerm(&filter, swap, static_cast<u32>(diff),
+                            (diff >= 0) ? ScanFilter::Condition::GreaterEqual : ScanFilter::Condition::Less);
+        }
+      }
+    }
+    break;
+
+    case Operator::ChangedBy:
+    {
+      if (is_signed && bits == 32)
+      {
+        // abs() of a wrapped difference, which can only be negative for INT_MIN.
+        if (comp >= 0 || comp == std::numeric_limits<s32>::min())
+        {
+          AddScanFilterTerm(&filter, false, comp_value, ScanFilter::Condition::None);
+          AddScanFilterTerm(&filter, true, comp_value, ScanFilter::Condition::None);
+        }
+      }
+      else if (comp >= 0 && comp <= range)
+      {
+        AddScanFilterTerm(&filter, false, comp_value, ScanFilter::Condition::GreaterEqual);
+        AddScanFilterTerm(&filter, true, comp_value, ScanFilter::Condition::GreaterEqual);
+      }
+    }
+    break;
+
+    case Operator::EqualLast:
+    case Operator::NotEqualLast:
+      filter.type = ScanFilter::Type::Compare;
+      filter.equal = true;
+      filter.invert = (op == Operator::NotEqualLast);
+      break;
 
     case Operator::GreaterThanLast:
+    case Operator::LessEqualLast:
+      filter.type = ScanFilter::Type::Compare;
+      filter.invert = (op == Operator::LessEqualLast);
+      break;
+
+    case Operator::LessThanLast:
+    case Operator::GreaterEqualLast:
+      filter.type = ScanFilter::Type::Compare;
+      filter.swap = true;
+      filter.invert = (op == Operator::GreaterEqualLast);
+      break;
+
+    case Operator::Any:
+      filter.type = ScanFilter::Type::All;
+      break;
+
+    default:
+      break;
+  }
+
+  return filter;
+}
+
+#if defined(CPU_X64)
+
+using ScanVector = __m128i;
+
+template<typename T>
+static constexpr u32 SCAN_VECTOR_LANES = sizeof(ScanVector) / sizeof(T);
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorLoad(const u8* ptr)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorSplat(u32 value)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return _mm_set1_epi8(static_cast<s8>(value));
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return _mm_set1_epi16(static_cast<s16>(value));
+  else
+    return _mm_set1_epi32(static_cast<s32>(value));
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorSub(ScanVector a, ScanVector b)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return _mm_sub_epi8(a, b);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return _mm_sub_epi16(a, b);
+  else
+    return _mm_sub_epi32(a, b);
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorEqual(ScanVector a, ScanVector b)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return _mm_cmpeq_epi8(a, b);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return _mm_cmpeq_epi16(a, b);
+  else
+    return _mm_cmpeq_epi32(a, b);
+}
+
+/// Signed compare.
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorGreater(ScanVector a, ScanVector b)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return _mm_cmpgt_epi8(a, b);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return _mm_cmpgt_epi16(a, b);
+  else
+    return _mm_cmpgt_epi32(a, b);
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorAnd(ScanVector a, ScanVector b)
+{
+  return _mm_and_si128(a, b);
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorOr(ScanVector a, ScanVector b)
+{
+  return _mm_or_si128(a, b);
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorXor(ScanVector a, ScanVector b)
+{
+  return _mm_xor_si128(a, b);
+}
+
+/// One bit per lane.
+template<typename T>
+ALWAYS_INLINE static u32 ScanVectorMask(ScanVector mask)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return static_cast<u32>(_mm_movemask_epi8(mask));
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return static_cast<u32>(_mm_movemask_epi8(_mm_packs_epi16(mask, _mm_setzero_si128())));
+  else
+    return static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+}
+
+#elif defined(CPU_AARCH64)
+
+using ScanVector = uint8x16_t;
+
+template<typename T>
+static constexpr u32 SCAN_VECTOR_LANES = sizeof(ScanVector) / sizeof(T);
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorLoad(const u8* ptr)
+{
+  return vld1q_u8(ptr);
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorSplat(u32 value)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return vdupq_n_u8(static_cast<u8>(value));
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return vreinterpretq_u8_u16(vdupq_n_u16(static_cast<u16>(value)));
+  else
+    return vreinterpretq_u8_u32(vdupq_n_u32(value));
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorSub(ScanVector a, ScanVector b)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return vsubq_u8(a, b);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return vreinterpretq_u8_u16(vsubq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+  else
+    return vreinterpretq_u8_u32(vsubq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorEqual(ScanVector a, ScanVector b)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return vceqq_u8(a, b);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+  else
+    return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+}
+
+/// Signed compare.
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorGreater(ScanVector a, ScanVector b)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return vcgtq_s8(vreinterpretq_s8_u8(a), vreinterpretq_s8_u8(b));
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return vreinterpretq_u8_u16(vcgtq_s16(vreinterpretq_s16_u8(a), vreinterpretq_s16_u8(b)));
+  else
+    return vreinterpretq_u8_u32(vcgtq_s32(vreinterpretq_s32_u8(a), vreinterpretq_s32_u8(b)));
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorAnd(ScanVector a, ScanVector b)
+{
+  return vandq_u8(a, b);
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorOr(ScanVector a, ScanVector b)
+{
+  return vorrq_u8(a, b);
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorXor(ScanVector a, ScanVector b)
+{
+  return veorq_u8(a, b);
+}
+
+/// One bit per lane.
+template<typename T>
+ALWAYS_INLINE static u32 ScanVectorMask(ScanVector mask)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+  {
+    static constexpr u8 weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t bits = vandq_u8(mask, vld1q_u8(weights));
+    return ZeroExtend32(vaddv_u8(vget_low_u8(bits))) | (ZeroExtend32(vaddv_u8(vget_high_u8(bits))) << 8);
+  }
+  else if constexpr (sizeof(T) == sizeof(u16))
+  {
+    static constexpr u16 weights[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+    return ZeroExtend32(vaddvq_u16(vandq_u16(vreinterpretq_u16_u8(mask), vld1q_u16(weights))));
+  }
+  else
+  {
+    static constexpr u32 weights[4] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(vreinterpretq_u32_u8(mask), vld1q_u32(weights)));
+  }
+}
+
+#else
+
+// One element at a time, lanes are all-ones or zero in the element size like the vector versions.
+using ScanVector = u32;
+
+template<typename T>
+static constexpr u32 SCAN_VECTOR_LANES = 1;
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorLoad(const u8* ptr)
+{
+  T value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return static_cast<u32>(value);
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorSplat(u32 value)
+{
+  return static_cast<T>(value);
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorSub(ScanVector a, ScanVector b)
+{
+  return static_cast<T>(a - b);
+}
+
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorEqual(ScanVector a, ScanVector b)
+{
+  return (a == b) ? static_cast<T>(~0u) : 0u;
+}
+
+/// Signed compare.
+template<typename T>
+ALWAYS_INLINE static ScanVector ScanVectorGreater(ScanVector a, ScanVector b)
+{
+  using ST = std::make_signed_t<T>;
+  return (static_cast<ST>(a) > static_cast<ST>(b)) ? static_cast<T>(~0u) : 0u;
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorAnd(ScanVector a, ScanVector b)
+{
+  return a & b;
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorOr(ScanVector a, ScanVector b)
+{
+  return a | b;
+}
+
+ALWAYS_INLINE static ScanVector ScanVectorXor(ScanVector a, ScanVector b)
+{
+  return a ^ b;
+}
+
+template<typename T>
+ALWAYS_INLINE static u32 ScanVectorMask(ScanVector mask)
+{
+  return mask & 1u;
+}
+
+#endif
+
+/// Returns one bit for each of the 64 elements at current/last which passes the filter.
+template<typename T, ScanFilter::Type type>
+static u64 FilterScanChunk(const ScanFilter& filter, const u8* current, const u8* last)
+{
+  constexpr u32 lanes = SCAN_VECTOR_LANES<T>;
+  const ScanVector bias = ScanVectorSplat<T>(filter.bias);
+  const ScanVector ones = ScanVectorSplat<T>(~0u);
+  const ScanVector invert = ScanVectorSplat<T>(filter.invert ? ~0u : 0u);
+  const ScanVector low = ScanVectorSplat<T>(filter.low);
+  const ScanVector high = ScanVectorSplat<T>(filter.high);
+
+  u64 bits = 0;
+  for (u32 i = 0; i < 64; i += lanes)
+  {
+    const ScanVector value = ScanVectorXor(ScanVectorLoad<T>(current + i * sizeof(T)), bias);
+    ScanVector match;
+
+    if constexpr (type == ScanFilter::Type::Range)
     {
-      return is_signed ? (static_cast<s32>(value) > static_cast<s32>(last_value)) : (value > last_value);
+      const ScanVector outside = ScanVectorOr(ScanVectorGreater<T>(low, value), ScanVectorGreater<T>(value, high));
+      match = ScanVectorXor(outside, ScanVectorXor(invert, ones));
+    }
+    else
+    {
+      const ScanVector last_value = ScanVectorXor(ScanVectorLoad<T>(last + i * sizeof(T)), bias);
+      if constexpr (type == ScanFilter::Type::Compare)
+      {
+        const ScanVector a = filter.swap ? last_value : value;
+        const ScanVector b = filter.swap ? value : last_value;
+        match = ScanVectorXor(filter.equal ? ScanVectorEqual<T>(a, b) : ScanVectorGreater<T>(a, b), invert);
+      }
+      else
+      {
+        match = ScanVectorSplat<T>(0u);
+        for (u32 j = 0; j < filter.num_terms; j++)
+        {
+          const ScanFilter::Term& term = filter.terms[j];
+          const ScanVector a = term.swap ? last_value : value;
+          const ScanVector b = term.swap ? value : last_value;
+          ScanVector term_match = ScanVectorEqual<T>(ScanVectorSub<T>(a, b), ScanVectorSplat<T>(term.value));
+          if (term.condition == ScanFilter::Condition::GreaterEqual)
+            term_match = ScanVectorAnd(term_match, ScanVectorXor(ScanVectorGreater<T>(b, a), ones));
+          else if (term.condition == ScanFilter::Condition::Less)
+            term_match = ScanVectorAnd(term_match, ScanVectorGreater<T>(b, a));
+
+          match = ScanVectorOr(match, term_match);
+        }
+      }
     }
 
-    case Operator::GreaterEqualLast:
+    bits |= static_cast<u64>(ScanVectorMask<T>(match)) << i;
+  }
+
+  return bits;
+}
+
+template<typename T, ScanFilter::Type type>
+static void FilterScanSegment(const ScanFilter& filter, const u8* current, const u8* last, u32 count, u64* candidates)
+{
+  constexpr u32 chunk_size = 64 * sizeof(T);
+  const u32 num_words = (count + 63) / 64;
+  for (u32 word = 0; word < num_words; word++)
+  {
+    if (candidates[word] == 0)
+      continue;
+
+    const u32 offset = word * chunk_size;
+    const u32 remaining = count - (word * 64);
+    if (remaining >= 64)
+    {
+      candidates[word] &= FilterScanChunk<T, type>(filter, current + offset, last + offset);
+    }
+    else
     {
-      return is_signed ? (static_cast<s32>(value) >= static_cast<s32>(last_value)) : (value >= last_value);
+      // Don't read past the end of the segment, candidate bits past the end are never set.
+      std::array<u8, chunk_size> padded_current = {};
+      std::array<u8, chunk_size> padded_last = {};
+      std::memcpy(padded_current.data(), current + offset, remaining * sizeof(T));
+      std::memcpy(padded_last.data(), last + offset, remaining * sizeof(T));
+      candidates[word] &= FilterScanChunk<T, type>(filter, padded_current.data(), padded_last.data());
     }
+  }
+}
 
-    case Operator::LessThanLast:
+template<typename T>
+static void FilterScanSegment(const ScanFilter& filter, const u8* current, const u8* last, u32 count, u64* candidates)
+{
+  switch (filter.type)
+  {
+    case ScanFilter::Type::None:
+      std::fill_n(candidates, (count + 63) / 64, 0);
+      break;
+
+    case ScanFilter::Type::Range:
+      FilterScanSegment<T, ScanFilter::Type::Range>(filter, current, last, count, candidates);
+      break;
+
+    case ScanFilter::Type::Compare:
+      FilterScanSegment<T, ScanFilter::Type::Compare>(filter, current, last, count, candidates);
+      break;
+
+    case ScanFilter::Type::Difference:
+      FilterScanSegment<T, ScanFilter::Type::Difference>(filter, current, last, count, candidates);
+      break;
+
+    case ScanFilter::Type::All:
+    default:
+      break;
+  }
+}
+
+static const u8* GetScanMemory(u32 snapshot_offset)
+{
+  if (snapshot_offset < SNAPSHOT_BIOS_OFFSET)
+    return Bus::g_ram + (snapshot_offset - SNAPSHOT_RAM_OFFSET);
+  else if (snapshot_offset < SNAPSHOT_DCACHE_OFFSET)
+    return Bus::g_bios + (snapshot_offset - SNAPSHOT_BIOS_OFFSET);
+  else
+    return CPU::g_state.dcache.data() + (snapshot_offset - SNAPSHOT_DCACHE_OFFSET);
+}
+
+void MemoryScan::SetSize(MemoryAccessSize size)
+{
+  if (m_size == size)
+    return;
+
+  // The candidates and snapshot are laid out for one element size, so they can't be filtered at another.
+  m_size = size;
+  ResetSearch();
+}
+
+void MemoryScan::ResetSearch()
+{
+  m_results.clear();
+  m_result_count = 0;
+  m_segments = {};
+  m_snapshot = {};
+  m_candidates = {};
+}
+
+void MemoryScan::Search()
+{
+  Common::Timer timer;
+
+  m_search_size = m_size;
+  BuildSegments();
+  UpdateSnapshot();
+  FilterCandidates(false);
+  UpdateResults();
+
+  Log_DevPrintf("Memory scan found %u results in %.2f ms", m_result_count, timer.GetTimeMilliseconds());
+}
+
+void MemoryScan::SearchAgain()
+{
+  Common::Timer timer;
+
+  FilterCandidates(true);
+  UpdateSnapshot();
+  UpdateResults();
+
+  Log_DevPrintf("Memory scan found %u results in %.2f ms", m_result_count, timer.GetTimeMilliseconds());
+}
+
+void MemoryScan::BuildSegments()
+{
+  m_segments.clear();
+
+  // Elements are aligned, so none of them straddle two regions.
+  const u32 element_size = 1u << static_cast<u32>(m_search_size);
+  const u64 start = (static_cast<u64>(m_start_address) + (element_size - 1)) & ~static_cast<u64>(element_size - 1);
+  const u64 end = m_end_address;
+  u32 num_words = 0;
+
+  auto add_region = [&](u64 region_start, u32 region_size, u32 snapshot_offset) {
+    const u64 segment_start = std::max(region_start, start);
+    const u64 segment_end = std::min(region_start + region_size, end);
+    if (segment_start >= segment_end)
+      return;
+
+    Segment segment;
+    segment.address = static_cast<PhysicalMemoryAddress>(segment_start);
+    segment.count = static_cast<u32>((segment_end - segment_start + (element_size - 1)) / element_size);
+    segment.snapshot_offset = snapshot_offset + static_cast<u32>(segment_start - region_start);
+    segment.first_candidate_word = num_words;
+    m_segments.push_back(segment);
+    num_words += (segment.count + 63) / 64;
+  };
+
+  // Same regions as DoMemoryRead(), in address order.
+  for (u32 mirror = 0; mirror < 8; mirror++)
+  {
+    const u64 base = static_cast<u64>(mirror) << 29;
+    for (u32 offset = 0; offset < Bus::RAM_MIRROR_END; offset += Bus::RAM_SIZE)
+      add_region(base + offset, Bus::RAM_SIZE, SNAPSHOT_RAM_OFFSET);
+    if (mirror == 0)
+      add_region(CPU::DCACHE_LOCATION, CPU::DCACHE_SIZE, SNAPSHOT_DCACHE_OFFSET);
+    add_region(base + Bus::BIOS_BASE, Bus::BIOS_SIZE, SNAPSHOT_BIOS_OFFSET);
+  }
+
+  m_candidates.assign(num_words, ~UINT64_C(0));
+  for (const Segment& segment : m_segments)
+  {
+    if ((segment.count % 64) != 0)
+      m_candidates[segment.first_candidate_word + (segment.count / 64)] = (UINT64_C(1) << (segment.count % 64)) - 1;
+  }
+}
+
+void MemoryScan::UpdateSnapshot()
+{
+  m_snapshot.resize(SNAPSHOT_SIZE);
+  std::memcpy(&m_snapshot[SNAPSHOT_RAM_OFFSET], Bus::g_ram, Bus::RAM_SIZE);
+  std::memcpy(&m_snapshot[SNAPSHOT_BIOS_OFFSET], Bus::g_bios, Bus::BIOS_SIZE);
+  std::memcpy(&m_snapshot[SNAPSHOT_DCACHE_OFFSET], CPU::g_state.dcache.data(), CPU::DCACHE_SIZE);
+}
+
+void MemoryScan::FilterCandidates(bool compare_to_memory)
+{
+  const ScanFilter filter = BuildScanFilter(m_operator, m_value, m_signed, m_search_size);
+  for (const Segment& segment : m_segments)
+  {
+    const u8* last = &m_snapshot[segment.snapshot_offset];
+    const u8* current = compare_to_memory ? GetScanMemory(segment.snapshot_offset) : last;
+    u64* candidates = &m_candidates[segment.first_candidate_word];
+
+    switch (m_search_size)
     {
-      return is_signed ? (static_cast<s32>(value) < static_cast<s32>(last_value)) : (value < last_value);
+      case MemoryAccessSize::Byte:
+        FilterScanSegment<u8>(filter, current, last, segment.count, candidates);
+        break;
+
+      case MemoryAccessSize::HalfWord:
+        FilterScanSegment<u16>(filter, current, last, segment.count, candidates);
+        break;
+
+      case MemoryAccessSize::Word:
+        FilterScanSegment<u32>(filter, current, last, segment.count, candidates);
+        break;
     }
+  }
+}
 
-    case Operator::LessEqualLast:
+void MemoryScan::UpdateResults()
+{
+  m_results.clear();
+  m_result_count = 0;
+
+  const u32 element_size = 1u << static_cast<u32>(m_search_size);
+  for (const Segment& segment : m_segments)
+  {
+    const u32 num_words = (segment.count + 63) / 64;
+    for (u32 word = 0; word < num_words; word++)
     {
-      return is_signed ? (static_cast<s32>(value) <= static_cast<s32>(last_value)) : (value <= last_value);
+      u64 bits = m_candidates[segment.first_candidate_word + word];
+      m_result_count += CountSetBits(bits);
+
+      while (bits != 0 && m_results.size() < MAX_LISTED_RESULTS)
+      {
+        const u32 index = (word * 64) + CountTrailingZeros(bits);
+        bits &= bits - 1;
+
+        // The snapshot was just taken, so it holds the current values.
+        const u8* ptr = &m_snapshot[segment.snapshot_offset + index * element_size];
+        Result res;
+        res.address = segment.address + index * element_size;
+        switch (m_search_size)
+        {
+          case MemoryAccessSize::Byte:
+            res.value = m_signed ? SignExtend32(*ptr) : ZeroExtend32(*ptr);
+            break;
+
+          case MemoryAccessSize::HalfWord:
+          {
+            u16 hvalue;
+            std::memcpy(&hvalue, ptr, sizeof(hvalue));
+            res.value = m_signed ? SignExtend32(hvalue) : ZeroExtend32(hvalue);
+          }
+          break;
+
+          case MemoryAccessSize::Word:
+          default:
+            std::memcpy(&res.value, ptr, sizeof(res.value));
+            break;
+        }
+
+        res.last_value = res.value;
+        res.value_changed = false;
+        m_results.push_back(res);
+      }
     }
+  }
+}
 
-    case Operator::Any:
-      return true;
+void MemoryScan::UpdateResultsValues()
+{
+  for (Result& res : m_results)
+    res.UpdateValue(m_search_size, m_signed);
+}
 
-    default:
-      return false;
+void MemoryScan::SetResultValue(u32 index, u32 value)
+{
+  if (index >= m_results.size())
+    return;
+
+  Result& res = m_results[index];
+  if (res.value == value)
+    return;
+
+  switch (m_search_size)
+  {
+    case MemoryAccessSize::Byte:
+      DoMemoryWrite<u8>(res.address, Truncate8(value));
+      break;
+
+    case MemoryAccessSize::HalfWord:
+      DoMemoryWrite<u16>(res.address, Truncate16(value));
+      break;
+
+    case MemoryAccessSize::Word:
+      CPU::SafeWriteMemoryWord(res.address, value);
+      break;
   }
+
+  res.value = value;
+  res.value_changed = true;
 }
 
 void MemoryScan::Result::UpdateValue(MemoryAccessSize size, bool is_signed)
@@ -130,7 +130,11 @@ public:
   ~CheatList();
 
   ALWAYS_INLINE const CheatCode& GetCode(u32 i) const { return m_codes[i]; }
-  ALWAYS_INLINE CheatCode& GetCode(u32 i) { return m_codes[i]; }
+  ALWAYS_INLINE CheatCode& GetCode(u32 i)
+  {
+    m_program_dirty = true;
+    return m_codes[i];
+  }
   ALWAYS_INLINE u32 GetCodeCount() const { return static_cast<u32>(m_codes.size()); }
   ALWAYS_INLINE bool IsCodeEnabled(u32 index) const { return m_codes[index].enabled; }
 
@@ -166,6 +170,7 @@ public:
 
   bool LoadFromPackage(const std::string& game_code);
 
+  /// Runs all enabled codes. They're compiled on first use after the list changes.
   void Apply();
 
   void ApplyCode(u32 index);
@@ -173,7 +178,15 @@ public:
   void MergeList(const CheatList& cl);
 
 private:
+  struct CompiledOp;
+
+  void CompileProgram();
+  static void CompileCode(const CheatCode& cc, std::vector<CompiledOp>* program);
+
   std::vector<CheatCode> m_codes;
+  std::vector<CompiledOp> m_program;
+  u8* m_program_ram = nullptr;
+  bool m_program_dirty = true;
   bool m_master_enable = true;
 };
 
@@ -207,12 +220,17 @@ public:
     u32 last_value;
     bool value_changed;
 
-    bool Filter(Operator op, u32 comp_value, bool is_signed) const;
     void UpdateValue(MemoryAccessSize size, bool is_signed);
   };
 
   using ResultVector = std::vector<Result>;
 
+  enum : u32
+  {
+    /// Results past this many are counted, but not listed.
+    MAX_LISTED_RESULTS = 5000
+  };
+
   MemoryScan();
   ~MemoryScan();
 
@@ -222,13 +240,18 @@ public:
   Operator GetOperator() const { return m_operator; }
   PhysicalMemoryAddress GetStartAddress() const { return m_start_address; }
   PhysicalMemoryAddress GetEndAddress() const { return m_end_address; }
+
+  /// The first MAX_LISTED_RESULTS results, in address order.
   const ResultVector& GetResults() const { return m_results; }
   const Result& GetResult(u32 index) const { return m_results[index]; }
-  u32 GetResultCount() const { return static_cast<u32>(m_results.size()); }
+
+  /// Total number of matching addresses, including those which aren't listed.
+  u32 GetResultCount() const { return m_result_count; }
 
   void SetValue(u32 value) { m_value = value; }
   void SetValueSigned(bool s) { m_signed = s; }
-  void SetSize(MemoryAccessSize size) { m_size = size; }
+  /// Changing the size discards the current search.
+  void SetSize(MemoryAccessSize size);
   void SetOperator(Operator op) { m_operator = op; }
   void SetStartAddress(PhysicalMemoryAddress addr) { m_start_address = addr; }
   void SetEndAddress(PhysicalMemoryAddress addr) { m_end_address = addr; }
@@ -241,9 +264,19 @@ public:
   void SetResultValue(u32 index, u32 value);
 
 private:
-  void SearchBytes();
-  void SearchHalfwords();
-  void SearchWords();
+  /// Part of the search range which is backed by contiguous memory.
+  struct Segment
+  {
+    PhysicalMemoryAddress address;
+    u32 count;
+    u32 snapshot_offset;
+    u32 first_candidate_word;
+  };
+
+  void BuildSegments();
+  void UpdateSnapshot();
+  void FilterCandidates(bool compare_to_memory);
+  void UpdateResults();
 
   u32 m_value = 0;
   MemoryAccessSize m_size = MemoryAccessSize::HalfWord;
@@ -252,6 +285,14 @@ private:
   PhysicalMemoryAddress m_end_address = 0x200000;
   ResultVector m_results;
   bool m_signed = false;
+
+  // Searches compare memory against a copy taken by the previous search, instead of storing a value per address.
+  // Remaining candidates are one bit per address, so memory use doesn't depend on the number of results.
+  std::vector<Segment> m_segments;
+  std::vector<u8> m_snapshot;
+  std::vector<u64> m_candidates;
+  MemoryAccessSize m_search_size = MemoryAccessSize::HalfWord;
+  u32 m_result_count = 0;
 };
 
 class MemoryWatchList
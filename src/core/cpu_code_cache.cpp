@@ -85,6 +85,7 @@ static CodeBlock* LookupBlock(CodeBlockKey key);
 static bool RevalidateBlock(CodeBlock* block);
 
 static bool CompileBlock(CodeBlock* block);
+static void CompileCachedInterpreterBlock(CodeBlock* block);
 static void FlushBlock(CodeBlock* block);
 static void AddBlockToPageMap(CodeBlock* block);
 static void RemoveBlockFromPageMap(CodeBlock* block);
@@ -603,12 +604,201 @@ bool CompileBlock(CodeBlock* block)
       Log_ErrorPrintf("Failed to compile host code for block at 0x%08X", block->key.GetPC());
       return false;
     }
+
+    return true;
   }
 #endif
 
+  CompileCachedInterpreterBlock(block);
   return true;
 }
 
+static bool IsStatelessCachedInterpreterOp(CachedInterpreterOp op)
+{
+  return (op >= CachedInterpreterOp::Nop && op <= CachedInterpreterOp::Sltiu);
+}
+
+void CompileCachedInterpreterBlock(CodeBlock* block)
+{
+  block->interpreter_instructions.clear();
+  block->interpreter_instructions.reserve(block->instructions.size());
+
+  u32 ticks = 0;
+  for (const CodeBlockInstruction& cbi : block->instructions)
+  {
+    const Instruction& inst = cbi.instruction;
+    CachedInterpreterInstruction ci = {};
+    ci.instruction.bits = inst.bits;
+    ci.pc = cbi.pc;
+    ci.op = CachedInterpreterOp::Generic;
+    ci.rs = inst.r.rs;
+    ci.rt = inst.r.rt;
+    ci.rd = inst.r.rd;
+    ci.imm = inst.i.imm_sext32();
+    ci.is_branch_delay_slot = cbi.is_branch_delay_slot;
+
+    // Branch targets are computed here, which is only correct when the pc is sequential. Branches in delay slots use
+    // the first branch's target as the pc, so those are left to the interpreter.
+    const bool can_branch = !cbi.is_branch_delay_slot;
+    const u32 branch_target = cbi.pc + 4 + (inst.i.imm_sext32() << 2);
+    const u32 jump_target = ((cbi.pc + 4) & UINT32_C(0xF0000000)) | (inst.j.target << 2);
+
+    switch (inst.op)
+    {
+      case InstructionOp::funct:
+      {
+        switch (inst.r.funct)
+        {
+          case InstructionFunct::sll:
+            ci.op = (inst.bits == 0) ? CachedInterpreterOp::Nop : CachedInterpreterOp::Sll;
+            ci.imm = inst.r.shamt;
+            break;
+          case InstructionFunct::srl:
+            ci.op = CachedInterpreterOp::Srl;
+            ci.imm = inst.r.shamt;
+            break;
+          case InstructionFunct::sra:
+            ci.op = CachedInterpreterOp::Sra;
+            ci.imm = inst.r.shamt;
+            break;
+          case InstructionFunct::sllv:
+            ci.op = CachedInterpreterOp::Sllv;
+            break;
+          case InstructionFunct::srlv:
+            ci.op = CachedInterpreterOp::Srlv;
+            break;
+          case InstructionFunct::srav:
+            ci.op = CachedInterpreterOp::Srav;
+            break;
+          case InstructionFunct::addu:
+            ci.op = CachedInterpreterOp::Addu;
+            break;
+          case InstructionFunct::subu:
+            ci.op = CachedInterpreterOp::Subu;
+            break;
+          case InstructionFunct::and_:
+            ci.op = CachedInterpreterOp::And;
+            break;
+          case InstructionFunct::or_:
+            ci.op = CachedInterpreterOp::Or;
+            break;
+          case InstructionFunct::xor_:
+            ci.op = CachedInterpreterOp::Xor;
+            break;
+          case InstructionFunct::nor:
+            ci.op = CachedInterpreterOp::Nor;
+            break;
+          case InstructionFunct::slt:
+            ci.op = CachedInterpreterOp::Slt;
+            break;
+          case InstructionFunct::sltu:
+            ci.op = CachedInterpreterOp::Sltu;
+            break;
+          case InstructionFunct::jr:
+            ci.op = can_branch ? CachedInterpreterOp::Jr : CachedInterpreterOp::Generic;
+            break;
+          case InstructionFunct::jalr:
+            ci.op = can_branch ? CachedInterpreterOp::Jalr : CachedInterpreterOp::Generic;
+            break;
+          default:
+            break;
+        }
+      }
+      break;
+
+      case InstructionOp::lui:
+        ci.op = CachedInterpreterOp::Lui;
+        ci.imm = inst.i.imm_zext32() << 16;
+        break;
+      case InstructionOp::addiu:
+        ci.op = CachedInterpreterOp::Addiu;
+        break;
+      case InstructionOp::andi:
+        ci.op = CachedInterpreterOp::Andi;
+        ci.imm = inst.i.imm_zext32();
+        break;
+      case InstructionOp::ori:
+        ci.op = CachedInterpreterOp::Ori;
+        ci.imm = inst.i.imm_zext32();
+        break;
+      case InstructionOp::xori:
+        ci.op = CachedInterpreterOp::Xori;
+        ci.imm = inst.i.imm_zext32();
+        break;
+      case InstructionOp::slti:
+        ci.op = CachedInterpreterOp::Slti;
+        break;
+      case InstructionOp::sltiu:
+        ci.op = CachedInterpreterOp::Sltiu;
+        break;
+
+      case InstructionOp::lb:
+        ci.op = CachedInterpreterOp::Lb;
+        break;
+      case InstructionOp::lbu:
+        ci.op = CachedInterpreterOp::Lbu;
+        break;
+      case InstructionOp::lh:
+        ci.op = CachedInterpreterOp::Lh;
+        break;
+      case InstructionOp::lhu:
+        ci.op = CachedInterpreterOp::Lhu;
+        break;
+      case InstructionOp::lw:
+        ci.op = CachedInterpreterOp::Lw;
+        break;
+      case InstructionOp::sb:
+        ci.op = CachedInterpreterOp::Sb;
+        break;
+      case InstructionOp::sh:
+        ci.op = CachedInterpreterOp::Sh;
+        break;
+      case InstructionOp::sw:
+        ci.op = CachedInterpreterOp::Sw;
+        break;
+
+      case InstructionOp::j:
+        ci.op = can_branch ? CachedInterpreterOp::J : CachedInterpreterOp::Generic;
+        ci.imm = jump_target;
+        break;
+      case InstructionOp::jal:
+        ci.op = can_branch ? CachedInterpreterOp::Jal : CachedInterpreterOp::Generic;
+        ci.imm = jump_target;
+        break;
+      case InstructionOp::beq:
+        ci.op = can_branch ? CachedInterpreterOp::Beq : CachedInterpreterOp::Generic;
+        ci.imm = branch_target;
+        break;
+      case InstructionOp::bne:
+        ci.op = can_branch ? CachedInterpreterOp::Bne : CachedInterpreterOp::Generic;
+        ci.imm = branch_target;
+        break;
+      case InstructionOp::blez:
+        ci.op = can_branch ? CachedInterpreterOp::Blez : CachedInterpreterOp::Generic;
+        ci.imm = branch_target;
+        break;
+      case InstructionOp::bgtz:
+        ci.op = can_branch ? CachedInterpreterOp::Bgtz : CachedInterpreterOp::Generic;
+        ci.imm = branch_target;
+        break;
+
+      default:
+        break;
+    }
+
+    // The last instruction always brings the state up to date, as do delay slots, so the branch flags are cleared.
+    ticks++;
+    if (!IsStatelessCachedInterpreterOp(ci.op) || cbi.is_branch_delay_slot || cbi.is_last_instruction ||
+        ticks == UINT16_MAX)
+    {
+      ci.ticks = static_cast<u16>(ticks);
+      ticks = 0;
+    }
+
+    block->interpreter_instructions.push_back(ci);
+  }
+}
+
 #ifdef WITH_RECOMPILER
 
 void FastCompileBlockFunction()
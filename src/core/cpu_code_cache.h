@@ -62,6 +62,75 @@ struct CodeBlockInstruction
   bool can_trap : 1;
 };
 
+/// Handlers for the cached interpreter. Anything without a dedicated handler goes through the interpreter's decoder.
+enum class CachedInterpreterOp : u8
+{
+  Generic,
+  Nop,
+
+  // no exceptions or branches, these don't need the current instruction state
+  Sll,
+  Srl,
+  Sra,
+  Sllv,
+  Srlv,
+  Srav,
+  Addu,
+  Subu,
+  And,
+  Or,
+  Xor,
+  Nor,
+  Slt,
+  Sltu,
+  Lui,
+  Addiu,
+  Andi,
+  Ori,
+  Xori,
+  Slti,
+  Sltiu,
+
+  Lb,
+  Lbu,
+  Lh,
+  Lhu,
+  Lw,
+  Sb,
+  Sh,
+  Sw,
+  J,
+  Jal,
+  Jr,
+  Jalr,
+  Beq,
+  Bne,
+  Blez,
+  Bgtz,
+
+  Count
+};
+
+/// Pre-decoded instruction for the cached interpreter.
+struct CachedInterpreterInstruction
+{
+  Instruction instruction;
+  u32 pc;
+
+  // extended immediate, shift amount, or branch target
+  u32 imm;
+
+  CachedInterpreterOp op;
+  Reg rs;
+  Reg rt;
+  Reg rd;
+
+  // Instructions retired when this one executes. Runs of instructions which don't need the current instruction state
+  // have zero, and are accounted for in the next instruction which does, which is always the case for the last one.
+  u16 ticks;
+  bool is_branch_delay_slot;
+};
+
 struct CodeBlock
 {
   using HostCodePointer = void (*)();
@@ -73,6 +142,7 @@ struct CodeBlock
   HostCodePointer host_code = nullptr;
 
   std::vector<CodeBlockInstruction> instructions;
+  std::vector<CachedInterpreterInstruction> interpreter_instructions;
   std::vector<CodeBlock*> link_predecessors;
   std::vector<CodeBlock*> link_successors;
 
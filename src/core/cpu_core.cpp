@@ -108,7 +108,7 @@ void Reset()
     PGXP::Initialize();
 }
 
-bool DoState(StateWrapper& sw)
+bool DoState(StateWrapper& sw, bool is_memory_state)
 {
   sw.Do(&g_state.pending_ticks);
   sw.Do(&g_state.downcount);
@@ -146,7 +146,10 @@ bool DoState(StateWrapper& sw)
   if (sw.IsReading())
   {
     ClearICache();
-    if (g_settings.gpu_pgxp_enable)
+
+    // Run-ahead loads a memory state every frame. PGXP checks its values against the real ones before using them, so
+    // it keeps tracking across the rollback, instead of starting from nothing each frame.
+    if (g_settings.gpu_pgxp_enable && !is_memory_state)
       PGXP::Initialize();
   }
 
@@ -787,7 +790,7 @@ restart_instruction:
           g_state.regs.lo = Truncate32(result);
 
           if constexpr (pgxp_mode >= PGXPMode::CPU)
-            PGXP::CPU_MULT(inst.bits, g_state.regs.hi, g_state.regs.lo, lhs, rhs);
+            PGXP::CPU_MULT(inst.bits, lhs, rhs);
         }
         break;
 
@@ -797,8 +800,9 @@ restart_instruction:
           const u32 rhs = ReadReg(inst.r.rt);
           const u64 result = ZeroExtend64(lhs) * ZeroExtend64(rhs);
 
+          // PGXP computes hi/lo from the operands, so it does not matter that they have not been written yet.
           if constexpr (pgxp_mode >= PGXPMode::CPU)
-            PGXP::CPU_MULTU(inst.bits, g_state.regs.hi, g_state.regs.lo, lhs, rhs);
+            PGXP::CPU_MULTU(inst.bits, lhs, rhs);
 
           g_state.regs.hi = Truncate32(result >> 32);
           g_state.regs.lo = Truncate32(result);
@@ -829,7 +833,7 @@ restart_instruction:
           }
 
           if constexpr (pgxp_mode >= PGXPMode::CPU)
-            PGXP::CPU_DIV(inst.bits, g_state.regs.hi, g_state.regs.lo, num, denom);
+            PGXP::CPU_DIV(inst.bits, num, denom);
         }
         break;
 
@@ -851,7 +855,7 @@ restart_instruction:
           }
 
           if constexpr (pgxp_mode >= PGXPMode::CPU)
-            PGXP::CPU_DIVU(inst.bits, g_state.regs.hi, g_state.regs.lo, num, denom);
+            PGXP::CPU_DIVU(inst.bits, num, denom);
         }
         break;
 
@@ -1815,6 +1819,12 @@ void SingleStep()
 
 namespace CodeCache {
 
+// The cached interpreter runs pre-decoded blocks. With GCC and Clang, each handler dispatches the next instruction
+// itself through a computed goto, giving every handler its own indirect branch to predict, otherwise a switch is used.
+#if defined(__GNUC__) || defined(__clang__)
+#define CACHED_INTERPRETER_THREADED 1
+#endif
+
 template<PGXPMode pgxp_mode>
 void InterpretCachedBlock(const CodeBlock& block)
 {
@@ -1822,34 +1832,503 @@ void InterpretCachedBlock(const CodeBlock& block)
   DebugAssert(g_state.regs.pc == block.GetPC());
   g_state.regs.npc = block.GetPC() + 4;
 
-  for (const CodeBlockInstruction& cbi : block.instructions)
+  const CachedInterpreterInstruction* ci = block.interpreter_instructions.data();
+  const CachedInterpreterInstruction* const ci_end = ci + block.interpreter_instructions.size();
+
+  // Instructions without ticks can't raise exceptions or branch, so the state is only brought up to date for the
+  // ones which can. They're all sequential, so the pc is known, except in delay slots.
+#define CACHED_INTERPRETER_BEGIN()                                                                                     \
+  if (ci->ticks != 0)                                                                                                  \
+  {                                                                                                                    \
+    g_state.pending_ticks += ci->ticks;                                                                                \
+    g_state.current_instruction.bits = ci->instruction.bits;                                                           \
+    g_state.current_instruction_pc = ci->pc;                                                                           \
+    g_state.current_instruction_in_branch_delay_slot = ci->is_branch_delay_slot;                                       \
+    g_state.current_instruction_was_branch_taken = g_state.branch_was_taken;                                           \
+    g_state.branch_was_taken = false;                                                                                  \
+    g_state.exception_raised = false;                                                                                  \
+    if (ci->is_branch_delay_slot)                                                                                      \
+    {                                                                                                                  \
+      g_state.regs.pc = g_state.regs.npc;                                                                              \
+      g_state.regs.npc += 4;                                                                                           \
+    }                                                                                                                  \
+    else                                                                                                               \
+    {                                                                                                                  \
+      g_state.regs.pc = ci->pc + 4;                                                                                    \
+      g_state.regs.npc = ci->pc + 8;                                                                                   \
+    }                                                                                                                  \
+  }
+
+  // most instructions don't have a load delay
+#define CACHED_INTERPRETER_UPDATE_LOAD_DELAY()                                                                         \
+  if (g_state.load_delay_reg != Reg::count || g_state.next_load_delay_reg != Reg::count)                               \
+    UpdateLoadDelay()
+
+#ifdef CACHED_INTERPRETER_THREADED
+  static const void* const handlers[] = {
+    &&op_Generic, &&op_Nop, &&op_Sll, &&op_Srl, &&op_Sra, &&op_Sllv, &&op_Srlv, &&op_Srav, &&op_Addu, &&op_Subu,
+    &&op_And, &&op_Or, &&op_Xor, &&op_Nor, &&op_Slt, &&op_Sltu, &&op_Lui, &&op_Addiu, &&op_Andi, &&op_Ori, &&op_Xori,
+    &&op_Slti, &&op_Sltiu, &&op_Lb, &&op_Lbu, &&op_Lh, &&op_Lhu, &&op_Lw, &&op_Sb, &&op_Sh, &&op_Sw, &&op_J, &&op_Jal,
+    &&op_Jr, &&op_Jalr, &&op_Beq, &&op_Bne, &&op_Blez, &&op_Bgtz};
+  static_assert(std::size(handlers) == static_cast<size_t>(CachedInterpreterOp::Count));
+
+#define CACHED_INTERPRETER_HANDLER(name) op_##name:
+#define CACHED_INTERPRETER_DISPATCH()                                                                                  \
+  CACHED_INTERPRETER_BEGIN();                                                                                          \
+  goto* handlers[static_cast<u8>(ci->op)]
+
+  // Stateless instructions can't raise exceptions.
+#define CACHED_INTERPRETER_NEXT_STATELESS()                                                                            \
+  {                                                                                                                    \
+    CACHED_INTERPRETER_UPDATE_LOAD_DELAY();                                                                            \
+    if (++ci == ci_end)                                                                                                \
+      goto block_done;                                                                                                 \
+    CACHED_INTERPRETER_DISPATCH();                                                                                     \
+  }
+#define CACHED_INTERPRETER_NEXT()                                                                                      \
+  {                                                                                                                    \
+    CACHED_INTERPRETER_UPDATE_LOAD_DELAY();                                                                            \
+    if (g_state.exception_raised || ++ci == ci_end)                                                                    \
+      goto block_done;                                                                                                 \
+    CACHED_INTERPRETER_DISPATCH();                                                                                     \
+  }
+
+  CACHED_INTERPRETER_DISPATCH();
   {
-    g_state.pending_ticks++;
+#else
+#define CACHED_INTERPRETER_HANDLER(name) case CachedInterpreterOp::name:
+#define CACHED_INTERPRETER_NEXT_STATELESS() break
+#define CACHED_INTERPRETER_NEXT() break
 
-    // now executing the instruction we previously fetched
-    g_state.current_instruction.bits = cbi.instruction.bits;
-    g_state.current_instruction_pc = cbi.pc;
-    g_state.current_instruction_in_branch_delay_slot = cbi.is_branch_delay_slot;
-    g_state.current_instruction_was_branch_taken = g_state.branch_was_taken;
-    g_state.branch_was_taken = false;
-    g_state.exception_raised = false;
+  for (; ci != ci_end; ci++)
+  {
+    CACHED_INTERPRETER_BEGIN();
 
-    // update pc
-    g_state.regs.pc = g_state.regs.npc;
-    g_state.regs.npc += 4;
+    switch (ci->op)
+    {
+#endif
 
-    // execute the instruction we previously fetched
-    ExecuteInstruction<pgxp_mode>();
+    CACHED_INTERPRETER_HANDLER(Nop)
+    CACHED_INTERPRETER_NEXT_STATELESS();
 
-    // next load delay
-    UpdateLoadDelay();
+    CACHED_INTERPRETER_HANDLER(Sll)
+    {
+      const u32 new_value = ReadReg(ci->rt) << ci->imm;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SLL(ci->instruction.bits, new_value, ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Srl)
+    {
+      const u32 new_value = ReadReg(ci->rt) >> ci->imm;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SRL(ci->instruction.bits, new_value, ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Sra)
+    {
+      const u32 new_value = static_cast<u32>(static_cast<s32>(ReadReg(ci->rt)) >> ci->imm);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SRA(ci->instruction.bits, new_value, ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Sllv)
+    {
+      const u32 shift_amount = ReadReg(ci->rs) & UINT32_C(0x1F);
+      const u32 new_value = ReadReg(ci->rt) << shift_amount;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SLLV(ci->instruction.bits, new_value, ReadReg(ci->rt), shift_amount);
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Srlv)
+    {
+      const u32 shift_amount = ReadReg(ci->rs) & UINT32_C(0x1F);
+      const u32 new_value = ReadReg(ci->rt) >> shift_amount;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SRLV(ci->instruction.bits, new_value, ReadReg(ci->rt), shift_amount);
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Srav)
+    {
+      const u32 shift_amount = ReadReg(ci->rs) & UINT32_C(0x1F);
+      const u32 new_value = static_cast<u32>(static_cast<s32>(ReadReg(ci->rt)) >> shift_amount);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SRAV(ci->instruction.bits, new_value, ReadReg(ci->rt), shift_amount);
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Addu)
+    {
+      const u32 old_value = ReadReg(ci->rs);
+      const u32 add_value = ReadReg(ci->rt);
+      const u32 new_value = old_value + add_value;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_ADDU(ci->instruction.bits, new_value, old_value, add_value);
+      else if constexpr (pgxp_mode >= PGXPMode::Memory)
+      {
+        if (add_value == 0)
+          PGXP::CPU_MOVE((static_cast<u32>(ci->rd) << 8) | static_cast<u32>(ci->rs), old_value);
+      }
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Subu)
+    {
+      const u32 new_value = ReadReg(ci->rs) - ReadReg(ci->rt);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SUBU(ci->instruction.bits, new_value, ReadReg(ci->rs), ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(And)
+    {
+      const u32 new_value = ReadReg(ci->rs) & ReadReg(ci->rt);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_AND_(ci->instruction.bits, new_value, ReadReg(ci->rs), ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Or)
+    {
+      const u32 new_value = ReadReg(ci->rs) | ReadReg(ci->rt);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_OR_(ci->instruction.bits, new_value, ReadReg(ci->rs), ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Xor)
+    {
+      const u32 new_value = ReadReg(ci->rs) ^ ReadReg(ci->rt);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_XOR_(ci->instruction.bits, new_value, ReadReg(ci->rs), ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Nor)
+    {
+      const u32 new_value = ~(ReadReg(ci->rs) | ReadReg(ci->rt));
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_NOR(ci->instruction.bits, new_value, ReadReg(ci->rs), ReadReg(ci->rt));
+
+      WriteReg(ci->rd, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Slt)
+    {
+      const u32 result = BoolToUInt32(static_cast<s32>(ReadReg(ci->rs)) < static_cast<s32>(ReadReg(ci->rt)));
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SLT(ci->instruction.bits, result, ReadReg(ci->rs), ReadReg(ci->rt));
 
-    if (g_state.exception_raised)
+      WriteReg(ci->rd, result);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Sltu)
+    {
+      const u32 result = BoolToUInt32(ReadReg(ci->rs) < ReadReg(ci->rt));
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SLTU(ci->instruction.bits, result, ReadReg(ci->rs), ReadReg(ci->rt));
+
+      WriteReg(ci->rd, result);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Lui)
+    {
+      WriteReg(ci->rt, ci->imm);
+
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_LUI(ci->instruction.bits, ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Addiu)
+    {
+      const u32 old_value = ReadReg(ci->rs);
+      const u32 new_value = old_value + ci->imm;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_ADDIU(ci->instruction.bits, new_value, old_value);
+      else if constexpr (pgxp_mode >= PGXPMode::Memory)
+      {
+        if (ci->imm == 0)
+          PGXP::CPU_MOVE((static_cast<u32>(ci->rt) << 8) | static_cast<u32>(ci->rs), old_value);
+      }
+
+      WriteReg(ci->rt, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Andi)
+    {
+      const u32 new_value = ReadReg(ci->rs) & ci->imm;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_ANDI(ci->instruction.bits, new_value, ReadReg(ci->rs));
+
+      WriteReg(ci->rt, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Ori)
+    {
+      const u32 new_value = ReadReg(ci->rs) | ci->imm;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_ORI(ci->instruction.bits, new_value, ReadReg(ci->rs));
+
+      WriteReg(ci->rt, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Xori)
+    {
+      const u32 new_value = ReadReg(ci->rs) ^ ci->imm;
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_XORI(ci->instruction.bits, new_value, ReadReg(ci->rs));
+
+      WriteReg(ci->rt, new_value);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Slti)
+    {
+      const u32 result = BoolToUInt32(static_cast<s32>(ReadReg(ci->rs)) < static_cast<s32>(ci->imm));
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SLTI(ci->instruction.bits, result, ReadReg(ci->rs));
+
+      WriteReg(ci->rt, result);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Sltiu)
+    {
+      const u32 result = BoolToUInt32(ReadReg(ci->rs) < ci->imm);
+      if constexpr (pgxp_mode >= PGXPMode::CPU)
+        PGXP::CPU_SLTIU(ci->instruction.bits, result, ReadReg(ci->rs));
+
+      WriteReg(ci->rt, result);
+    }
+    CACHED_INTERPRETER_NEXT_STATELESS();
+
+    CACHED_INTERPRETER_HANDLER(Lb)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      u8 value;
+      if (!ReadMemoryByte(addr, &value))
+        CACHED_INTERPRETER_NEXT();
+
+      const u32 sxvalue = SignExtend32(value);
+      WriteRegDelayed(ci->rt, sxvalue);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_LBx(ci->instruction.bits, sxvalue, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Lbu)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      u8 value;
+      if (!ReadMemoryByte(addr, &value))
+        CACHED_INTERPRETER_NEXT();
+
+      const u32 zxvalue = ZeroExtend32(value);
+      WriteRegDelayed(ci->rt, zxvalue);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_LBx(ci->instruction.bits, zxvalue, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Lh)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      u16 value;
+      if (!ReadMemoryHalfWord(addr, &value))
+        CACHED_INTERPRETER_NEXT();
+
+      const u32 sxvalue = SignExtend32(value);
+      WriteRegDelayed(ci->rt, sxvalue);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_LHx(ci->instruction.bits, sxvalue, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Lhu)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      u16 value;
+      if (!ReadMemoryHalfWord(addr, &value))
+        CACHED_INTERPRETER_NEXT();
+
+      const u32 zxvalue = ZeroExtend32(value);
+      WriteRegDelayed(ci->rt, zxvalue);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_LHx(ci->instruction.bits, zxvalue, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Lw)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      u32 value;
+      if (!ReadMemoryWord(addr, &value))
+        CACHED_INTERPRETER_NEXT();
+
+      WriteRegDelayed(ci->rt, value);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_LW(ci->instruction.bits, value, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Sb)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      const u8 value = Truncate8(ReadReg(ci->rt));
+      WriteMemoryByte(addr, value);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_SB(ci->instruction.bits, value, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Sh)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      const u16 value = Truncate16(ReadReg(ci->rt));
+      WriteMemoryHalfWord(addr, value);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_SH(ci->instruction.bits, value, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Sw)
+    {
+      const VirtualMemoryAddress addr = ReadReg(ci->rs) + ci->imm;
+      const u32 value = ReadReg(ci->rt);
+      WriteMemoryWord(addr, value);
+
+      if constexpr (pgxp_mode >= PGXPMode::Memory)
+        PGXP::CPU_SW(ci->instruction.bits, value, addr);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    // The delay slot flag for the next instruction comes from the block, so it isn't set by branches here.
+    CACHED_INTERPRETER_HANDLER(J)
+    {
+      Branch(ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Jal)
+    {
+      WriteReg(Reg::ra, g_state.regs.npc);
+      Branch(ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Jr)
+    {
+      Branch(ReadReg(ci->rs));
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Jalr)
+    {
+      const u32 target = ReadReg(ci->rs);
+      WriteReg(ci->rd, g_state.regs.npc);
+      Branch(target);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Beq)
+    {
+      if (ReadReg(ci->rs) == ReadReg(ci->rt))
+        Branch(ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Bne)
+    {
+      if (ReadReg(ci->rs) != ReadReg(ci->rt))
+        Branch(ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Blez)
+    {
+      if (static_cast<s32>(ReadReg(ci->rs)) <= 0)
+        Branch(ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Bgtz)
+    {
+      if (static_cast<s32>(ReadReg(ci->rs)) > 0)
+        Branch(ci->imm);
+    }
+    CACHED_INTERPRETER_NEXT();
+
+    CACHED_INTERPRETER_HANDLER(Generic)
+    {
+      ExecuteInstruction<pgxp_mode>();
+    }
+    CACHED_INTERPRETER_NEXT();
+
+#ifndef CACHED_INTERPRETER_THREADED
+      default:
+        UnreachableCode();
+        break;
+    }
+
+    CACHED_INTERPRETER_UPDATE_LOAD_DELAY();
+    if (ci->ticks != 0 && g_state.exception_raised)
       break;
+#endif
   }
 
+#ifdef CACHED_INTERPRETER_THREADED
+block_done:
+#endif
   // cleanup so the interpreter can kick in if needed
   g_state.next_instruction_is_branch_delay_slot = false;
+
+#undef CACHED_INTERPRETER_NEXT
+#undef CACHED_INTERPRETER_NEXT_STATELESS
+#undef CACHED_INTERPRETER_DISPATCH
+#undef CACHED_INTERPRETER_HANDLER
+#undef CACHED_INTERPRETER_UPDATE_LOAD_DELAY
+#undef CACHED_INTERPRETER_BEGIN
 }
 
 template void InterpretCachedBlock<PGXPMode::Disabled>(const CodeBlock& block);
@@ -1917,7 +2396,11 @@ bool InterpretInstruction()
 
 bool InterpretInstructionPGXP()
 {
-  ExecuteInstruction<PGXPMode::Memory>();
+  if (g_settings.gpu_pgxp_cpu)
+    ExecuteInstruction<PGXPMode::CPU>();
+  else
+    ExecuteInstruction<PGXPMode::Memory>();
+
   return g_state.exception_raised;
 }
 
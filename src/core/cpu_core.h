@@ -92,7 +92,7 @@ extern bool g_using_interpreter;
 void Initialize();
 void Shutdown();
 void Reset();
-bool DoState(StateWrapper& sw);
+bool DoState(StateWrapper& sw, bool is_memory_state);
 void ClearICache();
 
 /// Executes interpreter loop.
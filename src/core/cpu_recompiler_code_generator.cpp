@@ -27,6 +27,8 @@ bool CodeGenerator::CompileBlock(CodeBlock* block, CodeBlock::HostCodePointer* o
   m_block_start = block->instructions.data();
   m_block_end = block->instructions.data() + block->instructions.size();
 
+  FindDeadPGXPWrites();
+
   EmitBeginBlock();
   BlockPrologue();
 
@@ -1063,6 +1065,253 @@ void CodeGenerator::WriteNewPC(const Value& value, bool commit)
     m_next_pc_offset = 0;
 }
 
+namespace {
+struct PGXPRegisterUsage
+{
+  u64 reads;
+  u64 writes;
+  bool can_skip;
+};
+} // namespace
+
+static constexpr u64 PGXPRegBit(Reg reg)
+{
+  return (UINT64_C(1) << static_cast<u8>(reg));
+}
+
+static constexpr u64 PGXP_ALL_REGS = (UINT64_C(1) << static_cast<u8>(Reg::count)) - 1;
+
+/// Which PGXP CPU registers an instruction reads and writes, when tracking ALU instructions. Anything unknown is treated
+/// as reading everything, so this can only err towards keeping a write. PGXP tracks $zero like any other register, and
+/// the interpreter updates it for nops too. Only handlers which do no more than validate their sources can be skipped.
+/// The two-register ALU handlers make both sources valid when only one is, mthi/mtlo validate the rd field, loads
+/// validate the shadow memory, and mfc2/cfc2 validate the GTE register.
+static PGXPRegisterUsage GetPGXPRegisterUsage(const Instruction& inst)
+{
+  const u64 rs = PGXPRegBit(inst.r.rs);
+  const u64 rt = PGXPRegBit(inst.r.rt);
+  const u64 rd = PGXPRegBit(inst.r.rd);
+  const u64 hi = PGXPRegBit(Reg::hi);
+  const u64 lo = PGXPRegBit(Reg::lo);
+
+  switch (inst.op)
+  {
+    case InstructionOp::funct:
+    {
+      switch (inst.r.funct)
+      {
+        case InstructionFunct::sll:
+        case InstructionFunct::srl:
+        case InstructionFunct::sra:
+          return {rt, rd, true};
+
+        case InstructionFunct::sllv:
+        case InstructionFunct::srlv:
+        case InstructionFunct::srav:
+          return {rs | rt, rd, true};
+
+        case InstructionFunct::and_:
+        case InstructionFunct::or_:
+        case InstructionFunct::xor_:
+        case InstructionFunct::nor:
+        case InstructionFunct::add:
+        case InstructionFunct::addu:
+        case InstructionFunct::sub:
+        case InstructionFunct::subu:
+        case InstructionFunct::slt:
+        case InstructionFunct::sltu:
+          return {rs | rt, rd | rs | rt, false};
+
+        case InstructionFunct::mfhi:
+          return {hi, rd, true};
+        case InstructionFunct::mflo:
+          return {lo, rd, true};
+        case InstructionFunct::mthi:
+          return {rd, hi | rd, false};
+        case InstructionFunct::mtlo:
+          return {rd, lo | rd, false};
+
+        case InstructionFunct::mult:
+        case InstructionFunct::multu:
+        case InstructionFunct::div:
+        case InstructionFunct::divu:
+          return {rs | rt, hi | lo | rs | rt, false};
+
+        case InstructionFunct::jr:
+        case InstructionFunct::jalr:
+        case InstructionFunct::syscall:
+        case InstructionFunct::break_:
+          return {0, 0, false};
+
+        default:
+          return {PGXP_ALL_REGS, 0, false};
+      }
+    }
+
+    case InstructionOp::b:
+    case InstructionOp::j:
+    case InstructionOp::jal:
+    case InstructionOp::beq:
+    case InstructionOp::bne:
+    case InstructionOp::blez:
+    case InstructionOp::bgtz:
+      return {0, 0, false};
+
+    case InstructionOp::addi:
+    case InstructionOp::addiu:
+    case InstructionOp::slti:
+    case InstructionOp::sltiu:
+    case InstructionOp::andi:
+    case InstructionOp::ori:
+    case InstructionOp::xori:
+      return {rs, rt, true};
+
+    case InstructionOp::lui:
+      return {0, rt, true};
+
+    case InstructionOp::lb:
+    case InstructionOp::lbu:
+    case InstructionOp::lh:
+    case InstructionOp::lhu:
+    case InstructionOp::lw:
+    case InstructionOp::lwl:
+    case InstructionOp::lwr:
+      return {0, rt, false};
+
+    case InstructionOp::sb:
+      return {0, 0, false};
+
+    case InstructionOp::sh:
+    case InstructionOp::sw:
+    case InstructionOp::swl:
+    case InstructionOp::swr:
+      return {rt, 0, false};
+
+    case InstructionOp::cop0:
+    case InstructionOp::cop2:
+    {
+      if (!inst.cop.IsCommonInstruction())
+        return {0, 0, false};
+
+      switch (inst.cop.CommonOp())
+      {
+        case CopCommonInstruction::mfcn:
+        case CopCommonInstruction::cfcn:
+          return (inst.op == InstructionOp::cop2) ? PGXPRegisterUsage{0, rt, false} : PGXPRegisterUsage{0, 0, false};
+
+        case CopCommonInstruction::mtcn:
+        case CopCommonInstruction::ctcn:
+          return {rt, 0, false};
+
+        default:
+          return {0, 0, false};
+      }
+    }
+
+    case InstructionOp::lwc2:
+    case InstructionOp::swc2:
+      return {0, 0, false};
+
+    default:
+      return {PGXP_ALL_REGS, 0, false};
+  }
+}
+
+void CodeGenerator::FindDeadPGXPWrites()
+{
+  const size_t count = static_cast<size_t>(m_block_end - m_block_start);
+  m_pgxp_dead_writes.assign(count, false);
+  if (!g_settings.UsingPGXPCPUMode())
+    return;
+
+  // Walk backwards, everything is assumed to be read after the block, or when an instruction raises an exception.
+  u64 live = PGXP_ALL_REGS;
+  for (size_t i = count; i > 0; i--)
+  {
+    const CodeBlockInstruction& cbi = m_block_start[i - 1];
+    const PGXPRegisterUsage usage = GetPGXPRegisterUsage(cbi.instruction);
+    if (usage.can_skip && usage.writes != 0 && (usage.writes & live) == 0)
+      m_pgxp_dead_writes[i - 1] = true;
+    else
+      live = (live & ~usage.writes) | usage.reads;
+
+    if (cbi.can_trap)
+      live = PGXP_ALL_REGS;
+  }
+}
+
+bool CodeGenerator::IsPGXPWriteUsed(const CodeBlockInstruction& cbi) const
+{
+  return !m_pgxp_dead_writes[static_cast<size_t>(&cbi - m_block_start)];
+}
+
+void CodeGenerator::EmitPGXPSkippedWrite(const CodeBlockInstruction& cbi)
+{
+  // The handler would still have validated its sources, which matters if a later handler makes them valid again.
+  // The variable shift handlers are passed the masked shift amount, and validate rs against that.
+  const Instruction inst = cbi.instruction;
+  if (inst.op == InstructionOp::funct &&
+      (inst.r.funct == InstructionFunct::sllv || inst.r.funct == InstructionFunct::srlv ||
+       inst.r.funct == InstructionFunct::srav))
+  {
+    EmitPGXPValidate(inst.r.rt, m_register_cache.ReadGuestRegister(inst.r.rt));
+    EmitPGXPValidate(inst.r.rs,
+                     AndValues(m_register_cache.ReadGuestRegister(inst.r.rs), Value::FromConstantU32(0x1F)));
+    return;
+  }
+
+  const u64 reads = GetPGXPRegisterUsage(inst).reads;
+  for (u8 i = 0; i <= static_cast<u8>(Reg::lo); i++)
+  {
+    const Reg reg = static_cast<Reg>(i);
+    if (reads & PGXPRegBit(reg))
+      EmitPGXPValidate(reg, m_register_cache.ReadGuestRegister(reg));
+  }
+}
+
+Value CodeGenerator::EmitPGXPValidate(Reg reg, const Value& value)
+{
+  // Inline PGXP's Validate(). The valid flags are masked off without branching when the value is stale.
+  PGXP::PGXP_value* pgxp = PGXP::GetCPURegister(static_cast<u32>(reg));
+
+  Value flags = m_register_cache.AllocateScratch(RegSize_32);
+  Value temp = m_register_cache.AllocateScratch(RegSize_32);
+  EmitLoadGlobal(temp.GetHostRegister(), RegSize_32, &pgxp->value);
+  EmitCmp(temp.GetHostRegister(), value);
+  EmitSetConditionResult(temp.GetHostRegister(), RegSize_32, Condition::NotEqual);
+  EmitDec(temp.GetHostRegister(), RegSize_32);
+  EmitOr(temp.GetHostRegister(), temp.GetHostRegister(), Value::FromConstantU32(~PGXP::CPU_REGISTER_VALID_MASK));
+  EmitLoadGlobal(flags.GetHostRegister(), RegSize_32, &pgxp->flags);
+  EmitAnd(flags.GetHostRegister(), flags.GetHostRegister(), temp);
+  EmitStoreGlobal(&pgxp->flags, flags);
+  return flags;
+}
+
+void CodeGenerator::EmitPGXPMove(Reg dest, Reg src, const Value& src_value)
+{
+  // Inline PGXP::CPU_MOVE().
+  PGXP::PGXP_value* src_pgxp = PGXP::GetCPURegister(static_cast<u32>(src));
+  PGXP::PGXP_value* dest_pgxp = PGXP::GetCPURegister(static_cast<u32>(dest));
+
+  const Value flags = EmitPGXPValidate(src, src_value);
+  if (dest == src)
+    return;
+
+  Value temp = m_register_cache.AllocateScratch(RegSize_32);
+  for (u32 offset = 0; offset < sizeof(PGXP::PGXP_value); offset += sizeof(u32))
+  {
+    u8* dest_ptr = reinterpret_cast<u8*>(dest_pgxp) + offset;
+    if (offset == offsetof(PGXP::PGXP_value, flags))
+    {
+      EmitStoreGlobal(dest_ptr, flags);
+      continue;
+    }
+
+    EmitLoadGlobal(temp.GetHostRegister(), RegSize_32, reinterpret_cast<const u8*>(src_pgxp) + offset);
+    EmitStoreGlobal(dest_ptr, temp);
+  }
+}
+
 bool CodeGenerator::Compile_Fallback(const CodeBlockInstruction& cbi)
 {
   InstructionPrologue(cbi, 1, true);
@@ -1111,6 +1360,8 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
 
   SpeculativeValue spec_lhs, spec_rhs;
   SpeculativeValue spec_value;
+  const bool track_pgxp = g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi);
+  const Value pgxp_instr = Value::FromConstantU32(cbi.instruction.bits);
 
   if (op != InstructionOp::funct)
   {
@@ -1140,6 +1391,10 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
       result = OrValues(lhs, rhs);
       if (spec_lhs && spec_rhs)
         spec_value = *spec_lhs | *spec_rhs;
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_ORI, pgxp_instr, result, lhs);
+      else if (g_settings.UsingPGXPCPUMode())
+        EmitPGXPSkippedWrite(cbi);
     }
     break;
 
@@ -1148,6 +1403,10 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
       result = AndValues(lhs, rhs);
       if (spec_lhs && spec_rhs)
         spec_value = *spec_lhs & *spec_rhs;
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_ANDI, pgxp_instr, result, lhs);
+      else if (g_settings.UsingPGXPCPUMode())
+        EmitPGXPSkippedWrite(cbi);
     }
     break;
 
@@ -1156,6 +1415,10 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
       result = XorValues(lhs, rhs);
       if (spec_lhs && spec_rhs)
         spec_value = *spec_lhs ^ *spec_rhs;
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_XORI, pgxp_instr, result, lhs);
+      else if (g_settings.UsingPGXPCPUMode())
+        EmitPGXPSkippedWrite(cbi);
     }
     break;
 
@@ -1168,6 +1431,8 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
           result = OrValues(lhs, rhs);
           if (spec_lhs && spec_rhs)
             spec_value = *spec_lhs | *spec_rhs;
+          if (track_pgxp)
+            EmitFunctionCall(nullptr, &PGXP::CPU_OR_, pgxp_instr, result, lhs, rhs);
         }
         break;
 
@@ -1176,6 +1441,8 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
           result = AndValues(lhs, rhs);
           if (spec_lhs && spec_rhs)
             spec_value = *spec_lhs & *spec_rhs;
+          if (track_pgxp)
+            EmitFunctionCall(nullptr, &PGXP::CPU_AND_, pgxp_instr, result, lhs, rhs);
         }
         break;
 
@@ -1184,6 +1451,8 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
           result = XorValues(lhs, rhs);
           if (spec_lhs && spec_rhs)
             spec_value = *spec_lhs ^ *spec_rhs;
+          if (track_pgxp)
+            EmitFunctionCall(nullptr, &PGXP::CPU_XOR_, pgxp_instr, result, lhs, rhs);
         }
         break;
 
@@ -1192,6 +1461,8 @@ bool CodeGenerator::Compile_Bitwise(const CodeBlockInstruction& cbi)
           result = NotValue(OrValues(lhs, rhs));
           if (spec_lhs && spec_rhs)
             spec_value = ~(*spec_lhs | *spec_rhs);
+          if (track_pgxp)
+            EmitFunctionCall(nullptr, &PGXP::CPU_NOR, pgxp_instr, result, lhs, rhs);
         }
         break;
 
@@ -1272,6 +1543,38 @@ bool CodeGenerator::Compile_Shift(const CodeBlockInstruction& cbi)
       break;
   }
 
+  if (g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi))
+  {
+    const Value pgxp_instr = Value::FromConstantU32(cbi.instruction.bits);
+    switch (funct)
+    {
+      case InstructionFunct::sll:
+        EmitFunctionCall(nullptr, &PGXP::CPU_SLL, pgxp_instr, result, rt);
+        break;
+      case InstructionFunct::srl:
+        EmitFunctionCall(nullptr, &PGXP::CPU_SRL, pgxp_instr, result, rt);
+        break;
+      case InstructionFunct::sra:
+        EmitFunctionCall(nullptr, &PGXP::CPU_SRA, pgxp_instr, result, rt);
+        break;
+      default:
+      {
+        Value masked_shamt = AndValues(shamt, Value::FromConstantU32(0x1F));
+        if (funct == InstructionFunct::sllv)
+          EmitFunctionCall(nullptr, &PGXP::CPU_SLLV, pgxp_instr, result, rt, masked_shamt);
+        else if (funct == InstructionFunct::srlv)
+          EmitFunctionCall(nullptr, &PGXP::CPU_SRLV, pgxp_instr, result, rt, masked_shamt);
+        else
+          EmitFunctionCall(nullptr, &PGXP::CPU_SRAV, pgxp_instr, result, rt, masked_shamt);
+      }
+      break;
+    }
+  }
+  else if (g_settings.UsingPGXPCPUMode())
+  {
+    EmitPGXPSkippedWrite(cbi);
+  }
+
   m_register_cache.WriteGuestRegister(cbi.instruction.r.rd, std::move(result));
   SpeculativeWriteReg(cbi.instruction.r.rd, result_spec);
 
@@ -1301,7 +1604,7 @@ bool CodeGenerator::Compile_Load(const CodeBlockInstruction& cbi)
     {
       result = EmitLoadGuestMemory(cbi, address, address_spec, RegSize_8);
       ConvertValueSizeInPlace(&result, RegSize_32, (cbi.instruction.op == InstructionOp::lb));
-      if (g_settings.gpu_pgxp_enable)
+      if (g_settings.gpu_pgxp_enable && IsPGXPWriteUsed(cbi))
         EmitFunctionCall(nullptr, PGXP::CPU_LBx, Value::FromConstantU32(cbi.instruction.bits), result, address);
 
       if (address_spec)
@@ -1319,7 +1622,7 @@ bool CodeGenerator::Compile_Load(const CodeBlockInstruction& cbi)
       result = EmitLoadGuestMemory(cbi, address, address_spec, RegSize_16);
       ConvertValueSizeInPlace(&result, RegSize_32, (cbi.instruction.op == InstructionOp::lh));
 
-      if (g_settings.gpu_pgxp_enable)
+      if (g_settings.gpu_pgxp_enable && IsPGXPWriteUsed(cbi))
         EmitFunctionCall(nullptr, PGXP::CPU_LHx, Value::FromConstantU32(cbi.instruction.bits), result, address);
 
       if (address_spec)
@@ -1334,7 +1637,7 @@ bool CodeGenerator::Compile_Load(const CodeBlockInstruction& cbi)
     case InstructionOp::lw:
     {
       result = EmitLoadGuestMemory(cbi, address, address_spec, RegSize_32);
-      if (g_settings.gpu_pgxp_enable)
+      if (g_settings.gpu_pgxp_enable && IsPGXPWriteUsed(cbi))
         EmitFunctionCall(nullptr, PGXP::CPU_LW, Value::FromConstantU32(cbi.instruction.bits), result, address);
 
       if (address_spec)
@@ -1508,7 +1811,7 @@ bool CodeGenerator::Compile_LoadLeftRight(const CodeBlockInstruction& cbi)
 
   shift.ReleaseAndClear();
 
-  if (g_settings.gpu_pgxp_enable)
+  if (g_settings.gpu_pgxp_enable && IsPGXPWriteUsed(cbi))
     EmitFunctionCall(nullptr, PGXP::CPU_LW, Value::FromConstantU32(cbi.instruction.bits), mem, address);
 
   m_register_cache.WriteGuestRegisterDelayed(cbi.instruction.i.rt, std::move(mem));
@@ -1576,25 +1879,56 @@ bool CodeGenerator::Compile_MoveHiLo(const CodeBlockInstruction& cbi)
 {
   InstructionPrologue(cbi, 1);
 
+  const bool track_pgxp = g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi);
+  const Value pgxp_instr = Value::FromConstantU32(cbi.instruction.bits);
+
   switch (cbi.instruction.r.funct)
   {
     case InstructionFunct::mfhi:
-      m_register_cache.WriteGuestRegister(cbi.instruction.r.rd, m_register_cache.ReadGuestRegister(Reg::hi));
+    {
+      Value hi = m_register_cache.ReadGuestRegister(Reg::hi);
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_MFHI, pgxp_instr, hi, hi);
+      else if (g_settings.UsingPGXPCPUMode())
+        EmitPGXPSkippedWrite(cbi);
+
+      m_register_cache.WriteGuestRegister(cbi.instruction.r.rd, std::move(hi));
       SpeculativeWriteReg(cbi.instruction.r.rd, std::nullopt);
-      break;
+    }
+    break;
 
     case InstructionFunct::mthi:
-      m_register_cache.WriteGuestRegister(Reg::hi, m_register_cache.ReadGuestRegister(cbi.instruction.r.rs));
-      break;
+    {
+      Value rs = m_register_cache.ReadGuestRegister(cbi.instruction.r.rs);
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_MTHI, pgxp_instr, rs, rs);
+
+      m_register_cache.WriteGuestRegister(Reg::hi, std::move(rs));
+    }
+    break;
 
     case InstructionFunct::mflo:
-      m_register_cache.WriteGuestRegister(cbi.instruction.r.rd, m_register_cache.ReadGuestRegister(Reg::lo));
+    {
+      Value lo = m_register_cache.ReadGuestRegister(Reg::lo);
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_MFLO, pgxp_instr, lo, lo);
+      else if (g_settings.UsingPGXPCPUMode())
+        EmitPGXPSkippedWrite(cbi);
+
+      m_register_cache.WriteGuestRegister(cbi.instruction.r.rd, std::move(lo));
       SpeculativeWriteReg(cbi.instruction.r.rd, std::nullopt);
-      break;
+    }
+    break;
 
     case InstructionFunct::mtlo:
-      m_register_cache.WriteGuestRegister(Reg::lo, m_register_cache.ReadGuestRegister(cbi.instruction.r.rs));
-      break;
+    {
+      Value rs = m_register_cache.ReadGuestRegister(cbi.instruction.r.rs);
+      if (track_pgxp)
+        EmitFunctionCall(nullptr, &PGXP::CPU_MTLO, pgxp_instr, rs, rs);
+
+      m_register_cache.WriteGuestRegister(Reg::lo, std::move(rs));
+    }
+    break;
 
     default:
       UnreachableCode();
@@ -1652,16 +1986,41 @@ bool CodeGenerator::Compile_Add(const CodeBlockInstruction& cbi)
   }
 
   // detect register moves and handle them for pgxp
-  if (g_settings.gpu_pgxp_enable && rhs.HasConstantValue(0))
-  {
-    EmitFunctionCall(nullptr, &PGXP::CPU_MOVE,
-                     Value::FromConstantU32((static_cast<u32>(dest) << 8) | (static_cast<u32>(lhs_src))), lhs);
-  }
+  const bool is_move = rhs.HasConstantValue(0);
+  if (g_settings.gpu_pgxp_enable && !g_settings.UsingPGXPCPUMode() && is_move)
+    EmitPGXPMove(dest, lhs_src, lhs);
 
   Value result = AddValues(lhs, rhs, check_overflow);
   if (check_overflow)
     GenerateExceptionExit(cbi, Exception::Ov, Condition::Overflow);
 
+  if (g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi))
+  {
+    const Value pgxp_instr = Value::FromConstantU32(cbi.instruction.bits);
+    if (is_move)
+    {
+      // With a zero rhs, the add handlers validate both sources, copy rs and set the value from the result.
+      if (cbi.instruction.op == InstructionOp::funct)
+        EmitPGXPValidate(cbi.instruction.r.rt, rhs);
+
+      EmitPGXPMove(dest, lhs_src, lhs);
+      EmitStoreGlobal(&PGXP::GetCPURegister(static_cast<u32>(dest))->value, result);
+    }
+    else if (cbi.instruction.op != InstructionOp::funct)
+    {
+      EmitFunctionCall(nullptr, (cbi.instruction.op == InstructionOp::addi) ? &PGXP::CPU_ADDI : &PGXP::CPU_ADDIU,
+                       pgxp_instr, result, lhs);
+    }
+    else
+    {
+      EmitFunctionCall(nullptr, check_overflow ? &PGXP::CPU_ADD : &PGXP::CPU_ADDU, pgxp_instr, result, lhs, rhs);
+    }
+  }
+  else if (g_settings.UsingPGXPCPUMode())
+  {
+    EmitPGXPSkippedWrite(cbi);
+  }
+
   m_register_cache.WriteGuestRegister(dest, std::move(result));
 
   SpeculativeValue value_spec;
@@ -1690,6 +2049,12 @@ bool CodeGenerator::Compile_Subtract(const CodeBlockInstruction& cbi)
   if (check_overflow)
     GenerateExceptionExit(cbi, Exception::Ov, Condition::Overflow);
 
+  if (g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi))
+  {
+    EmitFunctionCall(nullptr, check_overflow ? &PGXP::CPU_SUB : &PGXP::CPU_SUBU,
+                     Value::FromConstantU32(cbi.instruction.bits), result, lhs, rhs);
+  }
+
   m_register_cache.WriteGuestRegister(cbi.instruction.r.rd, std::move(result));
 
   SpeculativeValue value_spec;
@@ -1706,8 +2071,15 @@ bool CodeGenerator::Compile_Multiply(const CodeBlockInstruction& cbi)
   InstructionPrologue(cbi, 1);
 
   const bool signed_multiply = (cbi.instruction.r.funct == InstructionFunct::mult);
-  std::pair<Value, Value> result = MulValues(m_register_cache.ReadGuestRegister(cbi.instruction.r.rs),
-                                             m_register_cache.ReadGuestRegister(cbi.instruction.r.rt), signed_multiply);
+  Value rs = m_register_cache.ReadGuestRegister(cbi.instruction.r.rs);
+  Value rt = m_register_cache.ReadGuestRegister(cbi.instruction.r.rt);
+  if (g_settings.UsingPGXPCPUMode())
+  {
+    EmitFunctionCall(nullptr, signed_multiply ? &PGXP::CPU_MULT : &PGXP::CPU_MULTU,
+                     Value::FromConstantU32(cbi.instruction.bits), rs, rt);
+  }
+
+  std::pair<Value, Value> result = MulValues(rs, rt, signed_multiply);
   m_register_cache.WriteGuestRegister(Reg::hi, std::move(result.first));
   m_register_cache.WriteGuestRegister(Reg::lo, std::move(result.second));
 
@@ -1764,6 +2136,9 @@ bool CodeGenerator::Compile_Divide(const CodeBlockInstruction& cbi)
 
   Value num = m_register_cache.ReadGuestRegister(cbi.instruction.r.rs);
   Value denom = m_register_cache.ReadGuestRegister(cbi.instruction.r.rt);
+  if (g_settings.UsingPGXPCPUMode())
+    EmitFunctionCall(nullptr, &PGXP::CPU_DIVU, Value::FromConstantU32(cbi.instruction.bits), num, denom);
+
   if (num.IsConstant() && denom.IsConstant())
   {
     const auto [lo, hi] = MIPSDivide(static_cast<u32>(num.constant_value), static_cast<u32>(denom.constant_value));
@@ -1821,6 +2196,9 @@ bool CodeGenerator::Compile_SignedDivide(const CodeBlockInstruction& cbi)
 
   Value num = m_register_cache.ReadGuestRegister(cbi.instruction.r.rs);
   Value denom = m_register_cache.ReadGuestRegister(cbi.instruction.r.rt);
+  if (g_settings.UsingPGXPCPUMode())
+    EmitFunctionCall(nullptr, &PGXP::CPU_DIV, Value::FromConstantU32(cbi.instruction.bits), num, denom);
+
   if (num.IsConstant() && denom.IsConstant())
   {
     const auto [lo, hi] = MIPSDivide(num.GetS32ConstantValue(), denom.GetS32ConstantValue());
@@ -1938,6 +2316,22 @@ bool CodeGenerator::Compile_SetLess(const CodeBlockInstruction& cbi)
   Value result = m_register_cache.AllocateScratch(RegSize_32);
   EmitCmp(lhs.host_reg, rhs);
   EmitSetConditionResult(result.host_reg, result.size, signed_comparison ? Condition::Less : Condition::Below);
+
+  if (g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi))
+  {
+    const Value pgxp_instr = Value::FromConstantU32(cbi.instruction.bits);
+    if (cbi.instruction.op == InstructionOp::slti)
+      EmitFunctionCall(nullptr, &PGXP::CPU_SLTI, pgxp_instr, result, lhs);
+    else if (cbi.instruction.op == InstructionOp::sltiu)
+      EmitFunctionCall(nullptr, &PGXP::CPU_SLTIU, pgxp_instr, result, lhs);
+    else
+      EmitFunctionCall(nullptr, signed_comparison ? &PGXP::CPU_SLT : &PGXP::CPU_SLTU, pgxp_instr, result, lhs, rhs);
+  }
+  else if (g_settings.UsingPGXPCPUMode())
+  {
+    EmitPGXPSkippedWrite(cbi);
+  }
+
   m_register_cache.WriteGuestRegister(dest, std::move(result));
 
   SpeculativeValue value_spec;
@@ -2161,6 +2555,12 @@ bool CodeGenerator::Compile_lui(const CodeBlockInstruction& cbi)
 
   // rt <- (imm << 16)
   const u32 value = cbi.instruction.i.imm_zext32() << 16;
+  if (g_settings.UsingPGXPCPUMode() && IsPGXPWriteUsed(cbi))
+  {
+    EmitFunctionCall(nullptr, &PGXP::CPU_LUI, Value::FromConstantU32(cbi.instruction.bits),
+                     Value::FromConstantU32(value));
+  }
+
   m_register_cache.WriteGuestRegister(cbi.instruction.i.rt, Value::FromConstantU32(value));
   SpeculativeWriteReg(cbi.instruction.i.rt, value);
 
@@ -2245,6 +2645,14 @@ bool CodeGenerator::Compile_cop0(const CodeBlockInstruction& cbi)
           // coprocessor loads are load-delayed
           Value value = m_register_cache.AllocateScratch(RegSize_32);
           EmitLoadCPUStructField(value.host_reg, value.size, offset);
+
+          // Same arguments as the interpreter, including the rs field.
+          if (g_settings.UsingPGXPCPUMode())
+          {
+            EmitFunctionCall(nullptr, &PGXP::CPU_MFC0, Value::FromConstantU32(cbi.instruction.bits), value,
+                             m_register_cache.ReadGuestRegister(cbi.instruction.i.rs));
+          }
+
           m_register_cache.WriteGuestRegisterDelayed(cbi.instruction.r.rt, std::move(value));
           SpeculativeWriteReg(cbi.instruction.r.rt, std::nullopt);
         }
@@ -2279,6 +2687,15 @@ bool CodeGenerator::Compile_cop0(const CodeBlockInstruction& cbi)
               EmitStoreCPUStructField(offset, value);
             }
           }
+
+          // The interpreter passes the register's value after the write, so read-only registers are unchanged.
+          if (g_settings.UsingPGXPCPUMode())
+          {
+            Value cop0_value = m_register_cache.AllocateScratch(RegSize_32);
+            EmitLoadCPUStructField(cop0_value.host_reg, RegSize_32, offset);
+            EmitFunctionCall(nullptr, &PGXP::CPU_MTC0, Value::FromConstantU32(cbi.instruction.bits), cop0_value,
+                             m_register_cache.ReadGuestRegister(cbi.instruction.i.rs));
+          }
         }
 
         if (cbi.instruction.cop.CommonOp() == CopCommonInstruction::mtcn &&
@@ -2377,7 +2794,7 @@ Value CodeGenerator::DoGTERegisterRead(u32 index)
 
     default:
     {
-      EmitLoadCPUStructField(value.host_reg, RegSize_32, offsetof(State, gte_regs.r32[index]));
+      EmitLoadCPUStructField(value.host_reg, RegSize_32, offsetof(State, gte_regs.r32[0]) + (index * sizeof(u32)));
     }
     break;
   }
@@ -2406,7 +2823,7 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     {
       // sign-extend z component of vector registers
       Value temp = ConvertValueSize(value.ViewAsSize(RegSize_16), RegSize_32, true);
-      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[index]), temp);
+      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[0]) + (index * sizeof(u32)), temp);
       return;
     }
     break;
@@ -2419,7 +2836,7 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     {
       // zero-extend unsigned values
       Value temp = ConvertValueSize(value.ViewAsSize(RegSize_16), RegSize_32, false);
-      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[index]), temp);
+      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[0]) + (index * sizeof(u32)), temp);
       return;
     }
     break;
@@ -2461,7 +2878,7 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     default:
     {
       // written as-is, 2x16 or 1x32 bits
-      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[index]), value);
+      EmitStoreCPUStructField(offsetof(State, gte_regs.r32[0]) + (index * sizeof(u32)), value);
       return;
     }
   }
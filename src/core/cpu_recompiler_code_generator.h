@@ -2,6 +2,7 @@
 #include <array>
 #include <initializer_list>
 #include <utility>
+#include <vector>
 
 #include "common/jit_code_buffer.h"
 
@@ -206,6 +207,13 @@ private:
   Value DoGTERegisterRead(u32 index);
   void DoGTERegisterWrite(u32 index, const Value& value);
 
+  // PGXP
+  void FindDeadPGXPWrites();
+  bool IsPGXPWriteUsed(const CodeBlockInstruction& cbi) const;
+  void EmitPGXPSkippedWrite(const CodeBlockInstruction& cbi);
+  Value EmitPGXPValidate(Reg reg, const Value& value);
+  void EmitPGXPMove(Reg dest, Reg src, const Value& src_value);
+
   //////////////////////////////////////////////////////////////////////////
   // Instruction Code Generators
   //////////////////////////////////////////////////////////////////////////
@@ -254,6 +262,9 @@ private:
   bool m_fastmem_load_base_in_register = false;
   bool m_fastmem_store_base_in_register = false;
 
+  // instructions whose PGXP result is overwritten before anything reads it, indexed from the start of the block.
+  std::vector<bool> m_pgxp_dead_writes;
+
   //////////////////////////////////////////////////////////////////////////
   // Speculative Constants
   //////////////////////////////////////////////////////////////////////////
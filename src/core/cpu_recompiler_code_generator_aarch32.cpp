@@ -1392,6 +1392,13 @@ void CodeGenerator::EmitStoreGuestMemoryFastmem(const CodeBlockInstruction& cbi,
       break;
   }
 
+  // Flag the page for incremental memory states, the store didn't go through the bus. This is part of the backpatched
+  // region, since the slowmem path flags the page itself.
+  m_emit->ubfx(GetHostReg32(RARG1), GetHostReg32(address_reg), 12, 9);
+  EmitLoadGlobalAddress(RARG2, Bus::m_ram_dirty_pages.data());
+  m_emit->Mov(GetHostReg32(RARG3), 1);
+  m_emit->strb(GetHostReg32(RARG3), a32::MemOperand(GetHostReg32(RARG2), GetHostReg32(RARG1)));
+
   bpi.host_code_size = static_cast<u32>(
     static_cast<ptrdiff_t>(static_cast<u8*>(GetCurrentNearCodePointer()) - static_cast<u8*>(bpi.host_pc)));
 
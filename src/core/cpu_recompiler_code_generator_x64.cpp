@@ -2206,6 +2206,22 @@ void CodeGenerator::EmitStoreGuestMemoryFastmem(const CodeBlockInstruction& cbi,
     }
   }
 
+  // Flag the page for incremental memory states, the store didn't go through the bus. This is part of the backpatched
+  // region, since the slowmem path flags the page itself.
+  if (address.IsConstant())
+  {
+    EmitLoadGlobalAddress(RARG1, &Bus::m_ram_dirty_pages[Bus::GetRAMCodePageIndex(address.constant_value)]);
+    m_emit->mov(m_emit->byte[GetHostReg64(RARG1)], 1);
+  }
+  else
+  {
+    m_emit->mov(GetHostReg32(RARG1), GetHostReg32(address.host_reg));
+    m_emit->shr(GetHostReg32(RARG1), 12);
+    m_emit->and_(GetHostReg32(RARG1), Bus::RAM_MASK >> 12);
+    EmitLoadGlobalAddress(RARG2, Bus::m_ram_dirty_pages.data());
+    m_emit->mov(m_emit->byte[GetHostReg64(RARG1) + GetHostReg64(RARG2)], 1);
+  }
+
   // insert nops, we need at least 5 bytes for a relative jump
   const u32 fastmem_size =
     static_cast<u32>(static_cast<u8*>(GetCurrentNearCodePointer()) - static_cast<u8*>(bpi.host_pc));
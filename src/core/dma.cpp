@@ -300,6 +300,12 @@ bool DMA::TransferChannel(Channel channel)
         const u32 next_address = header & UINT32_C(0x00FFFFFF);
         Log_TracePrintf(" .. linked list entry at 0x%08X size=%u(%u words) next=0x%08X", current_address & ADDRESS_MASK,
                         word_count * UINT32_C(4), word_count, next_address);
+
+#if defined(__GNUC__) || defined(__clang__)
+        // the next header is usually elsewhere in RAM, start fetching it while this packet is sent
+        __builtin_prefetch(&ram_pointer[next_address & ADDRESS_MASK]);
+#endif
+
         if (word_count > 0)
         {
           used_ticks += 5;
@@ -431,6 +437,64 @@ void DMA::UnhaltTransfer(TickCount ticks)
   m_halt_ticks_remaining = 0;
 }
 
+/// Returns how many words of a transfer can be accessed before the address wraps around the end of RAM. Reverse
+/// transfers run downwards from the start address.
+static u32 GetContiguousWordCount(u32 address, u32 increment, u32 word_count)
+{
+  const u32 words_available = (static_cast<s32>(increment) < 0) ? ((address / sizeof(u32)) + 1) :
+                                                                    ((Bus::RAM_SIZE - address) / sizeof(u32));
+  return std::min(word_count, words_available);
+}
+
+void DMA::ReadRAMWords(u32* words, u32 address, u32 increment, u32 word_count)
+{
+  u8* ram_pointer = Bus::g_ram;
+  while (word_count > 0)
+  {
+    const u32 count = GetContiguousWordCount(address, increment, word_count);
+    if (static_cast<s32>(increment) > 0)
+    {
+      std::memcpy(words, &ram_pointer[address], count * sizeof(u32));
+    }
+    else
+    {
+      for (u32 i = 0; i < count; i++)
+        std::memcpy(&words[i], &ram_pointer[address - i * sizeof(u32)], sizeof(u32));
+    }
+
+    address = (address + increment * count) & ADDRESS_MASK;
+    words += count;
+    word_count -= count;
+  }
+}
+
+void DMA::WriteRAMWords(const u32* words, u32 address, u32 increment, u32 word_count)
+{
+  u8* ram_pointer = Bus::g_ram;
+  while (word_count > 0)
+  {
+    const u32 count = GetContiguousWordCount(address, increment, word_count);
+    u32 start_address = address;
+    if (static_cast<s32>(increment) > 0)
+    {
+      std::memcpy(&ram_pointer[address], words, count * sizeof(u32));
+    }
+    else
+    {
+      start_address = address - (count - 1) * sizeof(u32);
+      for (u32 i = 0; i < count; i++)
+        std::memcpy(&ram_pointer[address - i * sizeof(u32)], &words[i], sizeof(u32));
+    }
+
+    Bus::MarkRAMPagesDirty(start_address, count * sizeof(u32));
+    CPU::CodeCache::InvalidateCodePages(start_address, count);
+
+    address = (address + increment * count) & ADDRESS_MASK;
+    words += count;
+    word_count -= count;
+  }
+}
+
 TickCount DMA::TransferMemoryToDevice(Channel channel, u32 address, u32 increment, u32 word_count)
 {
   const u32* src_pointer = reinterpret_cast<u32*>(Bus::g_ram + address);
@@ -441,13 +505,7 @@ TickCount DMA::TransferMemoryToDevice(Channel channel, u32 address, u32 incremen
     if (m_transfer_buffer.size() < word_count)
       m_transfer_buffer.resize(word_count);
     src_pointer = m_transfer_buffer.data();
-
-    u8* ram_pointer = Bus::g_ram;
-    for (u32 i = 0; i < word_count; i++)
-    {
-      std::memcpy(&m_transfer_buffer[i], &ram_pointer[address], sizeof(u32));
-      address = (address + increment) & ADDRESS_MASK;
-    }
+    ReadRAMWords(m_transfer_buffer.data(), address, increment, word_count);
   }
 
   switch (channel)
@@ -457,12 +515,20 @@ TickCount DMA::TransferMemoryToDevice(Channel channel, u32 address, u32 incremen
       if (g_gpu->BeginDMAWrite())
       {
         u8* ram_pointer = Bus::g_ram;
-        for (u32 i = 0; i < word_count; i++)
+        if (increment == sizeof(u32) && GetContiguousWordCount(address, increment, word_count) == word_count)
+        {
+          // linked list packets and block transfers, which don't wrap
+          g_gpu->DMAWrite(address, reinterpret_cast<const u32*>(&ram_pointer[address]), word_count);
+        }
+        else
         {
-          u32 value;
-          std::memcpy(&value, &ram_pointer[address], sizeof(u32));
-          g_gpu->DMAWrite(address, value);
-          address = (address + increment) & ADDRESS_MASK;
+          for (u32 i = 0; i < word_count; i++)
+          {
+            u32 value;
+            std::memcpy(&value, &ram_pointer[address], sizeof(u32));
+            g_gpu->DMAWrite(address, value);
+            address = (address + increment) & ADDRESS_MASK;
+          }
         }
         g_gpu->EndDMAWrite();
       }
@@ -492,18 +558,34 @@ TickCount DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 incremen
 {
   if (channel == Channel::OTC)
   {
-    // clear ordering table
+    // clear ordering table, each entry points to the one below it, and the lowest one is the terminator
     u8* ram_pointer = Bus::g_ram;
     const u32 word_count_less_1 = word_count - 1;
-    for (u32 i = 0; i < word_count_less_1; i++)
+    if (word_count_less_1 <= (address / sizeof(u32)))
     {
-      u32 value = ((address - 4) & ADDRESS_MASK);
-      std::memcpy(&ram_pointer[address], &value, sizeof(value));
-      address = (address - 4) & ADDRESS_MASK;
+      // fill upwards from the terminator, which vectorizes
+      const u32 start_address = address - word_count_less_1 * sizeof(u32);
+      u32* table = reinterpret_cast<u32*>(&ram_pointer[start_address]);
+      table[0] = UINT32_C(0xFFFFFF);
+      for (u32 i = 0; i < word_count_less_1; i++)
+        table[i + 1] = start_address + i * sizeof(u32);
+
+      address = start_address;
     }
+    else
+    {
+      for (u32 i = 0; i < word_count_less_1; i++)
+      {
+        u32 value = ((address - 4) & ADDRESS_MASK);
+        std::memcpy(&ram_pointer[address], &value, sizeof(value));
+        address = (address - 4) & ADDRESS_MASK;
+      }
 
-    const u32 terminator = UINT32_C(0xFFFFFF);
-    std::memcpy(&ram_pointer[address], &terminator, sizeof(terminator));
+      const u32 terminator = UINT32_C(0xFFFFFF);
+      std::memcpy(&ram_pointer[address], &terminator, sizeof(terminator));
+    }
+
+    Bus::MarkRAMPagesDirty(address, word_count * sizeof(u32));
     CPU::CodeCache::InvalidateCodePages(address, word_count);
     return Bus::GetDMARAMTickCount(word_count);
   }
@@ -544,15 +626,14 @@ TickCount DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 incremen
 
   if (dest_pointer == m_transfer_buffer.data())
   {
-    u8* ram_pointer = Bus::g_ram;
-    for (u32 i = 0; i < word_count; i++)
-    {
-      std::memcpy(&ram_pointer[address], &m_transfer_buffer[i], sizeof(u32));
-      address = (address + increment) & ADDRESS_MASK;
-    }
+    WriteRAMWords(m_transfer_buffer.data(), address, increment, word_count);
+  }
+  else
+  {
+    Bus::MarkRAMPagesDirty(address, word_count * sizeof(u32));
+    CPU::CodeCache::InvalidateCodePages(address, word_count);
   }
 
-  CPU::CodeCache::InvalidateCodePages(address, word_count);
   return Bus::GetDMARAMTickCount(word_count);
 }
 
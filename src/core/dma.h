@@ -76,6 +76,10 @@ private:
   // from memory -> device
   TickCount TransferMemoryToDevice(Channel channel, u32 address, u32 increment, u32 word_count);
 
+  // copies words between RAM and a buffer a contiguous run at a time, following the transfer's direction and wrapping
+  static void ReadRAMWords(u32* words, u32 address, u32 increment, u32 word_count);
+  static void WriteRAMWords(const u32* words, u32 address, u32 increment, u32 word_count);
+
   // configuration
   TickCount m_max_slice_ticks = 1000;
   TickCount m_halt_ticks = 100;
@@ -7,6 +7,7 @@
 #include "host_display.h"
 #include "host_interface.h"
 #include "interrupt_controller.h"
+#include "perf_timers.h"
 #include "settings.h"
 #include "stb_image_write.h"
 #include "system.h"
@@ -75,6 +76,7 @@ void GPU::Reset()
   SoftReset();
   m_set_texture_disable_mask = false;
   m_GPUREAD_latch = 0;
+  m_snapshot_dirty_rect.Set(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
 }
 
 void GPU::SoftReset()
@@ -114,7 +116,7 @@ void GPU::SoftReset()
   UpdateCommandTickEvent();
 }
 
-bool GPU::DoState(StateWrapper& sw, bool update_display)
+bool GPU::DoState(StateWrapper& sw, u16* vram_snapshot, bool incremental, bool update_display)
 {
   if (sw.IsReading())
   {
@@ -214,10 +216,19 @@ bool GPU::DoState(StateWrapper& sw, bool update_display)
 
   if (sw.IsReading())
   {
-    // Still need a temporary here.
-    HeapArray<u16, VRAM_WIDTH * VRAM_HEIGHT> temp;
-    sw.DoBytes(temp.data(), VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
-    UpdateVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT, temp.data(), false, false);
+    if (vram_snapshot)
+    {
+      // The reset above has cleared VRAM in the backend, so the whole snapshot has to be uploaded regardless.
+      UpdateVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT, vram_snapshot, false, false);
+      m_snapshot_dirty_rect.SetInvalid();
+    }
+    else
+    {
+      // Still need a temporary here.
+      HeapArray<u16, VRAM_WIDTH * VRAM_HEIGHT> temp;
+      sw.DoBytes(temp.data(), VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
+      UpdateVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT, temp.data(), false, false);
+    }
 
     UpdateCRTCConfig();
     if (update_display)
@@ -228,13 +239,44 @@ bool GPU::DoState(StateWrapper& sw, bool update_display)
   }
   else
   {
-    ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
-    sw.DoBytes(m_vram_ptr, VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
+    if (vram_snapshot && incremental)
+    {
+      // Only the area which has been written since the snapshot was last synced needs to be read back.
+      if (m_snapshot_dirty_rect.HasExtents())
+      {
+        const Common::Rectangle<u32>& rc = m_snapshot_dirty_rect;
+        ReadVRAM(rc.left, rc.top, rc.GetWidth(), rc.GetHeight());
+        for (u32 row = rc.top; row < rc.bottom; row++)
+        {
+          const u32 offset = row * VRAM_WIDTH + rc.left;
+          std::memcpy(vram_snapshot + offset, m_vram_ptr + offset, rc.GetWidth() * sizeof(u16));
+        }
+      }
+    }
+    else
+    {
+      ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+      if (vram_snapshot)
+        std::memcpy(vram_snapshot, m_vram_ptr, VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
+      else
+        sw.DoBytes(m_vram_ptr, VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
+    }
+
+    if (vram_snapshot)
+      m_snapshot_dirty_rect.SetInvalid();
   }
 
   return !sw.HasError();
 }
 
+const u16* GPU::ReadbackVRAM()
+{
+  RestoreGraphicsAPIState();
+  ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  ResetGraphicsAPIState();
+  return m_vram_ptr;
+}
+
 void GPU::ResetGraphicsAPIState() {}
 
 void GPU::RestoreGraphicsAPIState() {}
@@ -362,6 +404,31 @@ void GPU::DMARead(u32* words, u32 word_count)
     words[i] = ReadGPUREAD();
 }
 
+void GPU::DMAWrite(u32 address, const u32* words, u32 word_count)
+{
+  // Words from consecutive addresses are written straight into the FIFO's storage, a contiguous run at a time.
+  while (word_count > 0)
+  {
+    const u32 count = std::min(word_count, std::min(m_fifo.GetSpace(), m_fifo.GetContiguousSpace()));
+    if (count == 0)
+    {
+      // overflowing, let Push() deal with it
+      for (u32 i = 0; i < word_count; i++)
+        DMAWrite(address + i * sizeof(u32), words[i]);
+      return;
+    }
+
+    u64* fifo_pointer = m_fifo.GetWritePointer();
+    for (u32 i = 0; i < count; i++)
+      fifo_pointer[i] = (ZeroExtend64(address + i * sizeof(u32)) << 32) | ZeroExtend64(words[i]);
+
+    m_fifo.AdvanceTail(count);
+    address += count * sizeof(u32);
+    words += count;
+    word_count -= count;
+  }
+}
+
 void GPU::EndDMAWrite()
 {
   m_fifo_pushed = true;
@@ -842,8 +909,12 @@ void GPU::CRTCTickEvent(TickCount ticks)
         g_interrupt_controller.InterruptRequest(InterruptController::IRQ::VBLANK);
 
         // flush any pending draws and "scan out" the image
-        FlushRender();
-        UpdateDisplay();
+        {
+          PERF_TIMER_SCOPE(GPU);
+          FlushRender();
+          if (!m_skip_display_updates)
+            UpdateDisplay();
+        }
         System::FrameDone();
 
         // switch fields early. this is needed so we draw to the correct one.
@@ -1225,6 +1296,35 @@ void GPU::ClearDisplay() {}
 
 void GPU::UpdateDisplay() {}
 
+void GPU::AddSnapshotDirtyRectangle(u32 x, u32 y, u32 width, u32 height)
+{
+  // Writes which wrap around the edge of VRAM are rare enough to just widen the area to the whole row/column span.
+  u32 right = x + width;
+  u32 bottom = y + height;
+  if (right > VRAM_WIDTH)
+  {
+    x = 0;
+    right = VRAM_WIDTH;
+  }
+  if (bottom > VRAM_HEIGHT)
+  {
+    y = 0;
+    bottom = VRAM_HEIGHT;
+  }
+
+  m_snapshot_dirty_rect.Include(x, right, y, bottom);
+}
+
+void GPU::AddSnapshotDirtyDrawingArea()
+{
+  // The drawing area is inclusive of the bottom-right coordinates.
+  if (m_drawing_area.Valid())
+  {
+    m_snapshot_dirty_rect.Include(m_drawing_area.left, std::min<u32>(m_drawing_area.right + 1, VRAM_WIDTH),
+                                  m_drawing_area.top, std::min<u32>(m_drawing_area.bottom + 1, VRAM_HEIGHT));
+  }
+}
+
 void GPU::ReadVRAM(u32 x, u32 y, u32 width, u32 height) {}
 
 void GPU::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
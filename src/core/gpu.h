@@ -76,7 +76,13 @@ public:
 
   virtual bool Initialize(HostDisplay* host_display);
   virtual void Reset();
-  virtual bool DoState(StateWrapper& sw, bool update_display);
+
+  // If vram_snapshot is set, VRAM is copied to/from it instead of going through the state wrapper. If incremental is
+  // also set, the snapshot must match VRAM as of the last snapshot save/load, so only the changed area is saved.
+  virtual bool DoState(StateWrapper& sw, u16* vram_snapshot, bool incremental, bool update_display);
+
+  // Reads back VRAM from the renderer, and returns the CPU-side copy.
+  const u16* ReadbackVRAM();
 
   // Graphics API state reset/restore - call when drawing the UI etc.
   virtual void ResetGraphicsAPIState();
@@ -99,6 +105,7 @@ public:
   {
     m_fifo.Push((ZeroExtend64(address) << 32) | ZeroExtend64(value));
   }
+  void DMAWrite(u32 address, const u32* words, u32 word_count);
   void EndDMAWrite();
 
   /// Returns true if no data is being sent from VRAM to the DAC or that no portion of VRAM would be visible on screen.
@@ -119,6 +126,9 @@ public:
     return (!m_force_progressive_scan) && m_GPUSTAT.SkipDrawingToActiveField();
   }
 
+  /// Skips scanning out to the host display at vblank, for frames which will never be presented.
+  ALWAYS_INLINE void SetDisplayUpdatesSkipped(bool skipped) { m_skip_display_updates = skipped; }
+
   /// Returns the number of pending GPU ticks.
   TickCount GetPendingCRTCTicks() const;
   TickCount GetPendingCommandTicks() const;
@@ -294,6 +304,10 @@ protected:
   virtual void UpdateDisplay();
   virtual void DrawRendererStats(bool is_idle_frame);
 
+  /// Includes an area of VRAM in the area modified since the last memory state snapshot.
+  void AddSnapshotDirtyRectangle(u32 x, u32 y, u32 width, u32 height);
+  void AddSnapshotDirtyDrawingArea();
+
   ALWAYS_INLINE void AddDrawTriangleTicks(s32 x1, s32 y1, s32 x2, s32 y2, s32 x3, s32 y3, bool shaded, bool textured,
                                           bool semitransparent)
   {
@@ -441,6 +455,9 @@ protected:
 
   Common::Rectangle<u32> m_drawing_area{0, 0, VRAM_WIDTH, VRAM_HEIGHT};
 
+  // Area of VRAM written since the last memory state snapshot.
+  Common::Rectangle<u32> m_snapshot_dirty_rect{0, 0, VRAM_WIDTH, VRAM_HEIGHT};
+
   struct DrawingOffset
   {
     s32 x;
@@ -538,6 +555,9 @@ protected:
   bool m_syncing = false;
   bool m_fifo_pushed = false;
 
+  /// True if the frame being run won't be presented.
+  bool m_skip_display_updates = false;
+
   struct VRAMTransfer
   {
     u16 x;
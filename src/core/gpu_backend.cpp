@@ -2,6 +2,7 @@
 #include "common/align.h"
 #include "common/log.h"
 #include "common/state_wrapper.h"
+#include "perf_timers.h"
 #include "settings.h"
 Log_SetChannel(GPUBackend);
 
@@ -147,7 +148,10 @@ void GPUBackend::PushCommand(GPUBackendCommand* cmd)
   {
     // single-thread mode
     if (cmd->type != GPUBackendCommandType::Sync)
+    {
+      PERF_TIMER_SAMPLED_SCOPE(GPUBackend);
       HandleCommand(cmd);
+    }
   }
   else
   {
@@ -223,6 +227,10 @@ void GPUBackend::RunGPULoop()
     if (write_ptr < read_ptr)
       write_ptr = COMMAND_QUEUE_SIZE;
 
+#ifdef WITH_PERF_TIMERS
+    const u64 batch_start_counter = PerfTimers::ReadCounter();
+#endif
+
     while (read_ptr < write_ptr)
     {
       const GPUBackendCommand* cmd = reinterpret_cast<const GPUBackendCommand*>(&m_command_fifo_data[read_ptr]);
@@ -251,6 +259,10 @@ void GPUBackend::RunGPULoop()
       }
     }
 
+#ifdef WITH_PERF_TIMERS
+    PerfTimers::AddGPUThreadTime(PerfTimers::ReadCounter() - batch_start_counter);
+#endif
+
     m_command_fifo_read_ptr.store(read_ptr);
   }
 }
@@ -3,6 +3,7 @@
 #include "common/string_util.h"
 #include "gpu.h"
 #include "interrupt_controller.h"
+#include "perf_timers.h"
 #include "system.h"
 #include "texture_replacements.h"
 Log_SetChannel(GPU);
@@ -24,6 +25,7 @@ static constexpr u32 ReplaceZero(u32 value, u32 value_for_zero)
 
 void GPU::ExecuteCommands()
 {
+  PERF_TIMER_SCOPE(GPU);
   m_syncing = true;
 
   for (;;)
@@ -92,6 +94,7 @@ void GPU::ExecuteCommands()
             // drop terminator
             m_fifo.RemoveOne();
             Log_DebugPrintf("Drawing poly-line with %u vertices", GetPolyLineVertexCount());
+            AddSnapshotDirtyDrawingArea();
             DispatchRenderCommand();
             m_blit_buffer.clear();
             EndCommand();
@@ -352,6 +355,7 @@ bool GPU::HandleRenderPolygonCommand()
   m_render_command.bits = rc.bits;
   m_fifo.RemoveOne();
 
+  AddSnapshotDirtyDrawingArea();
   DispatchRenderCommand();
   EndCommand();
   return true;
@@ -384,6 +388,7 @@ bool GPU::HandleRenderRectangleCommand()
   m_render_command.bits = rc.bits;
   m_fifo.RemoveOne();
 
+  AddSnapshotDirtyDrawingArea();
   DispatchRenderCommand();
   EndCommand();
   return true;
@@ -406,6 +411,7 @@ bool GPU::HandleRenderLineCommand()
   m_render_command.bits = rc.bits;
   m_fifo.RemoveOne();
 
+  AddSnapshotDirtyDrawingArea();
   DispatchRenderCommand();
   EndCommand();
   return true;
@@ -461,7 +467,10 @@ bool GPU::HandleFillRectangleCommand()
   Log_DebugPrintf("Fill VRAM rectangle offset=(%u,%u), size=(%u,%u)", dst_x, dst_y, width, height);
 
   if (width > 0 && height > 0)
+  {
+    AddSnapshotDirtyRectangle(dst_x, dst_y, width, height);
     FillVRAM(dst_x, dst_y, width, height, color);
+  }
 
   m_stats.num_vram_fills++;
   AddCommandTicks(46 + ((width / 8) + 9) * height);
@@ -502,6 +511,7 @@ void GPU::FinishVRAMWrite()
     SynchronizeCRTC();
 
   FlushRender();
+  AddSnapshotDirtyRectangle(m_vram_transfer.x, m_vram_transfer.y, m_vram_transfer.width, m_vram_transfer.height);
 
   if (m_blit_remaining_words == 0)
   {
@@ -604,6 +614,7 @@ bool GPU::HandleCopyRectangleVRAMToVRAMCommand()
                   width, height);
 
   FlushRender();
+  AddSnapshotDirtyRectangle(dst_x, dst_y, width, height);
   CopyVRAM(src_x, src_y, dst_x, dst_y, width, height);
   m_stats.num_vram_copies++;
   AddCommandTicks(width * height * 2);
@@ -96,9 +96,9 @@ void GPU_HW::Reset()
   SetFullVRAMDirtyRectangle();
 }
 
-bool GPU_HW::DoState(StateWrapper& sw, bool update_display)
+bool GPU_HW::DoState(StateWrapper& sw, u16* vram_snapshot, bool incremental, bool update_display)
 {
-  if (!GPU::DoState(sw, update_display))
+  if (!GPU::DoState(sw, vram_snapshot, incremental, update_display))
     return false;
 
   // invalidate the whole VRAM read texture when loading state
@@ -3,6 +3,7 @@
 #include "common/bitutils.h"
 #include "common/state_wrapper.h"
 #include "cpu_core.h"
+#include "perf_timers.h"
 #include "pgxp.h"
 #include "settings.h"
 #include <algorithm>
@@ -1154,6 +1155,8 @@ static void Execute_GPF(Instruction inst)
 
 void ExecuteInstruction(u32 inst_bits)
 {
+  PERF_TIMER_SAMPLED_SCOPE(GTE);
+
   const Instruction inst{inst_bits};
   switch (inst.command)
   {
@@ -1256,8 +1259,21 @@ void ExecuteInstruction(u32 inst_bits)
   }
 }
 
+#ifdef WITH_PERF_TIMERS
+static void ExecuteTimedInstruction(Instruction inst)
+{
+  ExecuteInstruction(inst.bits);
+}
+#endif
+
 InstructionImpl GetInstructionImpl(u32 inst_bits)
 {
+#ifdef WITH_PERF_TIMERS
+  // Route through the sampled dispatcher while timing, the code cache is flushed when this changes.
+  if (PerfTimers::IsEnabled())
+    return &ExecuteTimedInstruction;
+#endif
+
   const Instruction inst{inst_bits};
   switch (inst.command)
   {
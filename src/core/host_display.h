@@ -55,6 +55,12 @@ public:
   ALWAYS_INLINE s32 GetWindowWidth() const { return static_cast<s32>(m_window_info.surface_width); }
   ALWAYS_INLINE s32 GetWindowHeight() const { return static_cast<s32>(m_window_info.surface_height); }
 
+  /// Refresh rate of the display the window is on, or zero if unknown.
+  ALWAYS_INLINE float GetWindowRefreshRate() const { return m_window_info.surface_refresh_rate; }
+
+  /// Call when the window moves to another display, or the display mode changes.
+  ALWAYS_INLINE void SetWindowRefreshRate(float refresh_rate) { m_window_info.surface_refresh_rate = refresh_rate; }
+
   // Position is relative to the top-left corner of the window.
   ALWAYS_INLINE s32 GetMousePositionX() const { return m_mouse_position_x; }
   ALWAYS_INLINE s32 GetMousePositionY() const { return m_mouse_position_y; }
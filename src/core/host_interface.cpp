@@ -383,6 +383,11 @@ bool HostInterface::LoadState(const char* filename)
   if (!stream)
     return false;
 
+  return LoadState(filename, std::move(stream));
+}
+
+bool HostInterface::LoadState(const char* filename, std::unique_ptr<ByteStream> stream)
+{
   AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "Loading state from '%s'..."), filename);
 
   if (!System::IsShutdown())
@@ -414,7 +419,8 @@ bool HostInterface::SaveState(const char* filename)
   if (!stream)
     return false;
 
-  const bool result = System::SaveState(stream.get());
+  // This blocks the emulation thread, so the data isn't compressed. Slot saves compress on the I/O thread instead.
+  const bool result = System::SaveState(stream.get(), 128, 0);
   if (!result)
   {
     ReportFormattedError(TranslateString("OSDMessage", "Saving state to '%s' failed."), filename);
@@ -454,13 +460,22 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
 
   si.SetFloatValue("Main", "EmulationSpeed", 1.0f);
   si.SetFloatValue("Main", "FastForwardSpeed", 0.0f);
+  si.SetBoolValue("Main", "UnthrottledTurbo", false);
   si.SetBoolValue("Main", "IncreaseTimerResolution", true);
+  si.SetBoolValue("Main", "PreciseThrottle", false);
+  si.SetBoolValue("Main", "SyncToHostRefreshRate", false);
   si.SetBoolValue("Main", "StartPaused", false);
   si.SetBoolValue("Main", "StartFullscreen", false);
   si.SetBoolValue("Main", "PauseOnFocusLoss", false);
   si.SetBoolValue("Main", "SaveStateOnExit", true);
   si.SetBoolValue("Main", "ConfirmPowerOff", true);
   si.SetBoolValue("Main", "LoadDevicesFromSaveStates", false);
+  si.SetIntValue("Main", "SaveStateCompressionLevel", static_cast<int>(Settings::DEFAULT_SAVE_STATE_COMPRESSION_LEVEL));
+  si.SetBoolValue("Main", "CreateSaveStateBackups", false);
+  si.SetBoolValue("Main", "RewindEnable", false);
+  si.SetIntValue("Main", "RewindFrequency", static_cast<int>(Settings::DEFAULT_REWIND_SAVE_FREQUENCY));
+  si.SetIntValue("Main", "RewindMaxMemory", static_cast<int>(Settings::DEFAULT_REWIND_MAX_MEMORY));
+  si.SetIntValue("Main", "RunaheadFrameCount", 0);
   si.SetBoolValue("Main", "ApplyGameSettings", true);
 
   si.SetStringValue("CPU", "ExecutionMode", Settings::GetCPUExecutionModeName(Settings::DEFAULT_CPU_EXECUTION_MODE));
@@ -507,6 +522,7 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetBoolValue("Display", "ShowVPS", false);
   si.SetBoolValue("Display", "ShowSpeed", false);
   si.SetBoolValue("Display", "ShowResolution", false);
+  si.SetBoolValue("Display", "ShowFramePacing", false);
   si.SetBoolValue("Display", "Fullscreen", false);
   si.SetBoolValue("Display", "VSync", true);
   si.SetStringValue("Display", "PostProcessChain", "");
@@ -524,6 +540,7 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetIntValue("Audio", "BufferSize", DEFAULT_AUDIO_BUFFER_SIZE);
   si.SetIntValue("Audio", "OutputMuted", false);
   si.SetBoolValue("Audio", "Sync", true);
+  si.SetBoolValue("Audio", "TimeStretch", false);
   si.SetBoolValue("Audio", "DumpOnBoot", false);
 
   si.SetStringValue("BIOS", "SearchDirectory", "");
@@ -558,6 +575,7 @@ void HostInterface::SetDefaultSettings(SettingsInterface& si)
   si.SetBoolValue("Debug", "ShowTimersState", false);
   si.SetBoolValue("Debug", "ShowMDECState", false);
   si.SetBoolValue("Debug", "ShowDMAState", false);
+  si.SetBoolValue("Debug", "ShowPerfTimers", false);
 
   si.SetIntValue("Hacks", "DMAMaxSliceTicks", static_cast<int>(Settings::DEFAULT_DMA_MAX_SLICE_TICKS));
   si.SetIntValue("Hacks", "DMAHaltTicks", static_cast<int>(Settings::DEFAULT_DMA_HALT_TICKS));
@@ -645,8 +663,13 @@ void HostInterface::CheckForSettingsChanges(const Settings& old_settings)
       m_audio_stream->PauseOutput(System::IsPaused());
     }
 
-    if (g_settings.emulation_speed != old_settings.emulation_speed)
+    if (g_settings.emulation_speed != old_settings.emulation_speed ||
+        g_settings.sync_to_host_refresh_rate != old_settings.sync_to_host_refresh_rate ||
+        g_settings.audio_sync_enabled != old_settings.audio_sync_enabled ||
+        g_settings.audio_time_stretch != old_settings.audio_time_stretch)
+    {
       System::UpdateThrottlePeriod();
+    }
 
     if (g_settings.cpu_execution_mode != old_settings.cpu_execution_mode ||
         g_settings.cpu_fastmem_mode != old_settings.cpu_fastmem_mode)
@@ -748,6 +771,12 @@ void HostInterface::CheckForSettingsChanges(const Settings& old_settings)
 
     g_dma.SetMaxSliceTicks(g_settings.dma_max_slice_ticks);
     g_dma.SetHaltTicks(g_settings.dma_halt_ticks);
+
+    if (g_settings.rewind_enable != old_settings.rewind_enable ||
+        g_settings.rewind_max_memory != old_settings.rewind_max_memory)
+    {
+      System::UpdateRewindSettings();
+    }
   }
 
   bool controllers_updated = false;
@@ -60,6 +60,9 @@ public:
   /// Loads state from the specified filename.
   bool LoadState(const char* filename);
 
+  /// Loads state from an already-opened stream, e.g. one read ahead of time. The filename is only used for messages.
+  bool LoadState(const char* filename, std::unique_ptr<ByteStream> stream);
+
   virtual void ReportError(const char* message);
   virtual void ReportMessage(const char* message);
   virtual void ReportDebuggerMessage(const char* message);
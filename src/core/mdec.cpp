@@ -1,15 +1,28 @@
 #include "mdec.h"
+#include "common/byte_stream.h"
+#include "common/cpu_detect.h"
 #include "common/log.h"
 #include "common/state_wrapper.h"
 #include "cpu_core.h"
 #include "dma.h"
 #include "interrupt_controller.h"
+#include "perf_timers.h"
 #include "system.h"
 #ifdef WITH_IMGUI
 #include "imgui.h"
 #endif
 Log_SetChannel(MDEC);
 
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
 MDEC g_mdec;
 
 MDEC::MDEC() = default;
@@ -144,6 +157,8 @@ void MDEC::DMAWrite(const u32* words, u32 word_count)
 
   const u32 halfwords_to_write = std::min(word_count * 2, m_data_in_fifo.GetSpace() & ~u32(2));
   m_data_in_fifo.PushRange(reinterpret_cast<const u16*>(words), halfwords_to_write);
+  if (m_input_capture_stream)
+    m_input_capture_stream->Write2(words, halfwords_to_write * sizeof(u16));
   Execute();
 }
 
@@ -227,12 +242,16 @@ void MDEC::WriteCommandRegister(u32 value)
 
   m_data_in_fifo.Push(Truncate16(value));
   m_data_in_fifo.Push(Truncate16(value >> 16));
+  if (m_input_capture_stream)
+    m_input_capture_stream->Write2(&value, sizeof(value));
 
   Execute();
 }
 
 void MDEC::Execute()
 {
+  PERF_TIMER_SCOPE(MDEC);
+
   for (;;)
   {
     switch (m_state)
@@ -416,10 +435,12 @@ bool MDEC::DecodeColoredMacroblock()
   ResetDecoder();
   m_state = State::WritingMacroblock;
 
-  yuv_to_rgb(0, 0, m_blocks[0], m_blocks[1], m_blocks[2]);
-  yuv_to_rgb(8, 0, m_blocks[0], m_blocks[1], m_blocks[3]);
-  yuv_to_rgb(0, 8, m_blocks[0], m_blocks[1], m_blocks[4]);
-  yuv_to_rgb(8, 8, m_blocks[0], m_blocks[1], m_blocks[5]);
+  ChromaTerms chroma;
+  ComputeChromaTerms(m_blocks[0], m_blocks[1], &chroma);
+  yuv_to_rgb(0, 0, chroma, m_blocks[2]);
+  yuv_to_rgb(8, 0, chroma, m_blocks[3]);
+  yuv_to_rgb(0, 8, chroma, m_blocks[4]);
+  yuv_to_rgb(8, 8, chroma, m_blocks[5]);
   m_total_blocks_decoded += 4;
 
   ScheduleBlockCopyOut(s_ticks_per_block[static_cast<u8>(m_status.data_output_depth)] * 6);
@@ -436,14 +457,51 @@ void MDEC::ScheduleBlockCopyOut(TickCount ticks)
 
 void MDEC::CopyOutBlock()
 {
+  PERF_TIMER_SCOPE(MDEC);
+
   Assert(m_state == State::WritingMacroblock);
   m_block_copy_out_event->Deactivate();
 
+  // Pack into a local buffer and push it to the FIFO in one go.
+  std::array<u32, 192> out_words;
+  u32 num_out_words = 0;
+
   switch (m_status.data_output_depth)
   {
     case DataOutputDepth_4Bit:
     {
       const u32* in_ptr = m_block_rgb.data();
+#if defined(CPU_X64)
+      // Narrow sixteen pixels to bytes, then merge each pair of bytes into one.
+      const __m128i low_nibble = _mm_set1_epi16(0x000F);
+      const __m128i high_nibble = _mm_set1_epi16(0x00F0);
+      for (u32 i = 0; i < (64 / 16); i++)
+      {
+        const __m128i c0 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 0)), 4);
+        const __m128i c1 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 4)), 4);
+        const __m128i c2 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 8)), 4);
+        const __m128i c3 = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 12)), 4);
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+        const __m128i pairs =
+          _mm_or_si128(_mm_and_si128(bytes, low_nibble), _mm_and_si128(_mm_srli_epi16(bytes, 4), high_nibble));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&out_words[num_out_words]), _mm_packus_epi16(pairs, pairs));
+        in_ptr += 16;
+        num_out_words += 2;
+      }
+#elif defined(CPU_AARCH64)
+      for (u32 i = 0; i < (64 / 16); i++)
+      {
+        const uint16x8_t c01 = vcombine_u16(vshrn_n_u32(vld1q_u32(in_ptr + 0), 4), vshrn_n_u32(vld1q_u32(in_ptr + 4), 4));
+        const uint16x8_t c23 =
+          vcombine_u16(vshrn_n_u32(vld1q_u32(in_ptr + 8), 4), vshrn_n_u32(vld1q_u32(in_ptr + 12), 4));
+        const uint16x8_t pairs = vreinterpretq_u16_u8(vcombine_u8(vmovn_u16(c01), vmovn_u16(c23)));
+        vst1_u8(reinterpret_cast<u8*>(&out_words[num_out_words]),
+                vmovn_u16(vorrq_u16(vandq_u16(pairs, vdupq_n_u16(0x000F)),
+                                    vandq_u16(vshrq_n_u16(pairs, 4), vdupq_n_u16(0x00F0)))));
+        in_ptr += 16;
+        num_out_words += 2;
+      }
+#else
       for (u32 i = 0; i < (64 / 8); i++)
       {
         u32 value = *(in_ptr++) >> 4;
@@ -454,83 +512,164 @@ void MDEC::CopyOutBlock()
         value |= (*(in_ptr++) >> 4) << 20;
         value |= (*(in_ptr++) >> 4) << 24;
         value |= (*(in_ptr++) >> 4) << 28;
-        m_data_out_fifo.Push(value);
+        out_words[num_out_words++] = value;
       }
+#endif
     }
     break;
 
     case DataOutputDepth_8Bit:
     {
       const u32* in_ptr = m_block_rgb.data();
+#if defined(CPU_X64)
+      for (u32 i = 0; i < (64 / 16); i++)
+      {
+        const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 0));
+        const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 4));
+        const __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 8));
+        const __m128i c3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out_words[num_out_words]),
+                         _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)));
+        in_ptr += 16;
+        num_out_words += 4;
+      }
+#elif defined(CPU_AARCH64)
+      for (u32 i = 0; i < (64 / 16); i++)
+      {
+        const uint16x8_t c01 = vcombine_u16(vmovn_u32(vld1q_u32(in_ptr + 0)), vmovn_u32(vld1q_u32(in_ptr + 4)));
+        const uint16x8_t c23 = vcombine_u16(vmovn_u32(vld1q_u32(in_ptr + 8)), vmovn_u32(vld1q_u32(in_ptr + 12)));
+        vst1q_u8(reinterpret_cast<u8*>(&out_words[num_out_words]), vcombine_u8(vmovn_u16(c01), vmovn_u16(c23)));
+        in_ptr += 16;
+        num_out_words += 4;
+      }
+#else
       for (u32 i = 0; i < (64 / 4); i++)
       {
         u32 value = *in_ptr++;
         value |= *in_ptr++ << 8;
         value |= *in_ptr++ << 16;
         value |= *in_ptr++ << 24;
-        m_data_out_fifo.Push(value);
+        out_words[num_out_words++] = value;
       }
+#endif
     }
     break;
 
     case DataOutputDepth_24Bit:
     {
-      // pack tightly
-      u32 index = 0;
-      u32 state = 0;
-      u32 rgb = 0;
-      while (index < m_block_rgb.size())
+      // pack tightly, four pixels to three words
+      const u32* in_ptr = m_block_rgb.data();
+#if defined(CPU_X64)
+      // Squeeze each group of four pixels into 12 bytes, then stitch four groups into three full vectors.
+      const __m128i low_pixel = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+      const __m128i high_pixel = _mm_set_epi32(0x0000FFFF, static_cast<s32>(0xFF000000), 0x0000FFFF,
+                                               static_cast<s32>(0xFF000000));
+      const auto pack_group = [&low_pixel, &high_pixel](const u32* ptr) {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        const __m128i pairs = _mm_or_si128(_mm_and_si128(c, low_pixel), _mm_and_si128(_mm_srli_epi64(c, 8), high_pixel));
+        return _mm_or_si128(_mm_move_epi64(pairs), _mm_slli_si128(_mm_srli_si128(pairs, 8), 6));
+      };
+      for (u32 i = 0; i < (256 / 16); i++)
       {
-        switch (state)
-        {
-          case 0:
-            rgb = m_block_rgb[index++]; // RGB-
-            state = 1;
-            break;
-          case 1:
-            rgb |= (m_block_rgb[index] & 0xFF) << 24; // RGBR
-            m_data_out_fifo.Push(rgb);
-            rgb = m_block_rgb[index] >> 8; // GB--
-            index++;
-            state = 2;
-            break;
-          case 2:
-            rgb |= m_block_rgb[index] << 16; // GBRG
-            m_data_out_fifo.Push(rgb);
-            rgb = m_block_rgb[index] >> 16; // B---
-            index++;
-            state = 3;
-            break;
-          case 3:
-            rgb |= m_block_rgb[index] << 8; // BRGB
-            m_data_out_fifo.Push(rgb);
-            index++;
-            state = 0;
-            break;
-        }
+        const __m128i g0 = pack_group(in_ptr + 0);
+        const __m128i g1 = pack_group(in_ptr + 4);
+        const __m128i g2 = pack_group(in_ptr + 8);
+        const __m128i g3 = pack_group(in_ptr + 12);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out_words[num_out_words + 0]),
+                         _mm_or_si128(g0, _mm_slli_si128(g1, 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out_words[num_out_words + 4]),
+                         _mm_or_si128(_mm_srli_si128(g1, 4), _mm_slli_si128(g2, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out_words[num_out_words + 8]),
+                         _mm_or_si128(_mm_srli_si128(g2, 8), _mm_slli_si128(g3, 4)));
+        in_ptr += 16;
+        num_out_words += 12;
       }
-      break;
+#elif defined(CPU_AARCH64)
+      for (u32 i = 0; i < (256 / 16); i++)
+      {
+        const uint8x16x4_t rgbx = vld4q_u8(reinterpret_cast<const u8*>(in_ptr));
+        const uint8x16x3_t rgb = {{rgbx.val[0], rgbx.val[1], rgbx.val[2]}};
+        vst3q_u8(reinterpret_cast<u8*>(&out_words[num_out_words]), rgb);
+        in_ptr += 16;
+        num_out_words += 12;
+      }
+#else
+      for (u32 i = 0; i < (256 / 4); i++)
+      {
+        const u32 p0 = *(in_ptr++);
+        const u32 p1 = *(in_ptr++);
+        const u32 p2 = *(in_ptr++);
+        const u32 p3 = *(in_ptr++);
+        out_words[num_out_words++] = p0 | (p1 << 24);        // RGBR
+        out_words[num_out_words++] = (p1 >> 8) | (p2 << 16); // GBRG
+        out_words[num_out_words++] = (p2 >> 16) | (p3 << 8); // BRGB
+      }
+#endif
     }
+    break;
 
     case DataOutputDepth_15Bit:
     {
       const u16 a = ZeroExtend16(m_status.data_output_bit15.GetValue());
-      for (u32 i = 0; i < static_cast<u32>(m_block_rgb.size());)
+      const u32* in_ptr = m_block_rgb.data();
+#if defined(CPU_X64)
+      const __m128i mask_r = _mm_set1_epi32(0x1F);
+      const __m128i mask_g = _mm_set1_epi32(0x1F << 5);
+      const __m128i mask_b = _mm_set1_epi32(0x1F << 10);
+      const __m128i bit15 = _mm_set1_epi16(static_cast<s16>(a << 15));
+      for (u32 i = 0; i < (256 / 8); i++)
+      {
+        const __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 0));
+        const __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ptr + 4));
+        const __m128i v0 = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(c0, 3), mask_r),
+                                                     _mm_and_si128(_mm_srli_epi32(c0, 6), mask_g)),
+                                        _mm_and_si128(_mm_srli_epi32(c0, 9), mask_b));
+        const __m128i v1 = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(c1, 3), mask_r),
+                                                     _mm_and_si128(_mm_srli_epi32(c1, 6), mask_g)),
+                                        _mm_and_si128(_mm_srli_epi32(c1, 9), mask_b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out_words[num_out_words]),
+                         _mm_or_si128(_mm_packs_epi32(v0, v1), bit15));
+        in_ptr += 8;
+        num_out_words += 4;
+      }
+#elif defined(CPU_AARCH64)
+      const uint32x4_t mask_r = vdupq_n_u32(0x1F);
+      const uint32x4_t mask_g = vdupq_n_u32(0x1F << 5);
+      const uint32x4_t mask_b = vdupq_n_u32(0x1F << 10);
+      const uint16x8_t bit15 = vdupq_n_u16(static_cast<u16>(a << 15));
+      for (u32 i = 0; i < (256 / 8); i++)
       {
-        u32 color = m_block_rgb[i++];
+        const uint32x4_t c0 = vld1q_u32(in_ptr + 0);
+        const uint32x4_t c1 = vld1q_u32(in_ptr + 4);
+        const uint32x4_t v0 = vorrq_u32(vorrq_u32(vandq_u32(vshrq_n_u32(c0, 3), mask_r),
+                                                  vandq_u32(vshrq_n_u32(c0, 6), mask_g)),
+                                        vandq_u32(vshrq_n_u32(c0, 9), mask_b));
+        const uint32x4_t v1 = vorrq_u32(vorrq_u32(vandq_u32(vshrq_n_u32(c1, 3), mask_r),
+                                                  vandq_u32(vshrq_n_u32(c1, 6), mask_g)),
+                                        vandq_u32(vshrq_n_u32(c1, 9), mask_b));
+        vst1q_u16(reinterpret_cast<u16*>(&out_words[num_out_words]),
+                  vorrq_u16(vcombine_u16(vmovn_u32(v0), vmovn_u32(v1)), bit15));
+        in_ptr += 8;
+        num_out_words += 4;
+      }
+#else
+      for (u32 i = 0; i < (256 / 2); i++)
+      {
+        u32 color = *(in_ptr++);
         u16 r = Truncate16((color >> 3) & 0x1Fu);
         u16 g = Truncate16((color >> 11) & 0x1Fu);
         u16 b = Truncate16((color >> 19) & 0x1Fu);
         const u16 color15a = r | (g << 5) | (b << 10) | (a << 15);
 
-        color = m_block_rgb[i++];
+        color = *(in_ptr++);
         r = Truncate16((color >> 3) & 0x1Fu);
         g = Truncate16((color >> 11) & 0x1Fu);
         b = Truncate16((color >> 19) & 0x1Fu);
         const u16 color15b = r | (g << 5) | (b << 10) | (a << 15);
 
-        m_data_out_fifo.Push(ZeroExtend32(color15a) | (ZeroExtend32(color15b) << 16));
+        out_words[num_out_words++] = ZeroExtend32(color15a) | (ZeroExtend32(color15b) << 16);
       }
+#endif
     }
     break;
 
@@ -538,6 +677,8 @@ void MDEC::CopyOutBlock()
       break;
   }
 
+  m_data_out_fifo.PushRange(out_words.data(), num_out_words);
+
   Log_DebugPrintf("Block copied out, fifo size = %u (%u bytes)", m_data_out_fifo.GetSize(),
                   m_data_out_fifo.GetSize() * sizeof(u32));
 
@@ -621,6 +762,117 @@ bool MDEC::rl_decode_block(s16* blk, const u8* qt)
 
 void MDEC::IDCT(s16* blk)
 {
+#if defined(CPU_X64)
+  // First pass: temp[y][x] = sum(blk[u][x] * scale[u][y]). The RLE decoder limits coefficients to 11 bits, so this
+  // can't overflow 32 bits, and two rows at a time can go through pmaddwd.
+  alignas(16) std::array<s32, 64> temp_buffer;
+  __m128i rows_lo[4];
+  __m128i rows_hi[4];
+  for (u32 p = 0; p < 4; p++)
+  {
+    const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blk[(p * 2 + 0) * 8]));
+    const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&blk[(p * 2 + 1) * 8]));
+    rows_lo[p] = _mm_unpacklo_epi16(row0, row1);
+    rows_hi[p] = _mm_unpackhi_epi16(row0, row1);
+  }
+  for (u32 y = 0; y < 8; y++)
+  {
+    __m128i sum_lo = _mm_setzero_si128();
+    __m128i sum_hi = _mm_setzero_si128();
+    for (u32 p = 0; p < 4; p++)
+    {
+      const __m128i coeff =
+        _mm_set1_epi32(static_cast<s32>(ZeroExtend32(static_cast<u16>(m_scale_table[(p * 2 + 0) * 8 + y])) |
+                                        (ZeroExtend32(static_cast<u16>(m_scale_table[(p * 2 + 1) * 8 + y])) << 16)));
+      sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(rows_lo[p], coeff));
+      sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(rows_hi[p], coeff));
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(&temp_buffer[y * 8 + 0]), sum_lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&temp_buffer[y * 8 + 4]), sum_hi);
+  }
+
+  // Second pass needs ~46 bits, and SSE2 has no signed 32x32->64 multiply. Doubles hold every product and sum here
+  // exactly, so this still matches the integer version bit for bit.
+  alignas(16) std::array<double, 64> scale_table;
+  for (u32 i = 0; i < 64; i++)
+    scale_table[i] = static_cast<double>(m_scale_table[i]);
+
+  const __m128d round_bias = _mm_set1_pd(2147483648.0);
+  const __m128d round_scale = _mm_set1_pd(1.0 / 4294967296.0);
+  const __m128d floor_offset = _mm_set1_pd(32768.0);
+  for (u32 y = 0; y < 8; y++)
+  {
+    __m128d sums[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+    for (u32 u = 0; u < 8; u++)
+    {
+      const __m128d t = _mm_set1_pd(static_cast<double>(temp_buffer[y * 8 + u]));
+      for (u32 i = 0; i < 4; i++)
+        sums[i] = _mm_add_pd(sums[i], _mm_mul_pd(t, _mm_load_pd(&scale_table[u * 8 + i * 2])));
+    }
+
+    // (sum >> 32) + ((sum >> 31) & 1) is floor((sum + 2^31) / 2^32). Offset so truncation rounds down.
+    __m128i rounded[4];
+    for (u32 i = 0; i < 4; i++)
+      rounded[i] = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(_mm_add_pd(sums[i], round_bias), round_scale), floor_offset));
+
+    __m128i lo = _mm_sub_epi32(_mm_unpacklo_epi64(rounded[0], rounded[1]), _mm_set1_epi32(32768));
+    __m128i hi = _mm_sub_epi32(_mm_unpacklo_epi64(rounded[2], rounded[3]), _mm_set1_epi32(32768));
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 23), 23);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 23), 23);
+
+    const __m128i result =
+      _mm_max_epi16(_mm_min_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(127)), _mm_set1_epi16(-128));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&blk[y * 8]), result);
+  }
+#elif defined(CPU_AARCH64)
+  // First pass fits in 32 bits, since the RLE decoder limits coefficients to 11 bits.
+  alignas(16) std::array<s32, 64> temp_buffer;
+  int16x8_t rows[8];
+  for (u32 u = 0; u < 8; u++)
+    rows[u] = vld1q_s16(&blk[u * 8]);
+  for (u32 y = 0; y < 8; y++)
+  {
+    int32x4_t sum_lo = vdupq_n_s32(0);
+    int32x4_t sum_hi = vdupq_n_s32(0);
+    for (u32 u = 0; u < 8; u++)
+    {
+      sum_lo = vmlal_n_s16(sum_lo, vget_low_s16(rows[u]), m_scale_table[u * 8 + y]);
+      sum_hi = vmlal_high_n_s16(sum_hi, rows[u], m_scale_table[u * 8 + y]);
+    }
+    vst1q_s32(&temp_buffer[y * 8 + 0], sum_lo);
+    vst1q_s32(&temp_buffer[y * 8 + 4], sum_hi);
+  }
+
+  int32x4_t scale_rows[8][2];
+  for (u32 u = 0; u < 8; u++)
+  {
+    const int16x8_t row = vld1q_s16(&m_scale_table[u * 8]);
+    scale_rows[u][0] = vmovl_s16(vget_low_s16(row));
+    scale_rows[u][1] = vmovl_high_s16(row);
+  }
+  for (u32 y = 0; y < 8; y++)
+  {
+    int64x2_t sums[4] = {vdupq_n_s64(0), vdupq_n_s64(0), vdupq_n_s64(0), vdupq_n_s64(0)};
+    for (u32 u = 0; u < 8; u++)
+    {
+      const s32 t = temp_buffer[y * 8 + u];
+      sums[0] = vmlal_n_s32(sums[0], vget_low_s32(scale_rows[u][0]), t);
+      sums[1] = vmlal_high_n_s32(sums[1], scale_rows[u][0], t);
+      sums[2] = vmlal_n_s32(sums[2], vget_low_s32(scale_rows[u][1]), t);
+      sums[3] = vmlal_high_n_s32(sums[3], scale_rows[u][1], t);
+    }
+
+    // (sum >> 32) + ((sum >> 31) & 1) is a rounding shift.
+    int32x4_t lo = vcombine_s32(vmovn_s64(vrshrq_n_s64(sums[0], 32)), vmovn_s64(vrshrq_n_s64(sums[1], 32)));
+    int32x4_t hi = vcombine_s32(vmovn_s64(vrshrq_n_s64(sums[2], 32)), vmovn_s64(vrshrq_n_s64(sums[3], 32)));
+    lo = vshrq_n_s32(vshlq_n_s32(lo, 23), 23);
+    hi = vshrq_n_s32(vshlq_n_s32(hi, 23), 23);
+
+    const int16x8_t result = vmaxq_s16(vminq_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)), vdupq_n_s16(127)),
+                                       vdupq_n_s16(-128));
+    vst1q_s16(&blk[y * 8], result);
+  }
+#else
   std::array<s64, 64> temp_buffer;
   for (u32 x = 0; x < 8; x++)
   {
@@ -644,48 +896,137 @@ void MDEC::IDCT(s16* blk)
         static_cast<s16>(std::clamp<s32>(SignExtendN<9, s32>((sum >> 32) + ((sum >> 31) & 1)), -128, 127));
     }
   }
+#endif
+}
+
+void MDEC::ComputeChromaTerms(const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk, ChromaTerms* terms)
+{
+  for (u32 i = 0; i < 64; i++)
+  {
+    const s16 R = Crblk[i];
+    const s16 B = Cbblk[i];
+    terms->g[i] = static_cast<s16>((-0.3437f * static_cast<float>(B)) + (-0.7143f * static_cast<float>(R)));
+    terms->r[i] = static_cast<s16>(1.402f * static_cast<float>(R));
+    terms->b[i] = static_cast<s16>(1.772f * static_cast<float>(B));
+  }
 }
 
-void MDEC::yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                      const std::array<s16, 64>& Yblk)
+void MDEC::yuv_to_rgb(u32 xx, u32 yy, const ChromaTerms& chroma, const std::array<s16, 64>& Yblk)
 {
+  // Components are clamped to -128..127. Flipping the sign bit adds 128 for unsigned output.
+  // TODO: Signed output
+  static constexpr u16 output_xor = 0x80;
+
   for (u32 y = 0; y < 8; y++)
   {
+    const u32 chroma_offset = (xx / 2) + ((y + yy) / 2) * 8;
+    u32* out_ptr = &m_block_rgb[xx + ((y + yy) * 16)];
+
+#if defined(CPU_X64)
+    // Each chroma sample covers two pixels horizontally.
+    const __m128i Y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Yblk[y * 8]));
+    const __m128i Rc = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&chroma.r[chroma_offset]));
+    const __m128i Gc = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&chroma.g[chroma_offset]));
+    const __m128i Bc = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&chroma.b[chroma_offset]));
+    const __m128i min_value = _mm_set1_epi16(-128);
+    const __m128i max_value = _mm_set1_epi16(127);
+    const __m128i byte_mask = _mm_set1_epi16(0xFF);
+    const __m128i sign_xor = _mm_set1_epi16(static_cast<s16>(output_xor));
+
+    const __m128i R = _mm_xor_si128(
+      _mm_and_si128(_mm_max_epi16(_mm_min_epi16(_mm_add_epi16(Y, _mm_unpacklo_epi16(Rc, Rc)), max_value), min_value),
+                    byte_mask),
+      sign_xor);
+    const __m128i G = _mm_xor_si128(
+      _mm_and_si128(_mm_max_epi16(_mm_min_epi16(_mm_add_epi16(Y, _mm_unpacklo_epi16(Gc, Gc)), max_value), min_value),
+                    byte_mask),
+      sign_xor);
+    const __m128i B = _mm_xor_si128(
+      _mm_and_si128(_mm_max_epi16(_mm_min_epi16(_mm_add_epi16(Y, _mm_unpacklo_epi16(Bc, Bc)), max_value), min_value),
+                    byte_mask),
+      sign_xor);
+
+    const __m128i RG = _mm_or_si128(R, _mm_slli_epi16(G, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ptr + 0), _mm_unpacklo_epi16(RG, B));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ptr + 4), _mm_unpackhi_epi16(RG, B));
+#elif defined(CPU_AARCH64)
+    const int16x8_t Y = vld1q_s16(&Yblk[y * 8]);
+    const int16x4_t Rc = vld1_s16(&chroma.r[chroma_offset]);
+    const int16x4_t Gc = vld1_s16(&chroma.g[chroma_offset]);
+    const int16x4_t Bc = vld1_s16(&chroma.b[chroma_offset]);
+    const int16x8_t min_value = vdupq_n_s16(-128);
+    const int16x8_t max_value = vdupq_n_s16(127);
+    const uint16x8_t byte_mask = vdupq_n_u16(0xFF);
+    const uint16x8_t sign_xor = vdupq_n_u16(output_xor);
+
+    const uint16x8_t R = veorq_u16(
+      vandq_u16(vreinterpretq_u16_s16(vmaxq_s16(
+                  vminq_s16(vaddq_s16(Y, vcombine_s16(vzip1_s16(Rc, Rc), vzip2_s16(Rc, Rc))), max_value), min_value)),
+                byte_mask),
+      sign_xor);
+    const uint16x8_t G = veorq_u16(
+      vandq_u16(vreinterpretq_u16_s16(vmaxq_s16(
+                  vminq_s16(vaddq_s16(Y, vcombine_s16(vzip1_s16(Gc, Gc), vzip2_s16(Gc, Gc))), max_value), min_value)),
+                byte_mask),
+      sign_xor);
+    const uint16x8_t Bu = veorq_u16(
+      vandq_u16(vreinterpretq_u16_s16(vmaxq_s16(
+                  vminq_s16(vaddq_s16(Y, vcombine_s16(vzip1_s16(Bc, Bc), vzip2_s16(Bc, Bc))), max_value), min_value)),
+                byte_mask),
+      sign_xor);
+
+    const uint16x8_t RG = vorrq_u16(R, vshlq_n_u16(G, 8));
+    vst1q_u32(out_ptr + 0, vreinterpretq_u32_u16(vzip1q_u16(RG, Bu)));
+    vst1q_u32(out_ptr + 4, vreinterpretq_u32_u16(vzip2q_u16(RG, Bu)));
+#else
     for (u32 x = 0; x < 8; x++)
     {
-      s16 R = Crblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
-      s16 B = Cbblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
-      s16 G = static_cast<s16>((-0.3437f * static_cast<float>(B)) + (-0.7143f * static_cast<float>(R)));
-
-      R = static_cast<s16>(1.402f * static_cast<float>(R));
-      B = static_cast<s16>(1.772f * static_cast<float>(B));
-
-      s16 Y = Yblk[x + y * 8];
-      R = static_cast<s16>(std::clamp(static_cast<int>(Y) + R, -128, 127));
-      G = static_cast<s16>(std::clamp(static_cast<int>(Y) + G, -128, 127));
-      B = static_cast<s16>(std::clamp(static_cast<int>(Y) + B, -128, 127));
-
-      // TODO: Signed output
-      R += 128;
-      G += 128;
-      B += 128;
-
-      m_block_rgb[(x + xx) + ((y + yy) * 16)] = ZeroExtend32(static_cast<u16>(R)) |
-                                                (ZeroExtend32(static_cast<u16>(G)) << 8) |
-                                                (ZeroExtend32(static_cast<u16>(B)) << 16);
+      const u32 chroma_index = chroma_offset + (x / 2);
+      const s16 Y = Yblk[x + y * 8];
+      const s32 R = std::clamp(static_cast<s32>(Y) + chroma.r[chroma_index], -128, 127);
+      const s32 G = std::clamp(static_cast<s32>(Y) + chroma.g[chroma_index], -128, 127);
+      const s32 B = std::clamp(static_cast<s32>(Y) + chroma.b[chroma_index], -128, 127);
+
+      out_ptr[x] = ((static_cast<u32>(R) & 0xFF) ^ output_xor) | (((static_cast<u32>(G) & 0xFF) ^ output_xor) << 8) |
+                   (((static_cast<u32>(B) & 0xFF) ^ output_xor) << 16);
     }
+#endif
   }
 }
 
 void MDEC::y_to_mono(const std::array<s16, 64>& Yblk)
 {
-  for (u32 i = 0; i < 64; i++)
+  static constexpr u16 output_xor = 0x80;
+  u32 i = 0;
+
+#if defined(CPU_X64)
+  for (; i < 64; i += 8)
+  {
+    __m128i Y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Yblk[i]));
+    Y = _mm_srai_epi16(_mm_slli_epi16(Y, 6), 6);
+    Y = _mm_max_epi16(_mm_min_epi16(Y, _mm_set1_epi16(127)), _mm_set1_epi16(-128));
+    Y = _mm_xor_si128(_mm_and_si128(Y, _mm_set1_epi16(0xFF)), _mm_set1_epi16(static_cast<s16>(output_xor)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_block_rgb[i + 0]), _mm_unpacklo_epi16(Y, _mm_setzero_si128()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&m_block_rgb[i + 4]), _mm_unpackhi_epi16(Y, _mm_setzero_si128()));
+  }
+#elif defined(CPU_AARCH64)
+  for (; i < 64; i += 8)
+  {
+    int16x8_t Y = vld1q_s16(&Yblk[i]);
+    Y = vshrq_n_s16(vshlq_n_s16(Y, 6), 6);
+    Y = vmaxq_s16(vminq_s16(Y, vdupq_n_s16(127)), vdupq_n_s16(-128));
+    const uint16x8_t Yu = veorq_u16(vandq_u16(vreinterpretq_u16_s16(Y), vdupq_n_u16(0xFF)), vdupq_n_u16(output_xor));
+    vst1q_u32(&m_block_rgb[i + 0], vmovl_u16(vget_low_u16(Yu)));
+    vst1q_u32(&m_block_rgb[i + 4], vmovl_high_u16(Yu));
+  }
+#endif
+
+  for (; i < 64; i++)
   {
     s16 Y = Yblk[i];
     Y = SignExtendN<10, s16>(Y);
     Y = std::clamp<s16>(Y, -128, 127);
-    Y += 128;
-    m_block_rgb[i] = static_cast<u32>(Y) & 0xFF;
+    m_block_rgb[i] = (static_cast<u32>(Y) & 0xFF) ^ output_xor;
   }
 }
 
@@ -5,6 +5,7 @@
 #include <array>
 #include <memory>
 
+class ByteStream;
 class StateWrapper;
 
 class TimingEvent;
@@ -27,6 +28,9 @@ public:
   void DMARead(u32* words, u32 word_count);
   void DMAWrite(const u32* words, u32 word_count);
 
+  /// Records everything written to the command/data port, for replaying in the headless runner's MDEC benchmark.
+  void SetInputCaptureStream(ByteStream* stream) { m_input_capture_stream = stream; }
+
   void DrawDebugStateWindow();
 
 private:
@@ -95,6 +99,14 @@ private:
     BitField<u32, u16, 0, 16> parameter_word_count;
   };
 
+  // Per-macroblock chroma contributions, shared by all four luma blocks.
+  struct ChromaTerms
+  {
+    alignas(16) std::array<s16, 64> r;
+    alignas(16) std::array<s16, 64> g;
+    alignas(16) std::array<s16, 64> b;
+  };
+
   bool HasPendingBlockCopyOut() const;
 
   void SoftReset();
@@ -117,8 +129,8 @@ private:
   // from nocash spec
   bool rl_decode_block(s16* blk, const u8* qt);
   void IDCT(s16* blk);
-  void yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                  const std::array<s16, 64>& Yblk);
+  void ComputeChromaTerms(const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk, ChromaTerms* terms);
+  void yuv_to_rgb(u32 xx, u32 yy, const ChromaTerms& chroma, const std::array<s16, 64>& Yblk);
   void y_to_mono(const std::array<s16, 64>& Yblk);
 
   StatusRegister m_status = {};
@@ -146,6 +158,8 @@ private:
   std::unique_ptr<TimingEvent> m_block_copy_out_event;
 
   u32 m_total_blocks_decoded = 0;
+
+  ByteStream* m_input_capture_stream = nullptr;
 };
 
 extern MDEC g_mdec;
\ No newline at end of file
@@ -46,7 +46,7 @@ void Pad::Reset()
   }
 }
 
-bool Pad::DoState(StateWrapper& sw)
+bool Pad::DoState(StateWrapper& sw, bool is_memory_state)
 {
   for (u32 i = 0; i < NUM_SLOTS; i++)
   {
@@ -98,7 +98,7 @@ bool Pad::DoState(StateWrapper& sw)
       {
         if (m_controllers[i])
         {
-          if (!sw.DoMarker("Controller") || !m_controllers[i]->DoState(sw, true))
+          if (!sw.DoMarker("Controller") || !m_controllers[i]->DoState(sw, !is_memory_state))
             return false;
         }
       }
@@ -137,7 +137,7 @@ bool Pad::DoState(StateWrapper& sw)
     bool card_present = static_cast<bool>(m_memory_cards[i]);
     sw.Do(&card_present);
 
-    if (sw.IsReading() && card_present && !g_settings.load_devices_from_save_states)
+    if (sw.IsReading() && card_present && !g_settings.load_devices_from_save_states && !is_memory_state)
     {
       Log_WarningPrintf("Skipping loading memory card %u from save state.", i + 1u);
 
@@ -20,7 +20,8 @@ public:
   void Initialize();
   void Shutdown();
   void Reset();
-  bool DoState(StateWrapper& sw);
+  /// Memory states are reloaded within the same session, so they keep the current input and trust the card data.
+  bool DoState(StateWrapper& sw, bool is_memory_state);
 
   Controller* GetController(u32 slot) const { return m_controllers[slot].get(); }
   void SetController(u32 slot, std::unique_ptr<Controller> dev);
@@ -0,0 +1,332 @@
+#include "perf_timers.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "cpu_code_cache.h"
+#include "host_interface.h"
+#include "settings.h"
+#include "system.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+Log_SetChannel(PerfTimers);
+
+#ifdef WITH_IMGUI
+#include "imgui.h"
+#endif
+
+namespace PerfTimers {
+
+static void UpdateEnabled();
+static void WriteCSVLine();
+
+State g_state;
+
+static bool s_requested = false;
+static u64 s_frame_start_counter = 0;
+static Common::Timer::Value s_frame_start_time = 0;
+static std::atomic<u64> s_gpu_thread_ticks{0};
+
+static std::array<std::array<float, HISTORY_LENGTH>, NUM_CATEGORIES> s_history = {};
+static u32 s_history_position = 0;
+static u32 s_history_size = 0;
+static FrameTimes s_last_frame_times = {};
+
+static std::FILE* s_csv_file = nullptr;
+static u32 s_csv_frame_number = 0;
+
+static constexpr std::array<const char*, NUM_CATEGORIES> s_category_names = {
+  {"Other", "CPU", "GTE", "GPU", "GPUBackend", "SPU", "MDEC", "CDROM"}};
+static constexpr std::array<const char*, NUM_CATEGORIES> s_category_display_names = {
+  {"Other", "CPU", "GTE", "GPU Commands", "GPU Backend", "SPU", "MDEC", "CD-ROM"}};
+
+const char* GetCategoryName(Category category)
+{
+  return s_category_names[static_cast<u8>(category)];
+}
+
+const char* GetCategoryDisplayName(Category category)
+{
+  return s_category_display_names[static_cast<u8>(category)];
+}
+
+bool IsAvailable()
+{
+#ifdef WITH_PERF_TIMERS
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SetEnabled(bool enabled)
+{
+  s_requested = enabled;
+  UpdateEnabled();
+}
+
+void UpdateEnabled()
+{
+  const bool enabled = IsAvailable() && (s_requested || g_settings.debugging.show_perf_timers || s_csv_file);
+  if (g_state.enabled == enabled)
+    return;
+
+  Log_InfoPrintf("Subsystem timing %s.", enabled ? "enabled" : "disabled");
+  g_state.enabled = enabled;
+  s_gpu_thread_ticks.store(0);
+  BeginFrame();
+
+  // Recompiled blocks call the GTE op handlers directly, they need to be regenerated to pick up the timed dispatcher.
+  if (!System::IsShutdown() && g_settings.IsUsingRecompiler())
+    CPU::CodeCache::Flush();
+}
+
+void BeginFrame()
+{
+  if (!g_state.enabled)
+    return;
+
+  g_state.current = Category::Other;
+  g_state.last_switch = ReadCounter();
+  g_state.frame_ticks.fill(0);
+  g_state.frame_calls.fill(0);
+  s_frame_start_counter = g_state.last_switch;
+  s_frame_start_time = Common::Timer::GetValue();
+}
+
+void EndFrame()
+{
+  if (g_state.enabled)
+  {
+    SwitchCategory(Category::Other);
+
+    // Scale sampled categories up to all calls. The untimed calls were counted in whichever scope they were nested in,
+    // which is the GPU for the inline backend, and the CPU for everything else.
+    for (u32 i = 0; i < NUM_CATEGORIES; i++)
+    {
+      const u32 calls = g_state.frame_calls[i];
+      const u32 timed_calls = (calls <= SAMPLE_ALL_CALLS) ?
+                                calls :
+                                (SAMPLE_ALL_CALLS + (calls / SAMPLE_INTERVAL) - (SAMPLE_ALL_CALLS / SAMPLE_INTERVAL));
+      if (timed_calls == calls)
+        continue;
+
+      const Category parent =
+        (static_cast<Category>(i) == Category::GPUBackend) ? Category::GPU : Category::CPU;
+      u64& parent_ticks = g_state.frame_ticks[static_cast<u8>(parent)];
+      const u64 estimated_ticks = (g_state.frame_ticks[i] * calls) / timed_calls;
+      parent_ticks -= std::min(estimated_ticks - g_state.frame_ticks[i], parent_ticks);
+      g_state.frame_ticks[i] = estimated_ticks;
+    }
+
+    g_state.frame_ticks[static_cast<u8>(Category::GPUBackend)] += s_gpu_thread_ticks.exchange(0);
+
+    const u64 frame_ticks = g_state.last_switch - s_frame_start_counter;
+    const double frame_ms =
+      Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetValue() - s_frame_start_time);
+    const double ms_per_tick = (frame_ticks > 0) ? (frame_ms / static_cast<double>(frame_ticks)) : 0.0;
+    for (u32 i = 0; i < NUM_CATEGORIES; i++)
+    {
+      const float ms = static_cast<float>(static_cast<double>(g_state.frame_ticks[i]) * ms_per_tick);
+      s_last_frame_times.ms[i] = ms;
+      s_history[i][s_history_position] = ms;
+    }
+    s_last_frame_times.calls = g_state.frame_calls;
+    s_history_position = (s_history_position + 1) % HISTORY_LENGTH;
+    s_history_size = std::min<u32>(s_history_size + 1, HISTORY_LENGTH);
+
+    if (s_csv_file)
+      WriteCSVLine();
+  }
+
+  // The debug window can be closed at any time, so pick up the change here rather than tracking every caller.
+  UpdateEnabled();
+}
+
+void Reset()
+{
+  for (auto& history : s_history)
+    history.fill(0.0f);
+  s_history_position = 0;
+  s_history_size = 0;
+  s_last_frame_times = {};
+}
+
+void AddGPUThreadTime(u64 ticks)
+{
+  s_gpu_thread_ticks.fetch_add(ticks, std::memory_order_relaxed);
+}
+
+u32 GetHistoryStart()
+{
+  return (s_history_position + HISTORY_LENGTH - s_history_size) % HISTORY_LENGTH;
+}
+
+u32 GetHistorySize()
+{
+  return s_history_size;
+}
+
+const float* GetHistory(Category category)
+{
+  return s_history[static_cast<u8>(category)].data();
+}
+
+const FrameTimes& GetLastFrameTimes()
+{
+  return s_last_frame_times;
+}
+
+float GetAverageTime(Category category)
+{
+  if (s_history_size == 0)
+    return 0.0f;
+
+  const auto& history = s_history[static_cast<u8>(category)];
+  float sum = 0.0f;
+  for (u32 i = 0; i < s_history_size; i++)
+    sum += history[(GetHistoryStart() + i) % HISTORY_LENGTH];
+
+  return sum / static_cast<float>(s_history_size);
+}
+
+float GetWorstTime(Category category)
+{
+  const auto& history = s_history[static_cast<u8>(category)];
+  float worst = 0.0f;
+  for (u32 i = 0; i < s_history_size; i++)
+    worst = std::max(worst, history[(GetHistoryStart() + i) % HISTORY_LENGTH]);
+
+  return worst;
+}
+
+bool StartCSVDump(const char* filename)
+{
+  StopCSVDump();
+
+  s_csv_file = FileSystem::OpenCFile(filename, "wb");
+  if (!s_csv_file)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for timing dump", filename);
+    return false;
+  }
+
+  std::fputs("frame", s_csv_file);
+  for (u32 i = 0; i < NUM_CATEGORIES; i++)
+    std::fprintf(s_csv_file, ",%s_ms", s_category_names[i]);
+  std::fputs(",GTE_calls\n", s_csv_file);
+
+  s_csv_frame_number = 0;
+  Log_InfoPrintf("Dumping subsystem timings to '%s'", filename);
+  UpdateEnabled();
+  return true;
+}
+
+void StopCSVDump()
+{
+  if (!s_csv_file)
+    return;
+
+  std::fclose(s_csv_file);
+  s_csv_file = nullptr;
+  Log_InfoPrintf("Stopped dumping subsystem timings after %u frames", s_csv_frame_number);
+  UpdateEnabled();
+}
+
+bool IsDumpingCSV()
+{
+  return (s_csv_file != nullptr);
+}
+
+void WriteCSVLine()
+{
+  std::fprintf(s_csv_file, "%u", s_csv_frame_number++);
+  for (u32 i = 0; i < NUM_CATEGORIES; i++)
+    std::fprintf(s_csv_file, ",%.4f", s_last_frame_times.ms[i]);
+  std::fprintf(s_csv_file, ",%u\n", s_last_frame_times.calls[static_cast<u8>(Category::GTE)]);
+}
+
+void DrawDebugWindow()
+{
+#ifdef WITH_IMGUI
+  const float framebuffer_scale = ImGui::GetIO().DisplayFramebufferScale.x;
+
+  ImGui::SetNextWindowSize(ImVec2(500.0f * framebuffer_scale, 650.0f * framebuffer_scale), ImGuiCond_FirstUseEver);
+  if (!ImGui::Begin("Subsystem Timings", &g_settings.debugging.show_perf_timers))
+  {
+    ImGui::End();
+    return;
+  }
+
+  if (!IsAvailable())
+  {
+    ImGui::TextUnformatted("Timing scopes were not compiled into this build.");
+    ImGui::End();
+    return;
+  }
+
+  if (s_csv_file)
+  {
+    if (ImGui::Button("Stop CSV Dump"))
+      StopCSVDump();
+  }
+  else
+  {
+    if (ImGui::Button("Start CSV Dump"))
+    {
+      StartCSVDump(g_host_interface
+                     ->GetUserDirectoryRelativePath("dump/timings_%s.csv",
+                                                    HostInterface::GetTimestampStringForFileName().GetCharArray())
+                     .c_str());
+    }
+  }
+
+  ImGui::SameLine();
+  if (ImGui::Button("Clear History"))
+    Reset();
+
+  ImGui::Text("GTE ops last frame: %u (1 in %u timed after the first %u)",
+              s_last_frame_times.calls[static_cast<u8>(Category::GTE)], static_cast<u32>(SAMPLE_INTERVAL),
+              static_cast<u32>(SAMPLE_ALL_CALLS));
+  if (g_settings.gpu_use_thread)
+    ImGui::TextUnformatted("GPU Backend runs on its own thread and overlaps the other categories.");
+
+  ImGui::Columns(4);
+  ImGui::SetColumnWidth(0, 150.0f * framebuffer_scale);
+  ImGui::TextUnformatted("Subsystem");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Last");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Average");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Worst");
+  ImGui::NextColumn();
+
+  for (u32 i = 0; i < NUM_CATEGORIES; i++)
+  {
+    const Category category = static_cast<Category>(i);
+    ImGui::TextUnformatted(s_category_display_names[i]);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f ms", s_last_frame_times.ms[i]);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f ms", GetAverageTime(category));
+    ImGui::NextColumn();
+    ImGui::Text("%.3f ms", GetWorstTime(category));
+    ImGui::NextColumn();
+  }
+
+  ImGui::Columns(1);
+  ImGui::Separator();
+
+  for (u32 i = 0; i < NUM_CATEGORIES; i++)
+  {
+    const Category category = static_cast<Category>(i);
+    ImGui::PlotHistogram(s_category_display_names[i], s_history[i].data(), HISTORY_LENGTH, s_history_position,
+                         nullptr, 0.0f, std::max(GetWorstTime(category), 0.1f),
+                         ImVec2(0.0f, 40.0f * framebuffer_scale));
+  }
+
+  ImGui::End();
+#endif
+}
+
+} // namespace PerfTimers
@@ -0,0 +1,178 @@
+#pragma once
+#include "common/cpu_detect.h"
+#include "common/timer.h"
+#include "types.h"
+#include <array>
+
+#if defined(CPU_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Per-subsystem frame timing. Time on the CPU thread is attributed exclusively to the innermost active scope, so the
+// categories sum to the frame's emulation time. Scopes compile to nothing unless WITH_PERF_TIMERS is defined, and cost
+// a single flag test when timing is switched off at runtime.
+namespace PerfTimers {
+
+enum class Category : u8
+{
+  Other,
+  CPU,
+  GTE,
+  GPU,
+  GPUBackend,
+  SPU,
+  MDEC,
+  CDROM,
+  Count
+};
+
+enum : u32
+{
+  NUM_CATEGORIES = static_cast<u32>(Category::Count),
+  HISTORY_LENGTH = 256,
+
+  // Sampled scopes time every call until this many have been made in a frame, then one in SAMPLE_INTERVAL. The
+  // total is scaled up from the timed calls, so hot entry points like GTE ops don't pay for a timestamp pair each.
+  SAMPLE_ALL_CALLS = 64,
+  SAMPLE_INTERVAL = 32
+};
+
+struct FrameTimes
+{
+  std::array<float, NUM_CATEGORIES> ms;
+  std::array<u32, NUM_CATEGORIES> calls;
+};
+
+struct State
+{
+  bool enabled = false;
+  Category current = Category::Other;
+  u64 last_switch = 0;
+  std::array<u64, NUM_CATEGORIES> frame_ticks = {};
+  std::array<u32, NUM_CATEGORIES> frame_calls = {};
+};
+
+extern State g_state;
+
+const char* GetCategoryName(Category category);
+const char* GetCategoryDisplayName(Category category);
+
+/// Returns true if the scopes were compiled in.
+bool IsAvailable();
+
+/// Requests timing regardless of the debug window/CSV dump.
+void SetEnabled(bool enabled);
+ALWAYS_INLINE bool IsEnabled()
+{
+  return g_state.enabled;
+}
+
+/// Called by System around each host frame.
+void BeginFrame();
+void EndFrame();
+
+/// Clears the recorded history.
+void Reset();
+
+/// Time spent on the GPU thread, which runs outside the CPU thread's scopes. Thread-safe.
+void AddGPUThreadTime(u64 ticks);
+
+/// History is a ring buffer, oldest entry first when starting from GetHistoryStart().
+u32 GetHistoryStart();
+u32 GetHistorySize();
+const float* GetHistory(Category category);
+const FrameTimes& GetLastFrameTimes();
+float GetAverageTime(Category category);
+float GetWorstTime(Category category);
+
+/// Writes one line per frame to a CSV file until stopped.
+bool StartCSVDump(const char* filename);
+void StopCSVDump();
+bool IsDumpingCSV();
+
+void DrawDebugWindow();
+
+/// Raw cycle counter, converted to time against Common::Timer once per frame. Much cheaper than a clock syscall.
+ALWAYS_INLINE u64 ReadCounter()
+{
+#if defined(CPU_X64)
+  return __rdtsc();
+#elif defined(CPU_AARCH64) && !defined(_MSC_VER)
+  u64 value;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+#else
+  return Common::Timer::GetValue();
+#endif
+}
+
+ALWAYS_INLINE Category SwitchCategory(Category category)
+{
+  const u64 now = ReadCounter();
+  g_state.frame_ticks[static_cast<u8>(g_state.current)] += now - g_state.last_switch;
+  g_state.last_switch = now;
+
+  const Category previous = g_state.current;
+  g_state.current = category;
+  return previous;
+}
+
+class Scope
+{
+public:
+  ALWAYS_INLINE Scope(Category category) : m_active(g_state.enabled)
+  {
+    if (m_active)
+      m_previous = SwitchCategory(category);
+  }
+
+  ALWAYS_INLINE ~Scope()
+  {
+    if (m_active)
+      SwitchCategory(m_previous);
+  }
+
+private:
+  bool m_active;
+  Category m_previous = Category::Other;
+};
+
+class SampledScope
+{
+public:
+  ALWAYS_INLINE SampledScope(Category category) : m_active(g_state.enabled && ShouldSample(category))
+  {
+    if (m_active)
+      m_previous = SwitchCategory(category);
+  }
+
+  ALWAYS_INLINE ~SampledScope()
+  {
+    if (m_active)
+      SwitchCategory(m_previous);
+  }
+
+  ALWAYS_INLINE static bool ShouldSample(Category category)
+  {
+    const u32 calls = ++g_state.frame_calls[static_cast<u8>(category)];
+    return (calls <= SAMPLE_ALL_CALLS || (calls % SAMPLE_INTERVAL) == 0);
+  }
+
+private:
+  bool m_active;
+  Category m_previous = Category::Other;
+};
+
+} // namespace PerfTimers
+
+#ifdef WITH_PERF_TIMERS
+#define PERF_TIMER_SCOPE(category) PerfTimers::Scope perf_timer_scope(PerfTimers::Category::category)
+#define PERF_TIMER_SAMPLED_SCOPE(category) PerfTimers::SampledScope perf_timer_scope(PerfTimers::Category::category)
+#else
+#define PERF_TIMER_SCOPE(category)
+#define PERF_TIMER_SAMPLED_SCOPE(category)
+#endif
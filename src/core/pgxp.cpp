@@ -19,31 +19,12 @@
  ***************************************************************************/
 
 #include "pgxp.h"
+#include "common/memory_arena.h"
 #include "settings.h"
 #include <climits>
 #include <cmath>
 
 namespace PGXP {
-// pgxp_types.h
-typedef struct PGXP_value_Tag
-{
-  float x;
-  float y;
-  float z;
-  union
-  {
-    unsigned int flags;
-    unsigned char compFlags[4];
-    unsigned short halfFlags[2];
-  };
-  unsigned int count;
-  unsigned int value;
-
-  unsigned short gFlags;
-  unsigned char lFlags;
-  unsigned char hFlags;
-} PGXP_value;
-
 // pgxp_value.h
 typedef union
 {
@@ -94,6 +75,7 @@ typedef enum
 #define VALID_012 (VALID_0 | VALID_1 | VALID_2)
 #define VALID_ALL (VALID_0 | VALID_1 | VALID_2 | VALID_3)
 #define INV_VALID_ALL (ALL ^ VALID_ALL)
+static_assert(CPU_REGISTER_VALID_MASK == VALID_ALL);
 
 static const PGXP_value PGXP_value_invalid_address = {0.f, 0.f, 0.f, {0}, 0, 0, INVALID_ADDRESS, 0, 0};
 static const PGXP_value PGXP_value_zero = {0.f, 0.f, 0.f, {0}, 0, VALID_ALL, 0, 0, 0};
@@ -223,16 +205,18 @@ void PGXP_InitMem()
 {
   if (!Mem)
   {
-    Mem = static_cast<PGXP_value*>(std::calloc(PGXP_MEM_SIZE, sizeof(PGXP_value)));
+    // Most of the shadow memory is never touched, so only the pages which are used get backed.
+    Mem = static_cast<PGXP_value*>(Common::MemoryArena::AllocateSparseMemory(sizeof(PGXP_value) * PGXP_MEM_SIZE));
     if (!Mem)
     {
       std::fprintf(stderr, "Failed to allocate PGXP memory\n");
       std::abort();
     }
   }
-  else
+  else if (!Common::MemoryArena::ResetSparseMemory(Mem, sizeof(PGXP_value) * PGXP_MEM_SIZE))
   {
-    std::memset(Mem, 0, sizeof(PGXP_value) * PGXP_MEM_SIZE);
+    std::fprintf(stderr, "Failed to reset PGXP memory\n");
+    std::abort();
   }
 }
 
@@ -408,12 +392,12 @@ void Shutdown()
   cacheMode = mode_init;
   if (vertexCache)
   {
-    std::free(vertexCache);
+    Common::MemoryArena::FreeSparseMemory(vertexCache, sizeof(PGXP_value) * VERTEX_CACHE_SIZE);
     vertexCache = nullptr;
   }
   if (Mem)
   {
-    std::free(Mem);
+    Common::MemoryArena::FreeSparseMemory(Mem, sizeof(PGXP_value) * PGXP_MEM_SIZE);
     Mem = nullptr;
   }
 }
@@ -628,16 +612,18 @@ static void InitPGXPVertexCache()
 {
   if (!vertexCache)
   {
-    vertexCache = static_cast<PGXP_value*>(std::calloc(VERTEX_CACHE_SIZE, sizeof(PGXP_value)));
+    vertexCache =
+      static_cast<PGXP_value*>(Common::MemoryArena::AllocateSparseMemory(sizeof(PGXP_value) * VERTEX_CACHE_SIZE));
     if (!vertexCache)
     {
       std::fprintf(stderr, "Failed to allocate PGXP vertex cache memory\n");
       std::abort();
     }
   }
-  else
+  else if (!Common::MemoryArena::ResetSparseMemory(vertexCache, sizeof(PGXP_value) * VERTEX_CACHE_SIZE))
   {
-    memset(vertexCache, 0x00, VERTEX_CACHE_SIZE * sizeof(PGXP_value));
+    std::fprintf(stderr, "Failed to reset PGXP vertex cache memory\n");
+    std::abort();
   }
 }
 
@@ -890,6 +876,11 @@ void CPU_MOVE(u32 rd_and_rs, u32 rsVal)
   CPU_reg[(rd_and_rs >> 8)] = CPU_reg[Rs];
 }
 
+PGXP_value* GetCPURegister(u32 index)
+{
+  return &CPU_reg[index];
+}
+
 void CPU_ADDI(u32 instr, u32 rtVal, u32 rsVal)
 {
   // Rt = Rs + Imm (signed)
@@ -1328,9 +1319,14 @@ void CPU_SLTU(u32 instr, u32 rdVal, u32 rsVal, u32 rtVal)
 // Register mult/div
 ////////////////////////////////////
 
-void CPU_MULT(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
+void CPU_MULT(u32 instr, u32 rsVal, u32 rtVal)
 {
   // Hi/Lo = Rs * Rt (signed)
+  const u64 result =
+    static_cast<u64>(static_cast<s64>(static_cast<s32>(rsVal)) * static_cast<s64>(static_cast<s32>(rtVal)));
+  const u32 hiVal = static_cast<u32>(result >> 32);
+  const u32 loVal = static_cast<u32>(result);
+
   Validate(&CPU_reg[rs(instr)], rsVal);
   Validate(&CPU_reg[rt(instr)], rtVal);
 
@@ -1374,9 +1370,13 @@ void CPU_MULT(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
   CPU_Hi.value = hiVal;
 }
 
-void CPU_MULTU(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
+void CPU_MULTU(u32 instr, u32 rsVal, u32 rtVal)
 {
   // Hi/Lo = Rs * Rt (unsigned)
+  const u64 result = static_cast<u64>(rsVal) * static_cast<u64>(rtVal);
+  const u32 hiVal = static_cast<u32>(result >> 32);
+  const u32 loVal = static_cast<u32>(result);
+
   Validate(&CPU_reg[rs(instr)], rsVal);
   Validate(&CPU_reg[rt(instr)], rtVal);
 
@@ -1420,10 +1420,29 @@ void CPU_MULTU(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
   CPU_Hi.value = hiVal;
 }
 
-void CPU_DIV(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
+void CPU_DIV(u32 instr, u32 rsVal, u32 rtVal)
 {
   // Lo = Rs / Rt (signed)
   // Hi = Rs % Rt (signed)
+  const s32 num = static_cast<s32>(rsVal);
+  const s32 denom = static_cast<s32>(rtVal);
+  u32 hiVal, loVal;
+  if (denom == 0)
+  {
+    loVal = (num >= 0) ? UINT32_C(0xFFFFFFFF) : UINT32_C(1);
+    hiVal = rsVal;
+  }
+  else if (rsVal == UINT32_C(0x80000000) && denom == -1)
+  {
+    loVal = UINT32_C(0x80000000);
+    hiVal = 0;
+  }
+  else
+  {
+    loVal = static_cast<u32>(num / denom);
+    hiVal = static_cast<u32>(num % denom);
+  }
+
   Validate(&CPU_reg[rs(instr)], rsVal);
   Validate(&CPU_reg[rt(instr)], rtVal);
 
@@ -1453,10 +1472,13 @@ void CPU_DIV(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
   CPU_Hi.value = hiVal;
 }
 
-void CPU_DIVU(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal)
+void CPU_DIVU(u32 instr, u32 rsVal, u32 rtVal)
 {
   // Lo = Rs / Rt (unsigned)
   // Hi = Rs % Rt (unsigned)
+  const u32 loVal = (rtVal != 0) ? (rsVal / rtVal) : UINT32_C(0xFFFFFFFF);
+  const u32 hiVal = (rtVal != 0) ? (rsVal % rtVal) : rsVal;
+
   Validate(&CPU_reg[rs(instr)], rsVal);
   Validate(&CPU_reg[rt(instr)], rtVal);
 
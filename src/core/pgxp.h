@@ -23,6 +23,29 @@
 
 namespace PGXP {
 
+// pgxp_types.h
+typedef struct PGXP_value_Tag
+{
+  float x;
+  float y;
+  float z;
+  union
+  {
+    unsigned int flags;
+    unsigned char compFlags[4];
+    unsigned short halfFlags[2];
+  };
+  unsigned int count;
+  unsigned int value;
+
+  unsigned short gFlags;
+  unsigned char lFlags;
+  unsigned char hFlags;
+} PGXP_value;
+
+/// Flag bits which are cleared when a value no longer matches the one the CPU holds.
+constexpr u32 CPU_REGISTER_VALID_MASK = 0x01010101u;
+
 void Initialize();
 void Shutdown();
 
@@ -54,6 +77,9 @@ void CPU_SH(u32 instr, u16 rtVal, u32 addr);
 void CPU_SW(u32 instr, u32 rtVal, u32 addr);
 void CPU_MOVE(u32 rd_and_rs, u32 rsVal);
 
+/// Tracked state of CPU register index, 32 and 33 being hi and lo. Used by the recompiler to inline moves.
+PGXP_value* GetCPURegister(u32 index);
+
 // Arithmetic with immediate value
 void CPU_ADDI(u32 instr, u32 rtVal, u32 rsVal);
 void CPU_ADDIU(u32 instr, u32 rtVal, u32 rsVal);
@@ -78,11 +104,11 @@ void CPU_NOR(u32 instr, u32 rdVal, u32 rsVal, u32 rtVal);
 void CPU_SLT(u32 instr, u32 rdVal, u32 rsVal, u32 rtVal);
 void CPU_SLTU(u32 instr, u32 rdVal, u32 rsVal, u32 rtVal);
 
-// Register mult/div
-void CPU_MULT(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal);
-void CPU_MULTU(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal);
-void CPU_DIV(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal);
-void CPU_DIVU(u32 instr, u32 hiVal, u32 loVal, u32 rsVal, u32 rtVal);
+// Register mult/div, hi/lo are calculated from the inputs
+void CPU_MULT(u32 instr, u32 rsVal, u32 rtVal);
+void CPU_MULTU(u32 instr, u32 rsVal, u32 rtVal);
+void CPU_DIV(u32 instr, u32 rsVal, u32 rtVal);
+void CPU_DIVU(u32 instr, u32 rsVal, u32 rtVal);
 
 // Shift operations (sa)
 void CPU_SLL(u32 instr, u32 rdVal, u32 rtVal);
@@ -111,13 +111,26 @@ void Settings::Load(SettingsInterface& si)
 
   emulation_speed = si.GetFloatValue("Main", "EmulationSpeed", 1.0f);
   fast_forward_speed = si.GetFloatValue("Main", "FastForwardSpeed", 0.0f);
+  unthrottled_turbo = si.GetBoolValue("Main", "UnthrottledTurbo", false);
   increase_timer_resolution = si.GetBoolValue("Main", "IncreaseTimerResolution", true);
+  precise_throttle = si.GetBoolValue("Main", "PreciseThrottle", false);
+  sync_to_host_refresh_rate = si.GetBoolValue("Main", "SyncToHostRefreshRate", false);
   start_paused = si.GetBoolValue("Main", "StartPaused", false);
   start_fullscreen = si.GetBoolValue("Main", "StartFullscreen", false);
   pause_on_focus_loss = si.GetBoolValue("Main", "PauseOnFocusLoss", false);
   save_state_on_exit = si.GetBoolValue("Main", "SaveStateOnExit", true);
   confim_power_off = si.GetBoolValue("Main", "ConfirmPowerOff", true);
   load_devices_from_save_states = si.GetBoolValue("Main", "LoadDevicesFromSaveStates", false);
+  save_state_compression_level = static_cast<u32>(
+    std::clamp(si.GetIntValue("Main", "SaveStateCompressionLevel", DEFAULT_SAVE_STATE_COMPRESSION_LEVEL), 0, 9));
+  save_state_backups = si.GetBoolValue("Main", "CreateSaveStateBackups", false);
+  rewind_enable = si.GetBoolValue("Main", "RewindEnable", false);
+  rewind_save_frequency =
+    static_cast<u32>(std::max(si.GetIntValue("Main", "RewindFrequency", DEFAULT_REWIND_SAVE_FREQUENCY), 1));
+  rewind_max_memory =
+    static_cast<u32>(std::max(si.GetIntValue("Main", "RewindMaxMemory", DEFAULT_REWIND_MAX_MEMORY), 1));
+  runahead_frames = static_cast<u32>(
+    std::clamp(si.GetIntValue("Main", "RunaheadFrameCount", 0), 0, static_cast<int>(MAX_RUNAHEAD_FRAMES)));
   apply_game_settings = si.GetBoolValue("Main", "ApplyGameSettings", true);
   auto_load_cheats = si.GetBoolValue("Main", "AutoLoadCheats", false);
 
@@ -184,6 +197,7 @@ void Settings::Load(SettingsInterface& si)
   display_show_vps = si.GetBoolValue("Display", "ShowVPS", false);
   display_show_speed = si.GetBoolValue("Display", "ShowSpeed", false);
   display_show_resolution = si.GetBoolValue("Display", "ShowResolution", false);
+  display_show_frame_pacing = si.GetBoolValue("Display", "ShowFramePacing", false);
   video_sync_enabled = si.GetBoolValue("Display", "VSync", true);
   display_post_process_chain = si.GetStringValue("Display", "PostProcessChain", "");
   display_max_fps = si.GetFloatValue("Display", "MaxFPS", 0.0f);
@@ -202,6 +216,7 @@ void Settings::Load(SettingsInterface& si)
   audio_buffer_size = si.GetIntValue("Audio", "BufferSize", HostInterface::DEFAULT_AUDIO_BUFFER_SIZE);
   audio_output_muted = si.GetBoolValue("Audio", "OutputMuted", false);
   audio_sync_enabled = si.GetBoolValue("Audio", "Sync", true);
+  audio_time_stretch = si.GetBoolValue("Audio", "TimeStretch", false);
   audio_dump_on_boot = si.GetBoolValue("Audio", "DumpOnBoot", false);
 
   dma_max_slice_ticks = si.GetIntValue("Hacks", "DMAMaxSliceTicks", DEFAULT_DMA_MAX_SLICE_TICKS);
@@ -255,6 +270,7 @@ void Settings::Load(SettingsInterface& si)
   debugging.show_timers_state = si.GetBoolValue("Debug", "ShowTimersState");
   debugging.show_mdec_state = si.GetBoolValue("Debug", "ShowMDECState");
   debugging.show_dma_state = si.GetBoolValue("Debug", "ShowDMAState");
+  debugging.show_perf_timers = si.GetBoolValue("Debug", "ShowPerfTimers");
 
   texture_replacements.enable_vram_write_replacements =
     si.GetBoolValue("TextureReplacements", "EnableVRAMWriteReplacements", false);
@@ -274,13 +290,22 @@ void Settings::Save(SettingsInterface& si) const
 
   si.SetFloatValue("Main", "EmulationSpeed", emulation_speed);
   si.SetFloatValue("Main", "FastForwardSpeed", fast_forward_speed);
+  si.SetBoolValue("Main", "UnthrottledTurbo", unthrottled_turbo);
   si.SetBoolValue("Main", "IncreaseTimerResolution", increase_timer_resolution);
+  si.SetBoolValue("Main", "PreciseThrottle", precise_throttle);
+  si.SetBoolValue("Main", "SyncToHostRefreshRate", sync_to_host_refresh_rate);
   si.SetBoolValue("Main", "StartPaused", start_paused);
   si.SetBoolValue("Main", "StartFullscreen", start_fullscreen);
   si.SetBoolValue("Main", "PauseOnFocusLoss", pause_on_focus_loss);
   si.SetBoolValue("Main", "SaveStateOnExit", save_state_on_exit);
   si.SetBoolValue("Main", "ConfirmPowerOff", confim_power_off);
   si.SetBoolValue("Main", "LoadDevicesFromSaveStates", load_devices_from_save_states);
+  si.SetIntValue("Main", "SaveStateCompressionLevel", static_cast<int>(save_state_compression_level));
+  si.SetBoolValue("Main", "CreateSaveStateBackups", save_state_backups);
+  si.SetBoolValue("Main", "RewindEnable", rewind_enable);
+  si.SetIntValue("Main", "RewindFrequency", static_cast<int>(rewind_save_frequency));
+  si.SetIntValue("Main", "RewindMaxMemory", static_cast<int>(rewind_max_memory));
+  si.SetIntValue("Main", "RunaheadFrameCount", static_cast<int>(runahead_frames));
   si.SetBoolValue("Main", "ApplyGameSettings", apply_game_settings);
   si.SetBoolValue("Main", "AutoLoadCheats", auto_load_cheats);
 
@@ -331,6 +356,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Display", "ShowVPS", display_show_vps);
   si.SetBoolValue("Display", "ShowSpeed", display_show_speed);
   si.SetBoolValue("Display", "ShowResolution", display_show_speed);
+  si.SetBoolValue("Display", "ShowFramePacing", display_show_frame_pacing);
   si.SetBoolValue("Display", "VSync", video_sync_enabled);
   if (display_post_process_chain.empty())
     si.DeleteValue("Display", "PostProcessChain");
@@ -350,6 +376,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetIntValue("Audio", "BufferSize", audio_buffer_size);
   si.SetBoolValue("Audio", "OutputMuted", audio_output_muted);
   si.SetBoolValue("Audio", "Sync", audio_sync_enabled);
+  si.SetBoolValue("Audio", "TimeStretch", audio_time_stretch);
   si.SetBoolValue("Audio", "DumpOnBoot", audio_dump_on_boot);
 
   si.SetIntValue("Hacks", "DMAMaxSliceTicks", dma_max_slice_ticks);
@@ -392,6 +419,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Debug", "ShowTimersState", debugging.show_timers_state);
   si.SetBoolValue("Debug", "ShowMDECState", debugging.show_mdec_state);
   si.SetBoolValue("Debug", "ShowDMAState", debugging.show_dma_state);
+  si.SetBoolValue("Debug", "ShowPerfTimers", debugging.show_perf_timers);
 
   si.SetBoolValue("TextureReplacements", "EnableVRAMWriteReplacements",
                   texture_replacements.enable_vram_write_replacements);
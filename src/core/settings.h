@@ -81,13 +81,23 @@ struct Settings
 
   float emulation_speed = 1.0f;
   float fast_forward_speed = 0.0f;
+  bool unthrottled_turbo = false;
   bool increase_timer_resolution = true;
+  bool precise_throttle = false;
+  bool sync_to_host_refresh_rate = false;
   bool start_paused = false;
   bool start_fullscreen = false;
   bool pause_on_focus_loss = false;
   bool save_state_on_exit = true;
   bool confim_power_off = true;
   bool load_devices_from_save_states = false;
+  u32 save_state_compression_level = DEFAULT_SAVE_STATE_COMPRESSION_LEVEL;
+  bool save_state_backups = false;
+
+  bool rewind_enable = false;
+  u32 rewind_save_frequency = DEFAULT_REWIND_SAVE_FREQUENCY;
+  u32 rewind_max_memory = DEFAULT_REWIND_MAX_MEMORY;
+  u32 runahead_frames = 0;
   bool apply_game_settings = true;
   bool auto_load_cheats = false;
 
@@ -128,6 +138,7 @@ struct Settings
   bool display_show_vps = false;
   bool display_show_speed = false;
   bool display_show_resolution = false;
+  bool display_show_frame_pacing = false;
   bool video_sync_enabled = true;
   float display_max_fps = 0.0f;
   float gpu_pgxp_tolerance = -1.0f;
@@ -145,6 +156,7 @@ struct Settings
   u32 audio_buffer_size = 2048;
   bool audio_output_muted = false;
   bool audio_sync_enabled = true;
+  bool audio_time_stretch = false;
   bool audio_dump_on_boot = true;
 
   // timing hacks section
@@ -169,6 +181,7 @@ struct Settings
     mutable bool show_timers_state = false;
     mutable bool show_mdec_state = false;
     mutable bool show_dma_state = false;
+    mutable bool show_perf_timers = false;
   } debugging;
 
   // texture replacements
@@ -218,6 +231,7 @@ struct Settings
     return gpu_pgxp_enable ? (gpu_pgxp_cpu ? PGXPMode::CPU : PGXPMode::Memory) : PGXPMode::Disabled;
   }
 
+  ALWAYS_INLINE bool UsingPGXPCPUMode() const { return gpu_pgxp_enable && gpu_pgxp_cpu; }
   ALWAYS_INLINE bool UsingPGXPDepthBuffer() const { return gpu_pgxp_enable && gpu_pgxp_depth_buffer; }
   ALWAYS_INLINE float GetPGXPDepthClearThreshold() const { return gpu_pgxp_depth_clear_threshold * 4096.0f; }
   ALWAYS_INLINE void SetPGXPDepthClearThreshold(float value) { gpu_pgxp_depth_clear_threshold = value / 4096.0f; }
@@ -250,6 +264,10 @@ struct Settings
     DEFAULT_GPU_MAX_RUN_AHEAD = 128,
     DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD = 128,
     DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD = 128,
+    DEFAULT_SAVE_STATE_COMPRESSION_LEVEL = 1,
+    DEFAULT_REWIND_SAVE_FREQUENCY = 10,
+    DEFAULT_REWIND_MAX_MEMORY = 256,
+    MAX_RUNAHEAD_FRAMES = 10,
   };
 
   void Load(SettingsInterface& si);
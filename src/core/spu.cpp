@@ -1,18 +1,31 @@
 #include "spu.h"
 #include "cdrom.h"
 #include "common/audio_stream.h"
+#include "common/cpu_detect.h"
 #include "common/log.h"
 #include "common/state_wrapper.h"
+#include "common/timer.h"
 #include "common/wav_writer.h"
 #include "dma.h"
 #include "host_interface.h"
 #include "interrupt_controller.h"
+#include "perf_timers.h"
 #include "system.h"
 #ifdef WITH_IMGUI
 #include "imgui.h"
 #endif
 Log_SetChannel(SPU);
 
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
 SPU g_spu;
 
 SPU::SPU() = default;
@@ -104,10 +117,11 @@ void SPU::Reset()
   m_transfer_fifo.Clear();
   m_transfer_event->Deactivate();
   m_ram.fill(0);
+  ClearADPCMCache();
   UpdateEventInterval();
 }
 
-bool SPU::DoState(StateWrapper& sw)
+bool SPU::DoState(StateWrapper& sw, u8* ram_snapshot)
 {
   sw.Do(&m_ticks_carry);
   sw.Do(&m_SPUCNT.bits);
@@ -166,11 +180,22 @@ bool SPU::DoState(StateWrapper& sw)
   }
 
   sw.Do(&m_transfer_fifo);
-  sw.DoBytes(m_ram.data(), RAM_SIZE);
+
+  if (!ram_snapshot)
+    sw.DoBytes(m_ram.data(), RAM_SIZE);
+  else if (sw.IsReading())
+    std::memcpy(m_ram.data(), ram_snapshot, RAM_SIZE);
+  else
+    std::memcpy(ram_snapshot, m_ram.data(), RAM_SIZE);
 
   if (sw.IsReading())
   {
-    g_host_interface->GetAudioStream()->EmptyBuffers();
+    RevalidateADPCMCache();
+
+    // Run-ahead loads a memory state every host frame, the queued audio is still what should be played next.
+    if (!ram_snapshot)
+      g_host_interface->GetAudioStream()->EmptyBuffers();
+
     UpdateEventInterval();
     UpdateTransferEvent();
   }
@@ -696,6 +721,7 @@ void SPU::WriteToCaptureBuffer(u32 index, s16 value)
   const u32 ram_address = (index * CAPTURE_BUFFER_SIZE_PER_CHANNEL) | ZeroExtend16(m_capture_buffer_position);
   // Log_DebugPrintf("write to capture buffer %u (0x%08X) <- 0x%04X", index, ram_address, u16(value));
   std::memcpy(&m_ram[ram_address], &value, sizeof(value));
+  InvalidateADPCMCache(ram_address);
   CheckRAMIRQ(ram_address);
 }
 
@@ -750,6 +776,7 @@ void SPU::ExecuteTransfer(TickCount ticks)
       {
         u16 value = m_transfer_fifo.Pop();
         std::memcpy(&m_ram[m_transfer_address], &value, sizeof(u16));
+        InvalidateADPCMCache(m_transfer_address);
         m_transfer_address = (m_transfer_address + sizeof(u16)) & RAM_MASK;
         ticks -= TRANSFER_TICKS_PER_HALFWORD;
       }
@@ -1185,15 +1212,20 @@ void SPU::Voice::TickADSR()
   }
 }
 
-void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
+void SPU::Voice::ShiftBlockSamples()
 {
-  static constexpr std::array<s32, 5> filter_table_pos = {{0, 60, 115, 98, 122}};
-  static constexpr std::array<s32, 5> filter_table_neg = {{0, 0, -52, -55, -60}};
-
   // store samples needed for interpolation
   current_block_samples[2] = current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 1];
   current_block_samples[1] = current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 2];
   current_block_samples[0] = current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 3];
+}
+
+void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
+{
+  static constexpr std::array<s32, 5> filter_table_pos = {{0, 60, 115, 98, 122}};
+  static constexpr std::array<s32, 5> filter_table_neg = {{0, 0, -52, -55, -60}};
+
+  ShiftBlockSamples();
 
   // pre-lookup
   const u8 shift = block.GetShift();
@@ -1218,6 +1250,17 @@ void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
   current_block_flags.bits = block.flags.bits;
 }
 
+void SPU::Voice::LoadCachedBlock(const ADPCMCacheEntry& entry)
+{
+  ShiftBlockSamples();
+
+  std::copy(entry.samples.begin(), entry.samples.end(),
+            current_block_samples.begin() + NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK);
+  adpcm_last_samples[0] = entry.samples[NUM_SAMPLES_PER_ADPCM_BLOCK - 1];
+  adpcm_last_samples[1] = entry.samples[NUM_SAMPLES_PER_ADPCM_BLOCK - 2];
+  current_block_flags.bits = entry.flags.bits;
+}
+
 s32 SPU::Voice::Interpolate() const
 {
   static constexpr std::array<s16, 0x200> gauss = {{
@@ -1321,6 +1364,91 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
+void SPU::DecodeVoiceBlock(Voice& voice)
+{
+  ADPCMCacheEntry& entry = m_adpcm_cache[GetADPCMCacheIndex(voice.current_address)];
+  if (entry.address == voice.current_address && entry.last_samples == voice.adpcm_last_samples)
+  {
+    // still have to check IRQs, since we're skipping the read
+    const u32 ram_address = (ZeroExtend32(voice.current_address) * 8) & RAM_MASK;
+    CheckRAMIRQ(ram_address);
+    CheckRAMIRQ((ram_address + 8) & RAM_MASK);
+
+    voice.LoadCachedBlock(entry);
+    m_adpcm_cache_hits++;
+    return;
+  }
+
+  entry.address = voice.current_address;
+  entry.last_samples = voice.adpcm_last_samples;
+
+  ADPCMBlock block;
+  ReadADPCMBlock(voice.current_address, &block);
+  voice.DecodeBlock(block);
+
+  std::memcpy(&entry.block, &block, sizeof(block));
+  entry.flags.bits = voice.current_block_flags.bits;
+  std::copy(voice.current_block_samples.begin() + NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK, voice.current_block_samples.end(),
+            entry.samples.begin());
+  m_adpcm_cache_misses++;
+}
+
+void SPU::InvalidateADPCMCache(u32 ram_address)
+{
+  // A block is 16 bytes, so the write could be in the first or second half of a block.
+  const u32 address = ram_address / 8;
+  const u32 prev_address = (address - 1) & (RAM_MASK / 8);
+
+  ADPCMCacheEntry& entry = m_adpcm_cache[GetADPCMCacheIndex(address)];
+  if (entry.address == address)
+    entry.address = INVALID_ADPCM_CACHE_ADDRESS;
+
+  ADPCMCacheEntry& prev_entry = m_adpcm_cache[GetADPCMCacheIndex(prev_address)];
+  if (prev_entry.address == prev_address)
+    prev_entry.address = INVALID_ADPCM_CACHE_ADDRESS;
+}
+
+void SPU::RevalidateADPCMCache()
+{
+  // Run-ahead and rewind load states every frame, and most of the time SPU RAM hasn't changed. So only drop the
+  // entries whose source data differs, rather than throwing the whole cache away.
+  for (ADPCMCacheEntry& entry : m_adpcm_cache)
+  {
+    if (entry.address == INVALID_ADPCM_CACHE_ADDRESS)
+      continue;
+
+    u32 ram_address = (entry.address * 8) & RAM_MASK;
+    if ((ram_address + sizeof(ADPCMBlock)) <= RAM_SIZE)
+    {
+      if (std::memcmp(&entry.block, &m_ram[ram_address], sizeof(ADPCMBlock)) != 0)
+        entry.address = INVALID_ADPCM_CACHE_ADDRESS;
+
+      continue;
+    }
+
+    const u8* block_bytes = reinterpret_cast<const u8*>(&entry.block);
+    for (u32 i = 0; i < sizeof(ADPCMBlock); i++)
+    {
+      if (block_bytes[i] != m_ram[ram_address])
+      {
+        entry.address = INVALID_ADPCM_CACHE_ADDRESS;
+        break;
+      }
+
+      ram_address = (ram_address + 1) & RAM_MASK;
+    }
+  }
+}
+
+void SPU::ClearADPCMCache()
+{
+  for (ADPCMCacheEntry& entry : m_adpcm_cache)
+    entry.address = INVALID_ADPCM_CACHE_ADDRESS;
+
+  m_adpcm_cache_hits = 0;
+  m_adpcm_cache_misses = 0;
+}
+
 ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
 {
   Voice& voice = m_voices[voice_index];
@@ -1332,9 +1460,7 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
 
   if (!voice.has_samples)
   {
-    ADPCMBlock block;
-    ReadADPCMBlock(voice.current_address, &block);
-    voice.DecodeBlock(block);
+    DecodeVoiceBlock(voice);
     voice.has_samples = true;
 
     if (voice.current_block_flags.loop_start && !voice.ignore_loop_address)
@@ -1471,6 +1597,7 @@ void SPU::ReverbWrite(u32 address, s16 data)
   // TODO: This should check interrupts.
   const u32 real_address = ReverbMemoryAddress(address << 2);
   std::memcpy(&m_ram[real_address], &data, sizeof(data));
+  InvalidateADPCMCache(real_address);
 }
 
 // Zeroes optimized out; middle removed too(it's 16384)
@@ -1480,14 +1607,80 @@ static constexpr std::array<s16, 20> s_reverb_resample_coefficients = {
 static s16 s_last_reverb_input[2];
 static s32 s_last_reverb_output[2];
 
+#if defined(CPU_X64) || defined(CPU_AARCH64)
+
+// The downsampler only taps every other input sample, so interleave the coefficients with zeros and slot the middle
+// 0x4000 tap into its odd position. That way the whole 40-sample window goes through a 16x16->32 multiply-accumulate.
+static constexpr std::array<s16, 40> MakeReverbDownsampleCoefficients()
+{
+  std::array<s16, 40> coeffs = {};
+  for (u32 i = 0; i < 20; i++)
+    coeffs[i * 2] = s_reverb_resample_coefficients[i];
+  coeffs[19] = 0x4000;
+  return coeffs;
+}
+
+// The upsampler taps are contiguous, pad them out to a multiple of the vector width. The extra samples read are still
+// within the upsample buffer, and get multiplied by zero.
+static constexpr std::array<s16, 24> MakeReverbUpsampleCoefficients()
+{
+  std::array<s16, 24> coeffs = {};
+  for (u32 i = 0; i < 20; i++)
+    coeffs[i] = s_reverb_resample_coefficients[i];
+  return coeffs;
+}
+
+alignas(16) static constexpr std::array<s16, 40> s_reverb_downsample_coefficients = MakeReverbDownsampleCoefficients();
+alignas(16) static constexpr std::array<s16, 24> s_reverb_upsample_coefficients = MakeReverbUpsampleCoefficients();
+
+template<u32 num_taps>
+ALWAYS_INLINE static s32 ReverbFIR(const s16* src, const s16* coeffs)
+{
+  static_assert((num_taps % 8) == 0, "number of taps is a multiple of the vector width");
+
+#if defined(CPU_X64)
+  __m128i acc = _mm_setzero_si128();
+  for (u32 i = 0; i < num_taps; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i taps = _mm_load_si128(reinterpret_cast<const __m128i*>(coeffs + i));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(samples, taps));
+  }
+
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(acc);
+#elif defined(CPU_AARCH64)
+  int32x4_t acc = vdupq_n_s32(0);
+  for (u32 i = 0; i < num_taps; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int16x8_t taps = vld1q_s16(coeffs + i);
+    acc = vmlal_s16(acc, vget_low_s16(samples), vget_low_s16(taps));
+    acc = vmlal_high_s16(acc, samples, taps);
+  }
+
+  return vaddvq_s32(acc);
+#endif
+}
+
+#endif
+
 ALWAYS_INLINE static s32 Reverb4422(const s16* src)
 {
-  s32 out = 0; // 32-bits is adequate(it won't overflow)
+  s32 out; // 32-bits is adequate(it won't overflow)
+
+#if defined(CPU_X64) || defined(CPU_AARCH64)
+  out = ReverbFIR<40>(src, s_reverb_downsample_coefficients.data());
+#else
+  out = 0;
   for (u32 i = 0; i < 20; i++)
     out += s_reverb_resample_coefficients[i] * src[i * 2];
 
   // Middle non-zero
   out += 0x4000 * src[19];
+#endif
+
   out >>= 15;
   return std::clamp<s32>(out, -32768, 32767);
 }
@@ -1503,9 +1696,13 @@ ALWAYS_INLINE static s32 Reverb2244(const s16* src)
   }
   else
   {
+#if defined(CPU_X64) || defined(CPU_AARCH64)
+    out = ReverbFIR<24>(src, s_reverb_upsample_coefficients.data());
+#else
     out = 0;
     for (u32 i = 0; i < 20; i++)
       out += s_reverb_resample_coefficients[i] * src[i];
+#endif
 
     out >>= 14;
     out = std::clamp<s32>(out, -32768, 32767);
@@ -1626,6 +1823,8 @@ void SPU::ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out
 
 void SPU::Execute(TickCount ticks)
 {
+  PERF_TIMER_SAMPLED_SCOPE(SPU);
+
   u32 remaining_frames;
   if (g_settings.cpu_overclock_active)
   {
@@ -1645,7 +1844,16 @@ void SPU::Execute(TickCount ticks)
     AudioStream* const output_stream = g_host_interface->GetAudioStream();
     s16* output_frame_start;
     u32 output_frame_space = remaining_frames;
-    output_stream->BeginWrite(&output_frame_start, &output_frame_space);
+    if (m_audio_output_muted)
+    {
+      // Still mix so the SPU state advances identically, but throw the samples away.
+      output_frame_start = m_muted_output_buffer.data();
+      output_frame_space = MUTED_OUTPUT_BUFFER_FRAMES;
+    }
+    else
+    {
+      output_stream->BeginWrite(&output_frame_start, &output_frame_space);
+    }
 
     s16* output_frame = output_frame_start;
     const u32 frames_in_this_batch = std::min(remaining_frames, output_frame_space);
@@ -1736,10 +1944,14 @@ void SPU::Execute(TickCount ticks)
       IncrementCaptureBufferPosition();
     }
 
-    if (m_dump_writer)
-      m_dump_writer->WriteFrames(output_frame_start, frames_in_this_batch);
+    if (!m_audio_output_muted)
+    {
+      if (m_dump_writer)
+        m_dump_writer->WriteFrames(output_frame_start, frames_in_this_batch);
+
+      output_stream->EndWrite(frames_in_this_batch);
+    }
 
-    output_stream->EndWrite(frames_in_this_batch);
     remaining_frames -= frames_in_this_batch;
   }
 }
@@ -1843,6 +2055,34 @@ void SPU::DrawDebugStateWindow()
     ImGui::SameLine(offsets[0]);
     ImGui::TextColored(m_transfer_event->IsActive() ? active_color : inactive_color, "%u halfwords (%u bytes)",
                        m_transfer_fifo.GetSize(), m_transfer_fifo.GetSize() * 2);
+
+    const u64 adpcm_cache_lookups = m_adpcm_cache_hits + m_adpcm_cache_misses;
+    ImGui::Text("ADPCM Cache: ");
+    ImGui::SameLine(offsets[0]);
+    ImGui::Text("%" PRIu64 " hits, %" PRIu64 " misses (%.2f%% hit rate)", m_adpcm_cache_hits, m_adpcm_cache_misses,
+                (adpcm_cache_lookups > 0) ? (static_cast<double>(m_adpcm_cache_hits) * 100.0 /
+                                             static_cast<double>(adpcm_cache_lookups)) :
+                                            0.0);
+
+    // Resetting the peak every frame would only show the current latency.
+    AudioStream* audio_stream = g_host_interface->GetAudioStream();
+    const u64 current_time = Common::Timer::GetValue();
+    if (Common::Timer::ConvertValueToSeconds(current_time - m_audio_peak_latency_sample_time) >= 1.0)
+    {
+      m_audio_peak_latency = audio_stream->GetAndResetPeakLatency();
+      m_audio_peak_latency_sample_time = current_time;
+    }
+
+    ImGui::Text("Audio Output: ");
+    ImGui::SameLine(offsets[0]);
+    ImGui::Text("%.1f ms queued (1s peak %.1f ms, max %.1f ms)", audio_stream->GetCurrentLatency() * 1000.0f,
+                m_audio_peak_latency * 1000.0f, audio_stream->GetMaxLatency() * 1000.0f);
+    ImGui::SameLine(offsets[4]);
+    ImGui::TextColored((audio_stream->GetUnderflowCount() > 0) ? active_color : inactive_color, "%u underflows",
+                       audio_stream->GetUnderflowCount());
+    ImGui::SameLine(offsets[5]);
+    ImGui::TextColored((audio_stream->GetDroppedFrameCount() > 0) ? active_color : inactive_color, "%u dropped",
+                       audio_stream->GetDroppedFrameCount());
   }
 
   // draw voice states
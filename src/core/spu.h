@@ -17,6 +17,8 @@ class TimingEvent;
 class SPU
 {
 public:
+  static constexpr u32 RAM_SIZE = 512 * 1024;
+
   SPU();
   ~SPU();
 
@@ -24,7 +26,9 @@ public:
   void CPUClockChanged();
   void Shutdown();
   void Reset();
-  bool DoState(StateWrapper& sw);
+
+  /// If ram_snapshot is set, SPU RAM is copied to/from it instead of going through the state wrapper.
+  bool DoState(StateWrapper& sw, u8* ram_snapshot);
 
   u16 ReadRegister(u32 offset);
   void WriteRegister(u32 offset, u16 value);
@@ -47,8 +51,11 @@ public:
   /// Stops dumping audio to file, if started.
   bool StopDumpingAudio();
 
+  /// Discards generated samples instead of queuing them to the host, used for speculative (run-ahead) frames.
+  ALWAYS_INLINE bool IsAudioOutputMuted() const { return m_audio_output_muted; }
+  ALWAYS_INLINE void SetAudioOutputMuted(bool muted) { m_audio_output_muted = muted; }
+
 private:
-  static constexpr u32 RAM_SIZE = 512 * 1024;
   static constexpr u32 RAM_MASK = RAM_SIZE - 1;
   static constexpr u32 SPU_BASE = 0x1F801C00;
   static constexpr u32 NUM_VOICES = 24;
@@ -58,6 +65,7 @@ private:
   static constexpr u32 NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK = 3;
   static constexpr u32 SAMPLE_RATE = 44100;
   static constexpr u32 SYSCLK_TICKS_PER_SPU_TICK = System::MASTER_CLOCK / SAMPLE_RATE; // 0x300
+  static constexpr u32 MUTED_OUTPUT_BUFFER_FRAMES = 512;
   static constexpr s16 ENVELOPE_MIN_VOLUME = 0;
   static constexpr s16 ENVELOPE_MAX_VOLUME = 0x7FFF;
   static constexpr u32 CAPTURE_BUFFER_SIZE_PER_CHANNEL = 0x400;
@@ -65,6 +73,8 @@ private:
   static constexpr u32 NUM_REVERB_REGS = 32;
   static constexpr u32 FIFO_SIZE_IN_HALFWORDS = 32;
   static constexpr TickCount TRANSFER_TICKS_PER_HALFWORD = 32;
+  static constexpr u32 ADPCM_CACHE_SIZE = 1024;
+  static constexpr u32 INVALID_ADPCM_CACHE_ADDRESS = 0xFFFFFFFFu;
 
   enum class RAMTransferMode : u8
   {
@@ -208,6 +218,16 @@ private:
     u8 GetNibble(u32 index) const { return (data[index / 2] >> ((index % 2) * 4)) & 0x0F; }
   };
 
+  // Decoded samples for a block. Since the filters depend on the previous two samples, those are part of the key too.
+  struct ADPCMCacheEntry
+  {
+    u32 address; // in units of 8 bytes, same as the voice address
+    std::array<s16, 2> last_samples;
+    ADPCMBlock block; // source data, for revalidating after a state load
+    ADPCMFlags flags;
+    std::array<s16, NUM_SAMPLES_PER_ADPCM_BLOCK> samples;
+  };
+
   struct VolumeEnvelope
   {
     s32 counter;
@@ -264,7 +284,9 @@ private:
     void KeyOff();
     void ForceOff();
 
+    void ShiftBlockSamples();
     void DecodeBlock(const ADPCMBlock& block);
+    void LoadCachedBlock(const ADPCMCacheEntry& entry);
     s32 Interpolate() const;
 
     // Switches to the specified phase, filling in target.
@@ -339,6 +361,12 @@ private:
   void IncrementCaptureBufferPosition();
 
   void ReadADPCMBlock(u16 address, ADPCMBlock* block);
+  void DecodeVoiceBlock(Voice& voice);
+
+  static constexpr u32 GetADPCMCacheIndex(u32 address) { return (address >> 1) & (ADPCM_CACHE_SIZE - 1); }
+  void InvalidateADPCMCache(u32 ram_address);
+  void RevalidateADPCMCache();
+  void ClearADPCMCache();
   std::tuple<s32, s32> SampleVoice(u32 voice_index);
 
   void UpdateNoise();
@@ -359,6 +387,8 @@ private:
   std::unique_ptr<TimingEvent> m_tick_event;
   std::unique_ptr<TimingEvent> m_transfer_event;
   std::unique_ptr<Common::WAVWriter> m_dump_writer;
+  std::array<s16, MUTED_OUTPUT_BUFFER_FRAMES * 2> m_muted_output_buffer{};
+  bool m_audio_output_muted = false;
   TickCount m_ticks_carry = 0;
   TickCount m_cpu_ticks_per_spu_tick = 0;
   TickCount m_cpu_tick_divider = 0;
@@ -406,6 +436,14 @@ private:
   InlineFIFOQueue<u16, FIFO_SIZE_IN_HALFWORDS> m_transfer_fifo;
 
   std::array<u8, RAM_SIZE> m_ram{};
+
+  std::array<ADPCMCacheEntry, ADPCM_CACHE_SIZE> m_adpcm_cache{};
+  u64 m_adpcm_cache_hits = 0;
+  u64 m_adpcm_cache_misses = 0;
+
+  // Audio output peak latency shown in the debug window, sampled once a second.
+  u64 m_audio_peak_latency_sample_time = 0;
+  float m_audio_peak_latency = 0.0f;
 };
 
 extern SPU g_spu;
\ No newline at end of file
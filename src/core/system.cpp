@@ -23,14 +23,19 @@
 #include "mdec.h"
 #include "memory_card.h"
 #include "pad.h"
+#include "perf_timers.h"
 #include "psf_loader.h"
 #include "save_state_version.h"
 #include "sio.h"
 #include "spu.h"
 #include "texture_replacements.h"
 #include "timers.h"
+#include "zlib.h"
 #include <cctype>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <limits>
 Log_SetChannel(System);
@@ -51,6 +56,17 @@ SystemBootParameters::~SystemBootParameters() = default;
 
 namespace System {
 
+enum : u32
+{
+  MEMORY_STATE_RAM_OFFSET = 0,
+  MEMORY_STATE_VRAM_OFFSET = MEMORY_STATE_RAM_OFFSET + Bus::RAM_SIZE,
+  MEMORY_STATE_SPU_RAM_OFFSET = MEMORY_STATE_VRAM_OFFSET + VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16),
+  MEMORY_STATE_MEMORY_SIZE = MEMORY_STATE_SPU_RAM_OFFSET + SPU::RAM_SIZE,
+
+  // Enough for the serialized device state in most cases, it's grown if needed.
+  MEMORY_STATE_INITIAL_DATA_SIZE = 256 * 1024,
+};
+
 static bool LoadEXE(const char* filename);
 static bool LoadEXEFromBuffer(const void* buffer, u32 buffer_size);
 static bool LoadPSF(const char* filename);
@@ -60,13 +76,24 @@ static bool SetExpansionROM(const char* filename);
 static std::unique_ptr<CDImage> OpenCDImage(const char* path, bool force_preload);
 
 static bool DoLoadState(ByteStream* stream, bool force_software_renderer, bool update_display);
-static bool DoState(StateWrapper& sw, bool update_display);
+static bool DoState(StateWrapper& sw, bool update_display, u8* memory_state, bool incremental);
 static bool CreateGPU(GPURenderer renderer);
 
 static bool Initialize(bool force_software_renderer);
 
 static void UpdateRunningGame(const char* path, CDImage* image);
 
+static void EncodeRewindDelta(const u8* old_state, const u8* new_state, u32 num_words, std::vector<u8>* out);
+static bool ApplyRewindDelta(const u8* data, u32 data_size, u8* state, u32 num_words);
+static void SaveRewindState();
+static void DoRewind();
+static void TrimRewindStates(u64 max_memory);
+
+static void DoRunFrame();
+static void ExecuteFrame();
+static void DoRunahead();
+static void ClearRunaheadState();
+
 static State s_state = State::Shutdown;
 
 static ConsoleRegion s_region = ConsoleRegion::NTSC_U;
@@ -86,6 +113,18 @@ static u64 s_last_throttle_time = 0;
 static Common::Timer s_throttle_timer;
 static Common::Timer s_speed_lost_time_timestamp;
 
+// How late the OS wakes us from a sleep, for precise throttling. Adapts as the sleeps are measured.
+static u64 s_throttle_sleep_overshoot = 0;
+
+// Frame pacing, i.e. the spacing of the points where Throttle() returns.
+static Common::Timer::Value s_last_pacing_value = 0;
+static double s_pacing_interval_accumulator = 0.0;
+static double s_pacing_interval_squared_accumulator = 0.0;
+static float s_pacing_worst_error_accumulator = 0.0f;
+static u32 s_pacing_interval_count = 0;
+static float s_frame_pacing_deviation = 0.0f;
+static float s_frame_pacing_worst_error = 0.0f;
+
 static float s_average_frame_time_accumulator = 0.0f;
 static float s_worst_frame_time_accumulator = 0.0f;
 
@@ -99,6 +138,7 @@ static u32 s_last_internal_frame_number = 0;
 static u32 s_last_global_tick_counter = 0;
 static Common::Timer s_fps_timer;
 static Common::Timer s_frame_timer;
+static u32 s_last_run_frame_count = 1;
 
 // Playlist of disc images.
 static std::vector<std::string> s_media_playlist;
@@ -106,6 +146,36 @@ static std::string s_media_playlist_filename;
 
 static std::unique_ptr<CheatList> s_cheat_list;
 
+// Rewind history. The newest state is kept as a memory state, so saving it only copies what has changed since the last
+// save or load. Each older state is stored as a delta against the next newer state: runs of unchanged 64-bit words are
+// skipped, the XOR of changed words is kept, and the result is compressed. A copy of the newest state is kept to diff
+// the next save against, and is brought up to date by applying the same delta.
+struct RewindDelta
+{
+  std::vector<u8> compressed_data;
+  u32 packed_size;
+  u32 memory_packed_size;
+  u32 state_data_size;
+  u32 state_size;
+};
+static std::deque<RewindDelta> s_rewind_deltas;
+static MemorySaveState s_rewind_state;
+static MemorySaveState s_rewind_state_copy;
+static std::vector<u8> s_rewind_scratch;
+static u64 s_rewind_memory_used = 0;
+static u32 s_rewind_frames_since_save = 0;
+static u32 s_rewind_frames_since_load = 0;
+static bool s_rewinding = false;
+static float s_rewind_save_time_accumulator = 0.0f;
+static u32 s_rewind_save_count = 0;
+static float s_average_rewind_save_time = 0.0f;
+
+// Memory state which RAM/VRAM matched at the last snapshot save/load, incremental snapshots only apply to it.
+static const MemorySaveState* s_synced_memory_state = nullptr;
+
+static MemorySaveState s_runahead_state;
+static bool s_runahead_replay_pending = false;
+
 State GetState()
 {
   return s_state;
@@ -226,6 +296,14 @@ float GetWorstFrameTime()
 {
   return s_worst_frame_time;
 }
+float GetFramePacingDeviation()
+{
+  return s_frame_pacing_deviation;
+}
+float GetFramePacingWorstError()
+{
+  return s_frame_pacing_worst_error;
+}
 float GetThrottleFrequency()
 {
   return s_throttle_frequency;
@@ -496,7 +574,7 @@ bool RecreateGPU(GPURenderer renderer, bool update_display /* = true*/)
   // save current state
   std::unique_ptr<ByteStream> state_stream = ByteStream_CreateGrowableMemoryStream();
   StateWrapper sw(state_stream.get(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
-  const bool state_valid = g_gpu->DoState(sw, false) && TimingEvents::DoState(sw);
+  const bool state_valid = g_gpu->DoState(sw, nullptr, false, false) && TimingEvents::DoState(sw);
   if (!state_valid)
     Log_ErrorPrintf("Failed to save old GPU state when switching renderers");
 
@@ -518,7 +596,7 @@ bool RecreateGPU(GPURenderer renderer, bool update_display /* = true*/)
     state_stream->SeekAbsolute(0);
     sw.SetMode(StateWrapper::Mode::Read);
     g_gpu->RestoreGraphicsAPIState();
-    g_gpu->DoState(sw, update_display);
+    g_gpu->DoState(sw, nullptr, false, update_display);
     TimingEvents::DoState(sw);
     g_gpu->ResetGraphicsAPIState();
   }
@@ -715,6 +793,9 @@ bool Initialize(bool force_software_renderer)
   s_last_throttle_time = 0;
   s_throttle_timer.Reset();
   s_speed_lost_time_timestamp.Reset();
+  s_throttle_sleep_overshoot = 0;
+  s_frame_pacing_deviation = 0.0f;
+  s_frame_pacing_worst_error = 0.0f;
 
   s_average_frame_time_accumulator = 0.0f;
   s_worst_frame_time_accumulator = 0.0f;
@@ -792,6 +873,9 @@ void Shutdown()
   s_media_playlist.clear();
   s_media_playlist_filename.clear();
   s_cheat_list.reset();
+  ClearRewindStates();
+  ClearRunaheadState();
+  s_synced_memory_state = nullptr;
   s_state = State::Shutdown;
 }
 
@@ -833,7 +917,7 @@ bool CreateGPU(GPURenderer renderer)
   return true;
 }
 
-bool DoState(StateWrapper& sw, bool update_display)
+bool DoState(StateWrapper& sw, bool update_display, u8* memory_state, bool incremental)
 {
   if (!sw.DoMarker("System"))
     return false;
@@ -842,14 +926,18 @@ bool DoState(StateWrapper& sw, bool update_display)
   sw.Do(&s_frame_number);
   sw.Do(&s_internal_frame_number);
 
-  if (!sw.DoMarker("CPU") || !CPU::DoState(sw))
+  if (!sw.DoMarker("CPU") || !CPU::DoState(sw, memory_state != nullptr))
     return false;
 
-  if (sw.IsReading())
+  // Memory states invalidate only the code pages which changed, see Bus::DoState().
+  if (sw.IsReading() && !memory_state)
     CPU::CodeCache::Flush();
 
-  if (!sw.DoMarker("Bus") || !Bus::DoState(sw))
+  if (!sw.DoMarker("Bus") ||
+      !Bus::DoState(sw, memory_state ? memory_state + MEMORY_STATE_RAM_OFFSET : nullptr, incremental))
+  {
     return false;
+  }
 
   if (!sw.DoMarker("DMA") || !g_dma.DoState(sw))
     return false;
@@ -858,7 +946,9 @@ bool DoState(StateWrapper& sw, bool update_display)
     return false;
 
   g_gpu->RestoreGraphicsAPIState();
-  const bool gpu_result = sw.DoMarker("GPU") && g_gpu->DoState(sw, update_display);
+  u16* const vram_snapshot =
+    memory_state ? reinterpret_cast<u16*>(memory_state + MEMORY_STATE_VRAM_OFFSET) : nullptr;
+  const bool gpu_result = sw.DoMarker("GPU") && g_gpu->DoState(sw, vram_snapshot, incremental, update_display);
   g_gpu->ResetGraphicsAPIState();
   if (!gpu_result)
     return false;
@@ -866,13 +956,14 @@ bool DoState(StateWrapper& sw, bool update_display)
   if (!sw.DoMarker("CDROM") || !g_cdrom.DoState(sw))
     return false;
 
-  if (!sw.DoMarker("Pad") || !g_pad.DoState(sw))
+  if (!sw.DoMarker("Pad") || !g_pad.DoState(sw, memory_state != nullptr))
     return false;
 
   if (!sw.DoMarker("Timers") || !g_timers.DoState(sw))
     return false;
 
-  if (!sw.DoMarker("SPU") || !g_spu.DoState(sw))
+  if (!sw.DoMarker("SPU") ||
+      !g_spu.DoState(sw, memory_state ? memory_state + MEMORY_STATE_SPU_RAM_OFFSET : nullptr))
     return false;
 
   if (!sw.DoMarker("MDEC") || !g_mdec.DoState(sw))
@@ -933,8 +1024,11 @@ void Reset()
   g_sio.Reset();
   s_frame_number = 1;
   s_internal_frame_number = 0;
+  s_runahead_replay_pending = false;
+  s_synced_memory_state = nullptr;
   TimingEvents::Reset();
   ResetPerformanceCounters();
+  ClearRewindStates();
 
   g_gpu->ResetGraphicsAPIState();
 }
@@ -944,7 +1038,12 @@ bool LoadState(ByteStream* state, bool update_display)
   if (IsShutdown())
     return false;
 
-  return DoLoadState(state, false, update_display);
+  if (!DoLoadState(state, false, update_display))
+    return false;
+
+  // The history leads up to the old state, rewinding would jump back into it.
+  ClearRewindStates();
+  return true;
 }
 
 bool DoLoadState(ByteStream* state, bool force_software_renderer, bool update_display)
@@ -1068,7 +1167,8 @@ bool DoLoadState(ByteStream* state, bool force_software_renderer, bool update_di
       UpdateMemoryCards();
   }
 
-  if (header.data_compression_type != 0)
+  if (header.data_compression_type != SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE &&
+      header.data_compression_type != SAVE_STATE_HEADER::COMPRESSION_TYPE_ZLIB)
   {
     g_host_interface->ReportFormattedError("Unknown save state compression type %u", header.data_compression_type);
     return false;
@@ -1077,17 +1177,36 @@ bool DoLoadState(ByteStream* state, bool force_software_renderer, bool update_di
   if (!state->SeekAbsolute(header.offset_to_data))
     return false;
 
-  StateWrapper sw(state, StateWrapper::Mode::Read, header.version);
-  if (!DoState(sw, update_display))
+  std::unique_ptr<ByteStream> decompress_stream;
+  if (header.data_compression_type == SAVE_STATE_HEADER::COMPRESSION_TYPE_ZLIB)
+  {
+    decompress_stream =
+      ByteStream_CreateZlibDecompressStream(state, header.data_compressed_size, header.data_uncompressed_size);
+    if (!decompress_stream)
+      return false;
+  }
+
+  StateWrapper sw(decompress_stream ? decompress_stream.get() : state, StateWrapper::Mode::Read, header.version);
+  if (!DoState(sw, update_display, nullptr, false))
+    return false;
+
+  if (decompress_stream && decompress_stream->GetPosition() != header.data_uncompressed_size)
+  {
+    Log_ErrorPrintf("Save state data is %u bytes, header says %u",
+                    static_cast<u32>(decompress_stream->GetPosition()), header.data_uncompressed_size);
     return false;
+  }
 
   if (s_state == State::Starting)
     s_state = State::Running;
 
+  s_runahead_replay_pending = false;
+  s_synced_memory_state = nullptr;
+
   return true;
 }
 
-bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */)
+bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */, u32 compression_level /* = 0 */)
 {
   if (IsShutdown())
     return false;
@@ -1142,18 +1261,40 @@ bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */)
   {
     header.offset_to_data = static_cast<u32>(state->GetPosition());
 
+    // compressed data goes through a deflate stream on top of the output stream
+    std::unique_ptr<ByteStream> compress_stream;
+    if (compression_level > 0)
+    {
+      compress_stream =
+        ByteStream_CreateZlibCompressStream(state, static_cast<int>(std::min<u32>(compression_level, 9)));
+      if (!compress_stream)
+        return false;
+    }
+
     g_gpu->RestoreGraphicsAPIState();
 
-    StateWrapper sw(state, StateWrapper::Mode::Write, SAVE_STATE_VERSION);
-    const bool result = DoState(sw, false);
+    StateWrapper sw(compress_stream ? compress_stream.get() : state, StateWrapper::Mode::Write, SAVE_STATE_VERSION);
+    const bool result = DoState(sw, false, nullptr, false);
 
     g_gpu->ResetGraphicsAPIState();
 
     if (!result)
       return false;
 
-    header.data_compression_type = 0;
-    header.data_uncompressed_size = static_cast<u32>(state->GetPosition() - header.offset_to_data);
+    if (compress_stream)
+    {
+      if (!compress_stream->Commit())
+        return false;
+
+      header.data_compression_type = SAVE_STATE_HEADER::COMPRESSION_TYPE_ZLIB;
+      header.data_compressed_size = static_cast<u32>(state->GetPosition() - header.offset_to_data);
+      header.data_uncompressed_size = static_cast<u32>(compress_stream->GetPosition());
+    }
+    else
+    {
+      header.data_compression_type = SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE;
+      header.data_uncompressed_size = static_cast<u32>(state->GetPosition() - header.offset_to_data);
+    }
   }
 
   // re-write header
@@ -1167,11 +1308,107 @@ bool SaveState(ByteStream* state, u32 screenshot_size /* = 128 */)
   return true;
 }
 
+bool CompressState(const void* state_data, u32 state_size, ByteStream* state, u32 compression_level)
+{
+  SAVE_STATE_HEADER header;
+  if (state_size < sizeof(header))
+    return false;
+
+  std::memcpy(&header, state_data, sizeof(header));
+  if (header.magic != SAVE_STATE_MAGIC ||
+      header.data_compression_type != SAVE_STATE_HEADER::COMPRESSION_TYPE_NONE ||
+      (static_cast<u64>(header.offset_to_data) + header.data_uncompressed_size) > state_size)
+  {
+    return false;
+  }
+
+  // Everything before the data (header, media filename, screenshot) is copied as-is, so the offsets still hold.
+  const u8* data = static_cast<const u8*>(state_data);
+  if (!state->Write2(data, header.offset_to_data))
+    return false;
+
+  if (compression_level == 0)
+    return state->Write2(data + header.offset_to_data, header.data_uncompressed_size);
+
+  std::unique_ptr<ByteStream> compress_stream =
+    ByteStream_CreateZlibCompressStream(state, static_cast<int>(std::min<u32>(compression_level, 9)));
+  if (!compress_stream || !compress_stream->Write2(data + header.offset_to_data, header.data_uncompressed_size) ||
+      !compress_stream->Commit())
+  {
+    return false;
+  }
+
+  header.data_compression_type = SAVE_STATE_HEADER::COMPRESSION_TYPE_ZLIB;
+  header.data_compressed_size = static_cast<u32>(state->GetPosition() - header.offset_to_data);
+
+  const u64 end_position = state->GetPosition();
+  return (state->SeekAbsolute(0) && state->Write2(&header, sizeof(header)) && state->SeekAbsolute(end_position));
+}
+
+bool SaveMemoryState(MemorySaveState* mss)
+{
+  if (IsShutdown())
+    return false;
+
+  if (!mss->memory)
+  {
+    mss->memory = std::make_unique<u8[]>(MEMORY_STATE_MEMORY_SIZE);
+    mss->state_data.resize(MEMORY_STATE_INITIAL_DATA_SIZE);
+    if (s_synced_memory_state == mss)
+      s_synced_memory_state = nullptr;
+  }
+
+  // Memory which hasn't been written since the last save/load of this state doesn't need to be copied again.
+  bool incremental = (s_synced_memory_state == mss);
+
+  for (;;)
+  {
+    StateWrapper sw(mss->state_data.data(), static_cast<u32>(mss->state_data.size()), StateWrapper::Mode::Write,
+                    SAVE_STATE_VERSION);
+    if (DoState(sw, false, mss->memory.get(), incremental))
+    {
+      mss->state_size = static_cast<u32>(sw.GetPosition());
+      s_synced_memory_state = mss;
+      return true;
+    }
+
+    // The dirty areas have been cleared now, so any retry has to copy everything.
+    incremental = false;
+    s_synced_memory_state = nullptr;
+
+    // Running out of space is the only way writing can fail, e.g. with a large pending VRAM write or CD audio.
+    if (mss->state_data.size() >= MAX_SAVE_STATE_SIZE)
+      return false;
+
+    mss->state_data.resize(mss->state_data.size() * 2);
+  }
+}
+
+bool LoadMemoryState(const MemorySaveState& mss, bool update_display /* = false */)
+{
+  if (IsShutdown() || !mss.memory)
+    return false;
+
+  // Only the memory written since the last save/load of this state needs to be restored.
+  const bool incremental = (s_synced_memory_state == &mss);
+  s_synced_memory_state = nullptr;
+
+  // The buffers are only read from here.
+  StateWrapper sw(const_cast<u8*>(mss.state_data.data()), mss.state_size, StateWrapper::Mode::Read,
+                  SAVE_STATE_VERSION);
+  if (!DoState(sw, update_display, mss.memory.get(), incremental))
+    return false;
+
+  s_synced_memory_state = &mss;
+  return true;
+}
+
 void SingleStepCPU()
 {
   const u32 old_frame_number = s_frame_number;
 
   s_frame_timer.Reset();
+  s_last_run_frame_count = 1;
 
   g_gpu->RestoreGraphicsAPIState();
 
@@ -1188,9 +1425,112 @@ void SingleStepCPU()
 void RunFrame()
 {
   s_frame_timer.Reset();
+  s_last_run_frame_count = 1;
+  PerfTimers::BeginFrame();
+
+  if (s_rewinding)
+  {
+    DoRewind();
+    PerfTimers::EndFrame();
+    return;
+  }
+
+  // Roll back the frames we ran ahead last time, so this frame sees the new input.
+  if (s_runahead_replay_pending)
+  {
+    s_runahead_replay_pending = false;
+    if (!LoadMemoryState(s_runahead_state))
+    {
+      Log_ErrorPrintf("Failed to load run-ahead state");
+      ClearRunaheadState();
+    }
+  }
+
+  DoRunFrame();
+
+  if (g_settings.rewind_enable && ++s_rewind_frames_since_save >= g_settings.rewind_save_frequency)
+    SaveRewindState();
+
+  if (g_settings.runahead_frames > 0)
+    DoRunahead();
+  else if (s_runahead_state.memory)
+    ClearRunaheadState();
+
+  PerfTimers::EndFrame();
+}
+
+u32 RunTurboFrames(u32 max_frames, float max_seconds)
+{
+  if (s_rewinding)
+  {
+    RunFrame();
+    return 1;
+  }
+
+  s_frame_timer.Reset();
+  PerfTimers::BeginFrame();
+
+  // Nothing in between is presented, so there's no point predicting ahead.
+  if (s_runahead_replay_pending)
+  {
+    s_runahead_replay_pending = false;
+    if (!LoadMemoryState(s_runahead_state))
+      Log_ErrorPrintf("Failed to load run-ahead state");
+  }
+  if (s_runahead_state.memory)
+    ClearRunaheadState();
+
+  const Common::Timer::Value start_value = Common::Timer::GetValue();
+  const Common::Timer::Value max_value =
+    start_value + Common::Timer::ConvertNanosecondsToValue(static_cast<double>(max_seconds) * 1000000000.0);
 
+  g_spu.SetAudioOutputMuted(true);
   g_gpu->RestoreGraphicsAPIState();
 
+  u32 frames_run = 0;
+  for (;;)
+  {
+    // Only scan out the frame we expect to be the last, going by the average so far.
+    const Common::Timer::Value current_value = Common::Timer::GetValue();
+    const Common::Timer::Value average_frame_value =
+      (frames_run > 0) ? ((current_value - start_value) / frames_run) : 0;
+    const bool last_frame = ((frames_run + 1) >= max_frames || (current_value + average_frame_value) >= max_value);
+    g_gpu->SetDisplayUpdatesSkipped(!last_frame);
+
+    ExecuteFrame();
+    frames_run++;
+    if (last_frame || !IsRunning())
+      break;
+  }
+
+  if (s_cheat_list)
+    s_cheat_list->Apply();
+
+  g_gpu->SetDisplayUpdatesSkipped(false);
+  g_gpu->ResetGraphicsAPIState();
+  g_spu.SetAudioOutputMuted(false);
+
+  s_last_run_frame_count = frames_run;
+  PerfTimers::EndFrame();
+  return frames_run;
+}
+
+void DoRunFrame()
+{
+  g_gpu->RestoreGraphicsAPIState();
+
+  ExecuteFrame();
+
+  if (s_cheat_list)
+    s_cheat_list->Apply();
+
+  g_gpu->ResetGraphicsAPIState();
+}
+
+void ExecuteFrame()
+{
+  PERF_TIMER_SCOPE(CPU);
+
   if (CPU::g_state.use_debug_dispatcher)
   {
     CPU::ExecuteDebug();
@@ -1220,11 +1560,318 @@ void RunFrame()
 
   // Generate any pending samples from the SPU before sleeping, this way we reduce the chances of underruns.
   g_spu.GeneratePendingSamples();
+}
 
-  if (s_cheat_list)
-    s_cheat_list->Apply();
+void DoRunahead()
+{
+  if (!SaveMemoryState(&s_runahead_state))
+  {
+    Log_ErrorPrintf("Failed to save run-ahead state");
+    ClearRunaheadState();
+    return;
+  }
 
-  g_gpu->ResetGraphicsAPIState();
+  // The speculative frames are thrown away, so is their audio. The display is left showing the last one.
+  g_spu.SetAudioOutputMuted(true);
+  for (u32 i = 0; i < g_settings.runahead_frames; i++)
+    DoRunFrame();
+  g_spu.SetAudioOutputMuted(false);
+
+  s_runahead_replay_pending = true;
+}
+
+void ClearRunaheadState()
+{
+  if (s_synced_memory_state == &s_runahead_state)
+    s_synced_memory_state = nullptr;
+
+  s_runahead_state = {};
+  s_runahead_replay_pending = false;
+}
+
+void EncodeRewindDelta(const u8* old_state, const u8* new_state, u32 num_words, std::vector<u8>* out)
+{
+  // [u32 unchanged word count][u32 changed word count][changed words XOR'ed]..., appended to out.
+
+  u32 word = 0;
+  while (word < num_words)
+  {
+    u64 old_value, new_value;
+    const u32 run_start = word;
+
+    // Most of the state doesn't change between saves, so skip over unchanged blocks before looking at words.
+    static constexpr u32 BLOCK_WORDS = 64;
+    while ((word + BLOCK_WORDS) <= num_words &&
+           std::memcmp(old_state + word * sizeof(u64), new_state + word * sizeof(u64), BLOCK_WORDS * sizeof(u64)) == 0)
+    {
+      word += BLOCK_WORDS;
+    }
+
+    for (; word < num_words; word++)
+    {
+      std::memcpy(&old_value, old_state + word * sizeof(u64), sizeof(u64));
+      std::memcpy(&new_value, new_state + word * sizeof(u64), sizeof(u64));
+      if (old_value != new_value)
+        break;
+    }
+    if (word == num_words)
+      break;
+
+    const u32 skip_count = word - run_start;
+    const size_t header_pos = out->size();
+    out->resize(header_pos + sizeof(u32) * 2);
+    std::memcpy(out->data() + header_pos, &skip_count, sizeof(skip_count));
+
+    u32 changed_count = 0;
+    for (; word < num_words; word++)
+    {
+      std::memcpy(&old_value, old_state + word * sizeof(u64), sizeof(u64));
+      std::memcpy(&new_value, new_state + word * sizeof(u64), sizeof(u64));
+      if (old_value == new_value)
+        break;
+
+      const u64 delta = old_value ^ new_value;
+      const size_t pos = out->size();
+      out->resize(pos + sizeof(delta));
+      std::memcpy(out->data() + pos, &delta, sizeof(delta));
+      changed_count++;
+    }
+
+    std::memcpy(out->data() + header_pos + sizeof(u32), &changed_count, sizeof(changed_count));
+  }
+}
+
+bool ApplyRewindDelta(const u8* data, u32 data_size, u8* state, u32 num_words)
+{
+  const u8* data_end = data + data_size;
+  u32 word = 0;
+  while (data != data_end)
+  {
+    u32 skip_count, changed_count;
+    if (static_cast<size_t>(data_end - data) < sizeof(u32) * 2)
+      return false;
+
+    std::memcpy(&skip_count, data, sizeof(skip_count));
+    std::memcpy(&changed_count, data + sizeof(u32), sizeof(changed_count));
+    data += sizeof(u32) * 2;
+
+    word += skip_count;
+    if ((static_cast<u64>(word) + changed_count) > num_words ||
+        static_cast<size_t>(data_end - data) < (static_cast<size_t>(changed_count) * sizeof(u64)))
+    {
+      return false;
+    }
+
+    for (u32 i = 0; i < changed_count; i++, word++)
+    {
+      u64 value, delta;
+      std::memcpy(&value, state + word * sizeof(u64), sizeof(u64));
+      std::memcpy(&delta, data, sizeof(u64));
+      value ^= delta;
+      std::memcpy(state + word * sizeof(u64), &value, sizeof(u64));
+      data += sizeof(u64);
+    }
+  }
+
+  return true;
+}
+
+void SaveRewindState()
+{
+  Common::Timer save_timer;
+
+  if (!SaveMemoryState(&s_rewind_state))
+  {
+    Log_ErrorPrintf("Failed to save rewind state");
+    ClearRewindStates();
+    return;
+  }
+
+  // The state data buffer only grows, keep the copy's buffer the same size so they can be compared whole.
+  const u32 state_data_size = static_cast<u32>(s_rewind_state.state_data.size());
+  if (s_rewind_state_copy.memory)
+  {
+    s_rewind_state_copy.state_data.resize(state_data_size, 0);
+
+    s_rewind_scratch.clear();
+    EncodeRewindDelta(s_rewind_state_copy.memory.get(), s_rewind_state.memory.get(),
+                      MEMORY_STATE_MEMORY_SIZE / sizeof(u64), &s_rewind_scratch);
+    const u32 memory_packed_size = static_cast<u32>(s_rewind_scratch.size());
+    EncodeRewindDelta(s_rewind_state_copy.state_data.data(), s_rewind_state.state_data.data(),
+                      state_data_size / sizeof(u64), &s_rewind_scratch);
+
+    // Catch the copy up to the state we just saved.
+    if (!ApplyRewindDelta(s_rewind_scratch.data(), memory_packed_size, s_rewind_state_copy.memory.get(),
+                          MEMORY_STATE_MEMORY_SIZE / sizeof(u64)) ||
+        !ApplyRewindDelta(s_rewind_scratch.data() + memory_packed_size,
+                          static_cast<u32>(s_rewind_scratch.size()) - memory_packed_size,
+                          s_rewind_state_copy.state_data.data(), state_data_size / sizeof(u64)))
+    {
+      Log_ErrorPrintf("Failed to update rewind state copy");
+      ClearRewindStates();
+      return;
+    }
+
+    RewindDelta delta;
+    uLongf compressed_size = compressBound(static_cast<uLong>(s_rewind_scratch.size()));
+    delta.compressed_data.resize(compressed_size);
+    if (compress2(delta.compressed_data.data(), &compressed_size, s_rewind_scratch.data(),
+                  static_cast<uLong>(s_rewind_scratch.size()), Z_BEST_SPEED) != Z_OK)
+    {
+      Log_ErrorPrintf("Failed to compress rewind state");
+      ClearRewindStates();
+      return;
+    }
+
+    delta.compressed_data.resize(compressed_size);
+    delta.compressed_data.shrink_to_fit();
+    delta.packed_size = static_cast<u32>(s_rewind_scratch.size());
+    delta.memory_packed_size = memory_packed_size;
+    delta.state_data_size = state_data_size;
+    delta.state_size = s_rewind_state_copy.state_size;
+    s_rewind_memory_used += delta.compressed_data.size();
+    s_rewind_deltas.push_back(std::move(delta));
+  }
+  else
+  {
+    s_rewind_state_copy.memory = std::make_unique<u8[]>(MEMORY_STATE_MEMORY_SIZE);
+    std::memcpy(s_rewind_state_copy.memory.get(), s_rewind_state.memory.get(), MEMORY_STATE_MEMORY_SIZE);
+    s_rewind_state_copy.state_data = s_rewind_state.state_data;
+  }
+
+  s_rewind_state_copy.state_size = s_rewind_state.state_size;
+  s_rewind_frames_since_save = 0;
+  TrimRewindStates(static_cast<u64>(g_settings.rewind_max_memory) * 1048576);
+
+  s_rewind_save_time_accumulator += static_cast<float>(save_timer.GetTimeMilliseconds());
+  s_rewind_save_count++;
+}
+
+void DoRewind()
+{
+  // Go back at twice the rate we save, so rewinding doesn't take as long as the original play.
+  const u32 load_frequency = std::max<u32>(g_settings.rewind_save_frequency / 2, 1);
+  if (s_rewind_frames_since_load > 0 && ++s_rewind_frames_since_load <= load_frequency)
+    return;
+
+  s_rewind_frames_since_load = 1;
+
+  // First go back to the newest state if we've run past it, then walk the deltas.
+  if (s_rewind_frames_since_save == 0)
+  {
+    if (s_rewind_deltas.empty())
+      return;
+
+    // The newest state no longer matches what was last saved or loaded, so the next load has to restore everything.
+    if (s_synced_memory_state == &s_rewind_state)
+      s_synced_memory_state = nullptr;
+
+    const RewindDelta& delta = s_rewind_deltas.back();
+    const u32 state_data_words = delta.state_data_size / sizeof(u64);
+    const u32 state_packed_size = delta.packed_size - delta.memory_packed_size;
+    s_rewind_scratch.resize(delta.packed_size);
+    const u8* state_packed_data = s_rewind_scratch.data() + delta.memory_packed_size;
+    uLongf packed_size = delta.packed_size;
+    if (uncompress(s_rewind_scratch.data(), &packed_size, delta.compressed_data.data(),
+                   static_cast<uLong>(delta.compressed_data.size())) != Z_OK ||
+        packed_size != delta.packed_size || delta.state_data_size > s_rewind_state.state_data.size() ||
+        !ApplyRewindDelta(s_rewind_scratch.data(), delta.memory_packed_size, s_rewind_state.memory.get(),
+                          MEMORY_STATE_MEMORY_SIZE / sizeof(u64)) ||
+        !ApplyRewindDelta(s_rewind_scratch.data(), delta.memory_packed_size,
+                          s_rewind_state_copy.memory.get(), MEMORY_STATE_MEMORY_SIZE / sizeof(u64)) ||
+        !ApplyRewindDelta(state_packed_data, state_packed_size, s_rewind_state.state_data.data(), state_data_words) ||
+        !ApplyRewindDelta(state_packed_data, state_packed_size, s_rewind_state_copy.state_data.data(),
+                          state_data_words))
+    {
+      Log_ErrorPrintf("Failed to decompress rewind state");
+      ClearRewindStates();
+      return;
+    }
+
+    s_rewind_state.state_size = delta.state_size;
+    s_rewind_state_copy.state_size = delta.state_size;
+    s_rewind_memory_used -= delta.compressed_data.size();
+    s_rewind_deltas.pop_back();
+  }
+
+  if (!LoadMemoryState(s_rewind_state, true))
+  {
+    Log_ErrorPrintf("Failed to load rewind state");
+    ClearRewindStates();
+    return;
+  }
+
+  s_rewind_frames_since_save = 0;
+}
+
+void TrimRewindStates(u64 max_memory)
+{
+  while (!s_rewind_deltas.empty() && s_rewind_memory_used > max_memory)
+  {
+    s_rewind_memory_used -= s_rewind_deltas.front().compressed_data.size();
+    s_rewind_deltas.pop_front();
+  }
+}
+
+void SetRewinding(bool enabled)
+{
+  if (s_rewinding == enabled)
+    return;
+
+  s_rewinding = enabled && g_settings.rewind_enable && s_rewind_state.memory;
+  s_rewind_frames_since_load = 0;
+}
+
+bool IsRewinding()
+{
+  return s_rewinding;
+}
+
+void UpdateRewindSettings()
+{
+  if (!g_settings.rewind_enable)
+    ClearRewindStates();
+  else
+    TrimRewindStates(static_cast<u64>(g_settings.rewind_max_memory) * 1048576);
+}
+
+void ClearRewindStates()
+{
+  if (s_synced_memory_state == &s_rewind_state)
+    s_synced_memory_state = nullptr;
+
+  s_rewind_deltas.clear();
+  s_rewind_state = {};
+  s_rewind_state_copy = {};
+  s_rewind_scratch = {};
+  s_rewind_memory_used = 0;
+  s_rewind_frames_since_save = 0;
+  s_rewinding = false;
+}
+
+u32 GetRewindStateCount()
+{
+  return static_cast<u32>(s_rewind_deltas.size()) + (s_rewind_state.memory ? 1u : 0u);
+}
+
+u64 GetRewindMemoryUsage()
+{
+  // The newest state and its copy are held uncompressed.
+  if (!s_rewind_state.memory)
+    return s_rewind_memory_used;
+
+  return s_rewind_memory_used + (static_cast<u64>(MEMORY_STATE_MEMORY_SIZE) * 2) +
+         s_rewind_state.state_data.size() + s_rewind_state_copy.state_data.size();
+}
+
+float GetRewindHistoryLength()
+{
+  return static_cast<float>(s_rewind_deltas.size() * g_settings.rewind_save_frequency) / s_throttle_frequency;
+}
+
+float GetAverageRewindSaveTime()
+{
+  return s_average_rewind_save_time;
 }
 
 void SetTargetSpeed(float speed)
@@ -1239,10 +1886,36 @@ void SetThrottleFrequency(float frequency)
   UpdateThrottlePeriod();
 }
 
+static float GetEffectiveThrottleFrequency()
+{
+  // Within this, run at the host's refresh rate instead so each frame lines up with a vsync. The speed difference is
+  // too small to hear, and avoids the periodic doubled or dropped frame. Without audio sync or time stretching, the
+  // audio buffer would slowly under or overrun instead.
+  static constexpr float MAX_HOST_REFRESH_RATE_DIFFERENCE = 0.02f;
+
+  const HostDisplay* display = g_host_interface->GetDisplay();
+  if (!g_settings.sync_to_host_refresh_rate || s_target_speed != 1.0f || !display ||
+      (!g_settings.audio_sync_enabled && !g_settings.audio_time_stretch))
+  {
+    return s_throttle_frequency;
+  }
+
+  const float host_refresh_rate = display->GetWindowRefreshRate();
+  if (host_refresh_rate <= 0.0f ||
+      std::abs(host_refresh_rate - s_throttle_frequency) > (s_throttle_frequency * MAX_HOST_REFRESH_RATE_DIFFERENCE))
+  {
+    return s_throttle_frequency;
+  }
+
+  Log_VerbosePrintf("Syncing to host refresh rate of %.2f hz (console %.2f hz)", host_refresh_rate,
+                    s_throttle_frequency);
+  return host_refresh_rate;
+}
+
 void UpdateThrottlePeriod()
 {
-  s_throttle_period =
-    static_cast<s32>(1000000000.0 / static_cast<double>(s_throttle_frequency) / static_cast<double>(s_target_speed));
+  s_throttle_period = static_cast<s32>(1000000000.0 / static_cast<double>(GetEffectiveThrottleFrequency()) /
+                                       static_cast<double>(s_target_speed));
   ResetThrottler();
 }
 
@@ -1250,6 +1923,33 @@ void ResetThrottler()
 {
   s_last_throttle_time = 0;
   s_throttle_timer.Reset();
+  s_last_pacing_value = 0;
+}
+
+static void PreciseSleepUntil(u64 time)
+{
+  // Leave this much on top of the expected overshoot to spin through.
+  constexpr u64 SPIN_MARGIN = UINT64_C(100000);
+  constexpr u64 MAX_OVERSHOOT = UINT64_C(4000000);
+
+  const Common::Timer::Value start_value = s_throttle_timer.GetStartValue();
+  const u64 current_time = static_cast<u64>(s_throttle_timer.GetTimeNanoseconds());
+  const u64 sleep_margin = s_throttle_sleep_overshoot + SPIN_MARGIN;
+  if (time > (current_time + sleep_margin))
+  {
+    const u64 wake_time = time - sleep_margin;
+    Common::Timer::SleepUntil(start_value + Common::Timer::ConvertNanosecondsToValue(static_cast<double>(wake_time)));
+
+    // Move quickly towards later wake-ups so the next frame isn't late, but back off slowly.
+    const u64 woke_time = static_cast<u64>(s_throttle_timer.GetTimeNanoseconds());
+    const u64 overshoot = std::min((woke_time > wake_time) ? (woke_time - wake_time) : 0, MAX_OVERSHOOT);
+    if (overshoot > s_throttle_sleep_overshoot)
+      s_throttle_sleep_overshoot += (overshoot - s_throttle_sleep_overshoot) / 2;
+    else
+      s_throttle_sleep_overshoot -= (s_throttle_sleep_overshoot - overshoot) / 16;
+  }
+
+  Common::Timer::SpinUntil(start_value + Common::Timer::ConvertNanosecondsToValue(static_cast<double>(time)));
 }
 
 void Throttle()
@@ -1262,8 +1962,10 @@ void Throttle()
     return;
   }
 
-  // Allow variance of up to 40ms either way.
+  // Allow variance of up to 40ms either way. Precise mode resyncs after a single late frame instead, catching up over
+  // the following frames would show up as uneven pacing.
   constexpr s64 MAX_VARIANCE_TIME = INT64_C(40000000);
+  const s64 max_variance_time = g_settings.precise_throttle ? static_cast<s64>(s_throttle_period) : MAX_VARIANCE_TIME;
 
   // Don't sleep for <1ms or >=period.
   constexpr s64 MINIMUM_SLEEP_TIME = INT64_C(1000000);
@@ -1271,7 +1973,7 @@ void Throttle()
   // Use unsigned for defined overflow/wrap-around.
   const u64 time = static_cast<u64>(s_throttle_timer.GetTimeNanoseconds());
   const s64 sleep_time = static_cast<s64>(s_last_throttle_time - time);
-  if (sleep_time < -MAX_VARIANCE_TIME)
+  if (sleep_time < -max_variance_time)
   {
 #ifndef _DEBUG
     // Don't display the slow messages in debug, it'll always be slow...
@@ -1279,12 +1981,17 @@ void Throttle()
     if (s_speed_lost_time_timestamp.GetTimeSeconds() >= 1.0f)
     {
       Log_WarningPrintf("System too slow, lost %.2f ms",
-                        static_cast<double>(-sleep_time - MAX_VARIANCE_TIME) / 1000000.0);
+                        static_cast<double>(-sleep_time - max_variance_time) / 1000000.0);
       s_speed_lost_time_timestamp.Reset();
     }
 #endif
     ResetThrottler();
   }
+  else if (g_settings.precise_throttle)
+  {
+    if (sleep_time > 0)
+      PreciseSleepUntil(s_last_throttle_time);
+  }
   else if (sleep_time >= MINIMUM_SLEEP_TIME)
   {
 #ifdef WIN32
@@ -1295,14 +2002,28 @@ void Throttle()
 #endif
   }
 
+  const Common::Timer::Value pacing_value = Common::Timer::GetValue();
+  if (s_last_pacing_value != 0)
+  {
+    const double interval = Common::Timer::ConvertValueToMilliseconds(pacing_value - s_last_pacing_value);
+    const double error = std::abs(interval - static_cast<double>(s_throttle_period) / 1000000.0);
+    s_pacing_interval_accumulator += interval;
+    s_pacing_interval_squared_accumulator += interval * interval;
+    s_pacing_worst_error_accumulator = std::max(s_pacing_worst_error_accumulator, static_cast<float>(error));
+    s_pacing_interval_count++;
+  }
+  s_last_pacing_value = pacing_value;
+
   s_last_throttle_time += s_throttle_period;
 }
 
 void UpdatePerformanceCounters()
 {
-  const float frame_time = static_cast<float>(s_frame_timer.GetTimeMilliseconds());
-  s_average_frame_time_accumulator += frame_time;
-  s_worst_frame_time_accumulator = std::max(s_worst_frame_time_accumulator, frame_time);
+  // Turbo runs several frames per call, the worst time is tracked per frame.
+  const float run_time = static_cast<float>(s_frame_timer.GetTimeMilliseconds());
+  s_average_frame_time_accumulator += run_time;
+  s_worst_frame_time_accumulator =
+    std::max(s_worst_frame_time_accumulator, run_time / static_cast<float>(s_last_run_frame_count));
 
   // update fps counter
   const float time = static_cast<float>(s_fps_timer.GetTimeSeconds());
@@ -1316,6 +2037,29 @@ void UpdatePerformanceCounters()
   s_worst_frame_time_accumulator = 0.0f;
   s_average_frame_time = s_average_frame_time_accumulator / frames_presented;
   s_average_frame_time_accumulator = 0.0f;
+  s_average_rewind_save_time =
+    (s_rewind_save_count > 0) ? (s_rewind_save_time_accumulator / static_cast<float>(s_rewind_save_count)) : 0.0f;
+  s_rewind_save_time_accumulator = 0.0f;
+  s_rewind_save_count = 0;
+
+  if (s_pacing_interval_count > 0)
+  {
+    const double count = static_cast<double>(s_pacing_interval_count);
+    const double mean = s_pacing_interval_accumulator / count;
+    const double variance = std::max(s_pacing_interval_squared_accumulator / count - mean * mean, 0.0);
+    s_frame_pacing_deviation = static_cast<float>(std::sqrt(variance));
+    s_frame_pacing_worst_error = s_pacing_worst_error_accumulator;
+  }
+  else
+  {
+    s_frame_pacing_deviation = 0.0f;
+    s_frame_pacing_worst_error = 0.0f;
+  }
+  s_pacing_interval_accumulator = 0.0;
+  s_pacing_interval_squared_accumulator = 0.0;
+  s_pacing_worst_error_accumulator = 0.0f;
+  s_pacing_interval_count = 0;
+
   s_vps = static_cast<float>(frames_presented / time);
   s_last_frame_number = s_frame_number;
   s_fps = static_cast<float>(s_internal_frame_number - s_last_internal_frame_number) / time;
@@ -1326,8 +2070,8 @@ void UpdatePerformanceCounters()
   s_last_global_tick_counter = global_tick_counter;
   s_fps_timer.Reset();
 
-  Log_VerbosePrintf("FPS: %.2f VPS: %.2f Average: %.2fms Worst: %.2fms", s_fps, s_vps, s_average_frame_time,
-                    s_worst_frame_time);
+  Log_VerbosePrintf("FPS: %.2f VPS: %.2f Average: %.2fms Worst: %.2fms Pacing: %.3fms/%.3fms", s_fps, s_vps,
+                    s_average_frame_time, s_worst_frame_time, s_frame_pacing_deviation, s_frame_pacing_worst_error);
 
   g_host_interface->OnSystemPerformanceCountersUpdated();
 }
@@ -1644,6 +2388,9 @@ bool InsertMedia(const char* path)
 
   UpdateRunningGame(path, image.get());
   g_cdrom.InsertMedia(std::move(image));
+
+  // Rewind states don't hold the media, stepping back past the change would leave the CD-ROM out of sync with the disc.
+  ClearRewindStates();
   Log_InfoPrintf("Inserted media from %s (%s, %s)", s_running_game_path.c_str(), s_running_game_code.c_str(),
                  s_running_game_title.c_str());
 
@@ -1664,6 +2411,7 @@ bool InsertMedia(const char* path)
 void RemoveMedia()
 {
   g_cdrom.RemoveMedia();
+  ClearRewindStates();
 }
 
 void UpdateRunningGame(const char* path, CDImage* image)
@@ -1762,7 +2510,7 @@ bool RemoveMediaPathFromPlaylist(u32 index)
     g_host_interface->AddFormattedOSDMessage(
       10.0f,
       g_host_interface->TranslateString("System", "Removing current media from playlist, removing media from CD-ROM."));
-    g_cdrom.RemoveMedia();
+    RemoveMedia();
   }
 
   s_media_playlist.erase(s_media_playlist.begin() + index);
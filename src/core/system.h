@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 class ByteStream;
 class CDImage;
@@ -132,6 +133,12 @@ float GetVPS();
 float GetEmulationSpeed();
 float GetAverageFrameTime();
 float GetWorstFrameTime();
+
+/// Frame pacing over the last second: standard deviation of the intervals between throttled frames, and the largest
+/// difference of any interval from the target period. In milliseconds, zero when not throttling.
+float GetFramePacingDeviation();
+float GetFramePacingWorstError();
+
 float GetThrottleFrequency();
 
 bool Boot(const SystemBootParameters& params);
@@ -139,7 +146,25 @@ void Reset();
 void Shutdown();
 
 bool LoadState(ByteStream* state, bool update_display = true);
-bool SaveState(ByteStream* state, u32 screenshot_size = 128);
+
+/// Compression level is passed through to zlib (1-9), zero writes the state data uncompressed.
+bool SaveState(ByteStream* state, u32 screenshot_size = 128, u32 compression_level = 0);
+
+/// Writes an uncompressed state produced by SaveState() to the start of another stream, compressing the data. Touches
+/// no system state, so it can run on another thread while emulation continues.
+bool CompressState(const void* state_data, u32 state_size, ByteStream* state, u32 compression_level);
+
+/// Flat snapshot for frequent saves which are only ever loaded back within the same session, e.g. run-ahead and rewind.
+/// RAM, VRAM and SPU RAM are copied in bulk to fixed offsets, the remaining state is serialized straight into
+/// state_data. Both buffers are reused, so once they have been allocated neither saving nor loading allocates.
+struct MemorySaveState
+{
+  std::unique_ptr<u8[]> memory;
+  std::vector<u8> state_data;
+  u32 state_size = 0;
+};
+bool SaveMemoryState(MemorySaveState* mss);
+bool LoadMemoryState(const MemorySaveState& mss, bool update_display = false);
 
 /// Recreates the GPU component, saving/loading the state so it is preserved. Call when the GPU renderer changes.
 bool RecreateGPU(GPURenderer renderer, bool update_display = true);
@@ -147,6 +172,21 @@ bool RecreateGPU(GPURenderer renderer, bool update_display = true);
 void SingleStepCPU();
 void RunFrame();
 
+/// Runs frames back to back until max_frames have run, or running another would go past max_seconds. Only the last
+/// frame is scanned out to the host display, audio is discarded, and cheats are applied once at the end. Rewind states
+/// are not saved and run-ahead is skipped. Returns the number of frames run.
+u32 RunTurboFrames(u32 max_frames, float max_seconds);
+
+/// Rewind. While rewinding, RunFrame() steps back through the saved history instead of executing.
+void SetRewinding(bool enabled);
+bool IsRewinding();
+void UpdateRewindSettings();
+void ClearRewindStates();
+u32 GetRewindStateCount();
+u64 GetRewindMemoryUsage();
+float GetRewindHistoryLength();
+float GetAverageRewindSaveTime();
+
 /// Sets target emulation speed.
 void SetTargetSpeed(float speed);
 
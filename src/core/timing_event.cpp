@@ -9,10 +9,12 @@ Log_SetChannel(TimingEvents);
 
 namespace TimingEvents {
 
-static TimingEvent* s_active_events_head;
-static TimingEvent* s_active_events_tail;
+// Active events are kept in a binary min-heap ordered by the global tick they next run at, so passing time doesn't
+// touch them, and rescheduling is O(log n). Events due at the same time run in the order they were scheduled.
+static std::vector<TimingEvent*> s_active_events;
+static TimingEvent* s_active_events_head = nullptr;
 static TimingEvent* s_current_event = nullptr;
-static u32 s_active_event_count = 0;
+static u64 s_schedule_order = 0;
 static u32 s_global_tick_counter = 0;
 
 u32 GetGlobalTickCounter()
@@ -27,12 +29,19 @@ void Initialize()
 
 void Reset()
 {
+  // keep active events the same distance away
+  for (TimingEvent* event : s_active_events)
+  {
+    event->m_next_run_time -= s_global_tick_counter;
+    event->m_last_run_time -= s_global_tick_counter;
+  }
+
   s_global_tick_counter = 0;
 }
 
 void Shutdown()
 {
-  Assert(s_active_event_count == 0);
+  Assert(s_active_events.empty());
 }
 
 std::unique_ptr<TimingEvent> CreateTimingEvent(std::string name, TickCount period, TickCount interval,
@@ -50,7 +59,7 @@ void UpdateCPUDowncount()
 {
   if (!CPU::g_state.frame_done && (!CPU::HasPendingInterrupt() || CPU::g_using_interpreter))
   {
-    CPU::g_state.downcount = s_active_events_head->GetDowncount();
+    CPU::g_state.downcount = s_active_events_head->m_downcount;
   }
 }
 
@@ -59,188 +68,129 @@ TimingEvent** GetHeadEventPtr()
   return &s_active_events_head;
 }
 
-static void SortEvent(TimingEvent* event)
+static ALWAYS_INLINE TickCount GetTicksUntil(u32 time)
+{
+  return static_cast<TickCount>(time - s_global_tick_counter);
+}
+
+static ALWAYS_INLINE bool EventBefore(const TimingEvent* lhs, const TimingEvent* rhs)
+{
+  // The tick counter wraps, but events are never scheduled more than 2^31 ticks apart.
+  const TickCount diff = static_cast<TickCount>(lhs->m_next_run_time - rhs->m_next_run_time);
+  return (diff < 0 || (diff == 0 && lhs->m_schedule_order < rhs->m_schedule_order));
+}
+
+static ALWAYS_INLINE void SetHeapEntry(u32 index, TimingEvent* event)
 {
-  const TickCount event_downcount = event->m_downcount;
+  s_active_events[index] = event;
+  event->m_heap_index = index;
+}
 
-  if (event->prev && event->prev->m_downcount > event_downcount)
+/// Returns false if the event didn't need to move.
+static bool SiftUp(TimingEvent* event)
+{
+  const u32 start_index = event->m_heap_index;
+  u32 index = start_index;
+  while (index > 0)
   {
-    // move backwards
-    TimingEvent* current = event->prev;
-    while (current && current->m_downcount > event_downcount)
-      current = current->prev;
-
-    // unlink
-    if (event->prev)
-      event->prev->next = event->next;
-    else
-      s_active_events_head = event->next;
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_active_events_tail = event->prev;
-
-    // insert after current
-    if (current)
-    {
-      event->next = current->next;
-      if (current->next)
-        current->next->prev = event;
-      else
-        s_active_events_tail = event;
-
-      event->prev = current;
-      current->next = event;
-    }
-    else
-    {
-      // insert at front
-      DebugAssert(s_active_events_head);
-      s_active_events_head->prev = event;
-      event->prev = nullptr;
-      event->next = s_active_events_head;
-      s_active_events_head = event;
-      UpdateCPUDowncount();
-    }
+    const u32 parent = (index - 1) / 2;
+    if (!EventBefore(event, s_active_events[parent]))
+      break;
+
+    SetHeapEntry(index, s_active_events[parent]);
+    index = parent;
   }
-  else if (event->next && event_downcount > event->next->m_downcount)
-  {
-    // move forwards
-    TimingEvent* current = event->next;
-    while (current && event_downcount > current->m_downcount)
-      current = current->next;
-
-    // unlink
-    if (event->prev)
-      event->prev->next = event->next;
-    else
-      s_active_events_head = event->next;
-    if (event->next)
-      event->next->prev = event->prev;
-    else
-      s_active_events_tail = event->prev;
-
-    // insert before current
-    if (current)
-    {
-      event->next = current;
-      event->prev = current->prev;
 
-      if (current->prev)
-        current->prev->next = event;
-      else
-        s_active_events_head = event;
+  if (index == start_index)
+    return false;
 
-      current->prev = event;
-    }
-    else
-    {
-      // insert at back
-      DebugAssert(s_active_events_tail);
-      s_active_events_tail->next = event;
-      event->next = nullptr;
-      event->prev = s_active_events_tail;
-      s_active_events_tail = event;
-    }
-  }
+  SetHeapEntry(index, event);
+  return true;
 }
 
-static void AddActiveEvent(TimingEvent* event)
+static void SiftDown(TimingEvent* event)
 {
-  DebugAssert(!event->prev && !event->next);
-  s_active_event_count++;
-
-  TimingEvent* current = nullptr;
-  TimingEvent* next = s_active_events_head;
-  while (next && event->m_downcount > next->m_downcount)
+  const u32 count = static_cast<u32>(s_active_events.size());
+  const u32 start_index = event->m_heap_index;
+  u32 index = start_index;
+  for (;;)
   {
-    current = next;
-    next = next->next;
+    u32 child = index * 2 + 1;
+    if (child >= count)
+      break;
+    if ((child + 1) < count && EventBefore(s_active_events[child + 1], s_active_events[child]))
+      child++;
+    if (!EventBefore(s_active_events[child], event))
+      break;
+
+    SetHeapEntry(index, s_active_events[child]);
+    index = child;
   }
 
-  if (!next)
-  {
-    // new tail
-    event->prev = s_active_events_tail;
-    if (s_active_events_tail)
-    {
-      s_active_events_tail->next = event;
-      s_active_events_tail = event;
-    }
-    else
-    {
-      // first event
-      s_active_events_tail = event;
-      s_active_events_head = event;
-      UpdateCPUDowncount();
-    }
-  }
-  else if (!current)
-  {
-    // new head
-    event->next = s_active_events_head;
-    s_active_events_head->prev = event;
-    s_active_events_head = event;
-    UpdateCPUDowncount();
-  }
-  else
-  {
-    // inbetween current < event > next
-    event->prev = current;
-    event->next = next;
-    current->next = event;
-    next->prev = event;
-  }
+  if (index != start_index)
+    SetHeapEntry(index, event);
 }
 
-static void RemoveActiveEvent(TimingEvent* event)
+/// Moves an event whose run time changed into place, and refreshes the head.
+static void RestoreHeapOrder(TimingEvent* event)
 {
-  DebugAssert(s_active_event_count > 0);
+  if (!SiftUp(event))
+    SiftDown(event);
 
-  if (event->next)
+  TimingEvent* const old_head = s_active_events_head;
+  TimingEvent* const new_head = s_active_events[0];
+  if (new_head != old_head || new_head == event)
   {
-    event->next->prev = event->prev;
-  }
-  else
-  {
-    s_active_events_tail = event->prev;
-  }
+    s_active_events_head = new_head;
+    new_head->m_downcount = GetTicksUntil(new_head->m_next_run_time);
 
-  if (event->prev)
-  {
-    event->prev->next = event->next;
-  }
-  else
-  {
-    s_active_events_head = event->next;
-    if (s_active_events_head)
+    // RunEvents() updates the CPU once it's done.
+    if (!s_current_event)
       UpdateCPUDowncount();
   }
+}
 
-  event->prev = nullptr;
-  event->next = nullptr;
+static void SortEvent(TimingEvent* event)
+{
+  DebugAssert(s_active_events[event->m_heap_index] == event);
+  event->m_schedule_order = s_schedule_order++;
+  RestoreHeapOrder(event);
+}
 
-  s_active_event_count--;
+static void AddActiveEvent(TimingEvent* event)
+{
+  event->m_schedule_order = s_schedule_order++;
+  event->m_heap_index = static_cast<u32>(s_active_events.size());
+  s_active_events.push_back(event);
+  RestoreHeapOrder(event);
 }
 
-static void SortEvents()
+static void RemoveActiveEvent(TimingEvent* event)
 {
-  std::vector<TimingEvent*> events;
-  events.reserve(s_active_event_count);
+  DebugAssert(!s_active_events.empty() && s_active_events[event->m_heap_index] == event);
 
-  TimingEvent* next = s_active_events_head;
-  while (next)
+  TimingEvent* last = s_active_events.back();
+  s_active_events.pop_back();
+  if (s_active_events.empty())
   {
-    TimingEvent* current = next;
-    events.push_back(current);
-    next = current->next;
-    current->prev = nullptr;
-    current->next = nullptr;
+    s_active_events_head = nullptr;
+    return;
   }
 
+  if (last != event)
+  {
+    // fill the hole with the last event, which can need to move either way
+    SetHeapEntry(event->m_heap_index, last);
+    RestoreHeapOrder(last);
+  }
+}
+
+static void SortEvents()
+{
+  std::vector<TimingEvent*> events(std::move(s_active_events));
+  s_active_events.clear();
+  s_active_events.reserve(events.size());
   s_active_events_head = nullptr;
-  s_active_events_tail = nullptr;
-  s_active_event_count = 0;
 
   for (TimingEvent* event : events)
     AddActiveEvent(event);
@@ -248,7 +198,7 @@ static void SortEvents()
 
 static TimingEvent* FindActiveEvent(const char* name)
 {
-  for (TimingEvent* event = s_active_events_head; event; event = event->next)
+  for (TimingEvent* event : s_active_events)
   {
     if (event->GetName().compare(name) == 0)
       return event;
@@ -265,35 +215,30 @@ void RunEvents()
   CPU::ResetPendingTicks();
   while (pending_ticks > 0)
   {
-    const TickCount time = std::min(pending_ticks, s_active_events_head->GetDowncount());
+    // Only the head's downcount needs adjusting, the rest are relative to the tick counter.
+    // This will result in a negative downcount for the head if it is late.
+    const TickCount time = std::min(pending_ticks, s_active_events_head->m_downcount);
     s_global_tick_counter += static_cast<u32>(time);
+    s_active_events_head->m_downcount -= time;
     pending_ticks -= time;
 
-    // Apply downcount to all events.
-    // This will result in a negative downcount for those events which are late.
-    for (TimingEvent* event = s_active_events_head; event; event = event->next)
-    {
-      event->m_downcount -= time;
-      event->m_time_since_last_run += time;
-    }
-
     // Now we can actually run the callbacks.
     while (s_active_events_head->m_downcount <= 0)
     {
-      // move it to the end, since that'll likely be its new position
       TimingEvent* event = s_active_events_head;
       s_current_event = event;
 
       // Factor late time into the time for the next invocation.
       const TickCount ticks_late = -event->m_downcount;
-      const TickCount ticks_to_execute = event->m_time_since_last_run;
-      event->m_downcount += event->m_interval;
-      event->m_time_since_last_run = 0;
+      const TickCount ticks_to_execute = static_cast<TickCount>(s_global_tick_counter - event->m_last_run_time);
+      event->m_next_run_time += static_cast<u32>(event->m_interval);
+      event->m_last_run_time = s_global_tick_counter;
+
+      // Put it in its new position before the callback, which can reschedule or deactivate it.
+      SortEvent(event);
 
       // The cycles_late is only an indicator, it doesn't modify the cycles to execute.
       event->m_callback(ticks_to_execute, ticks_late);
-      if (event->m_active)
-        SortEvent(event);
     }
   }
 
@@ -332,8 +277,8 @@ bool DoState(StateWrapper& sw)
       }
 
       // Using reschedule is safe here since we call sort afterwards.
-      event->m_downcount = downcount;
-      event->m_time_since_last_run = time_since_last_run;
+      event->m_next_run_time = s_global_tick_counter + static_cast<u32>(downcount);
+      event->m_last_run_time = s_global_tick_counter - static_cast<u32>(time_since_last_run);
       event->m_period = period;
       event->m_interval = interval;
     }
@@ -349,19 +294,21 @@ bool DoState(StateWrapper& sw)
   }
   else
   {
+    u32 event_count = static_cast<u32>(s_active_events.size());
+    sw.Do(&event_count);
 
-    sw.Do(&s_active_event_count);
-
-    for (TimingEvent* event = s_active_events_head; event; event = event->next)
+    for (TimingEvent* event : s_active_events)
     {
+      TickCount downcount = GetTicksUntil(event->m_next_run_time);
+      TickCount time_since_last_run = static_cast<TickCount>(s_global_tick_counter - event->m_last_run_time);
       sw.Do(&event->m_name);
-      sw.Do(&event->m_downcount);
-      sw.Do(&event->m_time_since_last_run);
+      sw.Do(&downcount);
+      sw.Do(&time_since_last_run);
       sw.Do(&event->m_period);
       sw.Do(&event->m_interval);
     }
 
-    Log_DevPrintf("Wrote %u events to save state.", s_active_event_count);
+    Log_DevPrintf("Wrote %u events to save state.", event_count);
   }
 
   return !sw.HasError();
@@ -381,34 +328,40 @@ TimingEvent::~TimingEvent()
     TimingEvents::RemoveActiveEvent(this);
 }
 
+TickCount TimingEvent::GetDowncount() const
+{
+  return m_active ? TimingEvents::GetTicksUntil(m_next_run_time) : m_downcount;
+}
+
 TickCount TimingEvent::GetTicksSinceLastExecution() const
 {
-  return CPU::GetPendingTicks() + m_time_since_last_run;
+  const TickCount time_since_last_run =
+    m_active ? static_cast<TickCount>(TimingEvents::s_global_tick_counter - m_last_run_time) : m_time_since_last_run;
+  return CPU::GetPendingTicks() + time_since_last_run;
 }
 
 TickCount TimingEvent::GetTicksUntilNextExecution() const
 {
-  return std::max(m_downcount - CPU::GetPendingTicks(), static_cast<TickCount>(0));
+  return std::max(GetDowncount() - CPU::GetPendingTicks(), static_cast<TickCount>(0));
 }
 
 void TimingEvent::Schedule(TickCount ticks)
 {
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  m_downcount = pending_ticks + ticks;
+  const u32 current_time = TimingEvents::s_global_tick_counter + static_cast<u32>(CPU::GetPendingTicks());
+  m_next_run_time = current_time + static_cast<u32>(ticks);
 
   if (!m_active)
   {
     // Event is going active, so we want it to only execute ticks from the current timestamp.
-    m_time_since_last_run = -pending_ticks;
+    m_last_run_time = current_time;
     m_active = true;
     TimingEvents::AddActiveEvent(this);
   }
   else
   {
-    // Event is already active, so we leave the time since last run alone, and just modify the downcount.
+    // Event is already active, so we leave the time since last run alone, and just modify the run time.
     // If this is a call from an IO handler for example, re-sort the event queue.
-    if (TimingEvents::s_current_event != this)
-      TimingEvents::SortEvent(this);
+    TimingEvents::SortEvent(this);
   }
 }
 
@@ -430,10 +383,9 @@ void TimingEvent::Reset()
   if (!m_active)
     return;
 
-  m_downcount = m_interval;
-  m_time_since_last_run = 0;
-  if (TimingEvents::s_current_event != this)
-    TimingEvents::SortEvent(this);
+  m_next_run_time = TimingEvents::s_global_tick_counter + static_cast<u32>(m_interval);
+  m_last_run_time = TimingEvents::s_global_tick_counter;
+  TimingEvents::SortEvent(this);
 }
 
 void TimingEvent::InvokeEarly(bool force /* = false */)
@@ -441,18 +393,19 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   if (!m_active)
     return;
 
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  const TickCount ticks_to_execute = m_time_since_last_run + pending_ticks;
+  const u32 current_time = TimingEvents::s_global_tick_counter + static_cast<u32>(CPU::GetPendingTicks());
+  const TickCount ticks_to_execute = static_cast<TickCount>(current_time - m_last_run_time);
   if (!force && ticks_to_execute < m_period)
     return;
 
-  m_downcount = pending_ticks + m_interval;
-  m_time_since_last_run -= ticks_to_execute;
+  m_next_run_time = current_time + static_cast<u32>(m_interval);
+  m_last_run_time = current_time;
   m_callback(ticks_to_execute, 0);
 
-  // Since we've changed the downcount, we need to re-sort the events.
+  // Since we've changed the run time, we need to re-sort the events, unless the callback deactivated it.
   DebugAssert(TimingEvents::s_current_event != this);
-  TimingEvents::SortEvent(this);
+  if (m_active)
+    TimingEvents::SortEvent(this);
 }
 
 void TimingEvent::Activate()
@@ -461,9 +414,9 @@ void TimingEvent::Activate()
     return;
 
   // leave the downcount intact
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  m_downcount += pending_ticks;
-  m_time_since_last_run -= pending_ticks;
+  const u32 current_time = TimingEvents::s_global_tick_counter + static_cast<u32>(CPU::GetPendingTicks());
+  m_next_run_time = current_time + static_cast<u32>(m_downcount);
+  m_last_run_time = current_time - static_cast<u32>(m_time_since_last_run);
 
   m_active = true;
   TimingEvents::AddActiveEvent(this);
@@ -474,9 +427,9 @@ void TimingEvent::Deactivate()
   if (!m_active)
     return;
 
-  const TickCount pending_ticks = CPU::GetPendingTicks();
-  m_downcount -= pending_ticks;
-  m_time_since_last_run += pending_ticks;
+  const u32 current_time = TimingEvents::s_global_tick_counter + static_cast<u32>(CPU::GetPendingTicks());
+  m_downcount = static_cast<TickCount>(m_next_run_time - current_time);
+  m_time_since_last_run = static_cast<TickCount>(current_time - m_last_run_time);
 
   m_active = false;
   TimingEvents::RemoveActiveEvent(this);
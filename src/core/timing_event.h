@@ -23,7 +23,7 @@ public:
   // Returns the number of ticks between each event.
   ALWAYS_INLINE TickCount GetPeriod() const { return m_period; }
   ALWAYS_INLINE TickCount GetInterval() const { return m_interval; }
-  ALWAYS_INLINE TickCount GetDowncount() const { return m_downcount; }
+  TickCount GetDowncount() const;
 
   // Includes pending time.
   TickCount GetTicksSinceLastExecution() const;
@@ -56,9 +56,15 @@ public:
   void SetInterval(TickCount interval) { m_interval = interval; }
   void SetPeriod(TickCount period) { m_period = period; }
 
-  TimingEvent* prev = nullptr;
-  TimingEvent* next = nullptr;
+  // Position in the active event heap, and the order it was (re)scheduled in, which breaks ties.
+  u32 m_heap_index = 0;
+  u64 m_schedule_order = 0;
 
+  // Global tick counter values, only used while active.
+  u32 m_next_run_time = 0;
+  u32 m_last_run_time = 0;
+
+  // While active, only the head event's downcount is kept up to date, for the CPU.
   TickCount m_downcount;
   TickCount m_time_since_last_run;
   TickCount m_period;
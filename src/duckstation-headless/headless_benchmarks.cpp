@@ -0,0 +1,567 @@
+#include "headless_benchmarks.h"
+#include "common/audio_stream.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/string_util.h"
+#include "common/timer.h"
+#include "core/cpu_core.h"
+#include "core/mdec.h"
+#include "core/spu.h"
+#include "core/timing_event.h"
+#include "zlib.h"
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+Log_SetChannel(HeadlessBenchmarks);
+
+namespace HeadlessBenchmarks {
+
+namespace {
+enum : u32
+{
+  MDEC_DEFAULT_ITERATIONS = 20,
+  MDEC_SYNTHETIC_FRAMES = 30,
+  MDEC_SYNTHETIC_MACROBLOCKS_PER_FRAME = (320 / 16) * (240 / 16),
+
+  MDEC_CONTROL_RESET = UINT32_C(1) << 31,
+  MDEC_CONTROL_ENABLE_DMA_IN = UINT32_C(1) << 30,
+  MDEC_CONTROL_ENABLE_DMA_OUT = UINT32_C(1) << 29,
+
+  MDEC_STATUS_COMMAND_BUSY = UINT32_C(1) << 29,
+  MDEC_STATUS_DATA_IN_REQUEST = UINT32_C(1) << 28,
+  MDEC_STATUS_DATA_OUT_REQUEST = UINT32_C(1) << 27,
+  MDEC_STATUS_DEPTH_SHIFT = 25,
+  MDEC_STATUS_DEPTH_MASK = 3,
+
+  // Words for the 4-bit, 8-bit, 24-bit and 15-bit output of one macroblock (mono blocks for 4/8-bit).
+  MDEC_MAX_OUTPUT_WORDS = 192,
+
+  // How much DMA moves to or from the MDEC at a time, as games program it.
+  MDEC_DMA_BLOCK_SIZE = 32,
+
+  TICKS_PER_SECOND = 33868800,
+
+  TIMING_EVENTS_DEFAULT_SECONDS = 20,
+
+  SPU_DEFAULT_SECONDS = 60,
+  SPU_NUM_VOICES = 24,
+  SPU_SAMPLE_RATE = 44100,
+  SPU_BUFFER_SIZE = 2048,
+  SPU_SAMPLE_ADDRESS = 0x1000,
+  SPU_SAMPLE_BLOCKS = 64,
+  SPU_DMA_BLOCK_SIZE = 16,
+
+  SPU_REG_VOICE_STRIDE = 0x10,
+  SPU_REG_VOICE_VOLUME_LEFT = 0x00,
+  SPU_REG_VOICE_VOLUME_RIGHT = 0x02,
+  SPU_REG_VOICE_SAMPLE_RATE = 0x04,
+  SPU_REG_VOICE_START_ADDRESS = 0x06,
+  SPU_REG_VOICE_ADSR_LOW = 0x08,
+  SPU_REG_VOICE_ADSR_HIGH = 0x0A,
+  SPU_REG_MAIN_VOLUME_LEFT = 0x180,
+  SPU_REG_MAIN_VOLUME_RIGHT = 0x182,
+  SPU_REG_REVERB_VOLUME_LEFT = 0x184,
+  SPU_REG_REVERB_VOLUME_RIGHT = 0x186,
+  SPU_REG_KEY_ON_LOW = 0x188,
+  SPU_REG_KEY_ON_HIGH = 0x18A,
+  SPU_REG_REVERB_ON_LOW = 0x198,
+  SPU_REG_REVERB_ON_HIGH = 0x19A,
+  SPU_REG_REVERB_BASE_ADDRESS = 0x1A2,
+  SPU_REG_TRANSFER_ADDRESS = 0x1A6,
+  SPU_REG_CONTROL = 0x1AA,
+  SPU_REG_STATUS = 0x1AE,
+  SPU_REG_REVERB_CONFIG = 0x1C0,
+
+  SPU_CONTROL_ENABLE = 1 << 15,
+  SPU_CONTROL_UNMUTE = 1 << 14,
+  SPU_CONTROL_REVERB_MASTER_ENABLE = 1 << 7,
+  SPU_CONTROL_DMA_WRITE = 2 << 4,
+
+  SPU_STATUS_DMA_WRITE_REQUEST = 1 << 9,
+
+  SPU_ADPCM_FLAG_LOOP_END = 0x01,
+  SPU_ADPCM_FLAG_LOOP_REPEAT = 0x02,
+  SPU_ADPCM_FLAG_LOOP_START = 0x04,
+};
+
+struct TimingEventSpec
+{
+  const char* name;
+  TickCount interval;
+  bool oneshot;
+};
+
+// What the emulator has active while running a game, with typical intervals. Oneshot events deactivate themselves.
+static constexpr std::array<TimingEventSpec, 14> s_timing_event_specs = {{{"SPU Sample", 768, false},
+                                                                           {"GPU CRTC", 2150, false},
+                                                                           {"GPU Command Tick", 1000, true},
+                                                                           {"Timer 0", 4300, false},
+                                                                           {"Timer 1", 7200, false},
+                                                                           {"Timer 2", 65536, false},
+                                                                           {"CDROM Command", 50000, true},
+                                                                           {"CDROM Drive", 451584, false},
+                                                                           {"DMA", 600, true},
+                                                                           {"MDEC", 3000, true},
+                                                                           {"Memory Card", 1500, true},
+                                                                           {"Pad", 2200, true},
+                                                                           {"SIO", 9000, true},
+                                                                           {"System Frame", 564480, false}}};
+
+static constexpr std::array<u32, 4> s_mdec_output_words = {{8, 16, 192, 128}};
+
+// The hall reverb preset from the SDK, which needs 0xADE0 bytes of work area at the top of SPU RAM.
+static constexpr u16 s_spu_hall_reverb_base = (0x80000 - 0xADE0) / 8;
+static constexpr std::array<u16, 32> s_spu_hall_reverb_config = {
+  {0x01A5, 0x0139, 0x6000, 0x5000, 0x4C00, 0xB800, 0xBC00, 0xC000, 0x6000, 0x5C00, 0x15BA,
+   0x11BB, 0x14C2, 0x10BD, 0x11BC, 0x0DC1, 0x11C0, 0x0DC3, 0x0DC0, 0x09C1, 0x0BC4, 0x07C1,
+   0x0A00, 0x06CD, 0x09C2, 0x05C1, 0x05C0, 0x041A, 0x0274, 0x013A, 0x8000, 0x8000}};
+
+// Checksums everything the SPU mixes, in place of a device.
+class ChecksumAudioStream final : public AudioStream
+{
+public:
+  u32 GetCRC() const { return static_cast<u32>(m_crc); }
+  u64 GetFrameCount() const { return m_frame_count; }
+
+protected:
+  bool OpenDevice() override { return true; }
+  void PauseDevice(bool paused) override {}
+  void CloseDevice() override {}
+
+  void FramesAvailable() override
+  {
+    const u32 num_frames = GetSamplesAvailable();
+    m_frames.resize(num_frames * m_channels);
+    ReadFrames(m_frames.data(), num_frames, false);
+    m_crc = crc32(m_crc, reinterpret_cast<const Bytef*>(m_frames.data()),
+                  static_cast<uInt>(m_frames.size() * sizeof(SampleType)));
+    m_frame_count += num_frames;
+  }
+
+private:
+  std::vector<SampleType> m_frames;
+  uLong m_crc = crc32(0L, Z_NULL, 0);
+  u64 m_frame_count = 0;
+};
+} // namespace
+
+static u32 GetMDECParameterWordCount(u32 command_word)
+{
+  switch (command_word >> 29)
+  {
+    case 2: // Set quantisation table, chroma as well when bit 0 is set.
+      return 16 + (((command_word & 1) != 0) ? 16 : 0);
+
+    case 3: // Set scale table.
+      return 32;
+
+    default: // Decode macroblock, and the invalid commands.
+      return command_word & 0xFFFF;
+  }
+}
+
+static std::vector<u32> GenerateMDECStream()
+{
+  std::vector<u32> stream;
+
+  // Quantisation tables for both luma and chroma, which games upload before playing a movie.
+  stream.push_back(UINT32_C(0x40000001));
+  for (u32 i = 0; i < 32; i++)
+  {
+    u32 word = 0;
+    for (u32 j = 0; j < 4; j++)
+      word |= (2 + (((i * 4 + j) % 64) / 4)) << (j * 8);
+    stream.push_back(word);
+  }
+
+  // Standard IDCT scale table, cos((2x+1)u*pi/16) in 1.15 fixed point.
+  stream.push_back(UINT32_C(0x60000000));
+  std::array<u16, 64> scale_table;
+  for (u32 u = 0; u < 8; u++)
+  {
+    const double c = (u == 0) ? std::sqrt(0.5) : 1.0;
+    for (u32 x = 0; x < 8; x++)
+    {
+      const double value = 32768.0 * c * std::cos(static_cast<double>((2 * x + 1) * u) * 3.14159265358979323846 / 16.0);
+      scale_table[u * 8 + x] = static_cast<u16>(static_cast<s16>(std::lround(value)));
+    }
+  }
+  for (u32 i = 0; i < 64; i += 2)
+    stream.push_back(ZeroExtend32(scale_table[i]) | (ZeroExtend32(scale_table[i + 1]) << 16));
+
+  // One decode command per frame, each block being a DC coefficient and a few runs of AC coefficients.
+  std::mt19937 rng(1);
+  std::vector<u16> halfwords;
+  for (u32 frame = 0; frame < MDEC_SYNTHETIC_FRAMES; frame++)
+  {
+    halfwords.clear();
+    for (u32 mb = 0; mb < MDEC_SYNTHETIC_MACROBLOCKS_PER_FRAME; mb++)
+    {
+      for (u32 block = 0; block < 6; block++)
+      {
+        const u32 q_scale = 1 + (rng() % 8);
+        halfwords.push_back(static_cast<u16>((q_scale << 10) | (rng() & 0x3FF)));
+
+        u32 coefficient = 0;
+        const u32 num_ac = rng() % 24;
+        for (u32 i = 0; i < num_ac; i++)
+        {
+          const u32 run = rng() % 4;
+          coefficient += run + 1;
+          if (coefficient >= 64)
+            break;
+
+          const s32 level = static_cast<s32>(rng() % 128) - 64;
+          halfwords.push_back(static_cast<u16>((run << 10) | (static_cast<u32>(level) & 0x3FF)));
+        }
+
+        halfwords.push_back(0xFE00);
+      }
+    }
+
+    if (halfwords.size() % 2)
+      halfwords.push_back(0xFE00);
+
+    const u32 num_words = static_cast<u32>(halfwords.size() / 2);
+    stream.push_back(UINT32_C(0x30000000) | num_words);
+    for (u32 i = 0; i < num_words; i++)
+      stream.push_back(ZeroExtend32(halfwords[i * 2]) | (ZeroExtend32(halfwords[i * 2 + 1]) << 16));
+  }
+
+  return stream;
+}
+
+bool RunMDEC(const char* stream_filename, u32 iterations, ReportWriter& writer)
+{
+  std::vector<u32> stream;
+  if (stream_filename && stream_filename[0] != '\0')
+  {
+    std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(stream_filename);
+    if (!data.has_value() || data->size() < sizeof(u32))
+    {
+      Log_ErrorPrintf("Failed to read MDEC stream from '%s'", stream_filename);
+      return false;
+    }
+
+    stream.resize(data->size() / sizeof(u32));
+    std::memcpy(stream.data(), data->data(), stream.size() * sizeof(u32));
+  }
+  else
+  {
+    stream = GenerateMDECStream();
+  }
+
+  if (iterations == 0)
+    iterations = MDEC_DEFAULT_ITERATIONS;
+
+  TimingEvents::Initialize();
+  g_mdec.Initialize();
+
+  // The system always has something scheduled, the block copy out event isn't enough on its own.
+  std::unique_ptr<TimingEvent> idle_event = TimingEvents::CreateTimingEvent(
+    "Idle", TICKS_PER_SECOND, TICKS_PER_SECOND, [](TickCount ticks, TickCount ticks_late) {}, true);
+
+  std::array<u32, MDEC_MAX_OUTPUT_WORDS> output;
+  uLong output_crc = crc32(0L, Z_NULL, 0);
+  u64 macroblocks = 0;
+  bool stalled = false;
+
+  Common::Timer timer;
+  for (u32 iteration = 0; iteration < iterations && !stalled; iteration++)
+  {
+    g_mdec.WriteRegister(4, MDEC_CONTROL_RESET);
+    g_mdec.WriteRegister(4, MDEC_CONTROL_ENABLE_DMA_IN | MDEC_CONTROL_ENABLE_DMA_OUT);
+
+    size_t position = 0;
+    size_t command_end = 0;
+    bool idle_without_progress = false;
+    for (;;)
+    {
+      const u32 status = g_mdec.ReadRegister(4);
+      if (status & MDEC_STATUS_DATA_OUT_REQUEST)
+      {
+        // Copy out always queues a whole macroblock.
+        const u32 num_words = s_mdec_output_words[(status >> MDEC_STATUS_DEPTH_SHIFT) & MDEC_STATUS_DEPTH_MASK];
+        g_mdec.DMARead(output.data(), num_words);
+        output_crc = crc32(output_crc, reinterpret_cast<const Bytef*>(output.data()), num_words * sizeof(u32));
+        macroblocks++;
+        idle_without_progress = false;
+        continue;
+      }
+
+      // Games wait for the previous command to finish before starting the next, as a new command drops any output
+      // which hasn't been read yet.
+      if (position == command_end && position < stream.size() && !(status & MDEC_STATUS_COMMAND_BUSY))
+        command_end = position + 1 + GetMDECParameterWordCount(stream[position]);
+
+      if (position < command_end && (status & MDEC_STATUS_DATA_IN_REQUEST))
+      {
+        const u32 num_words =
+          static_cast<u32>(std::min<size_t>(std::min(command_end, stream.size()) - position, MDEC_DMA_BLOCK_SIZE));
+        g_mdec.DMAWrite(&stream[position], num_words);
+        position += num_words;
+        if (position == stream.size())
+          command_end = position;
+
+        idle_without_progress = false;
+        continue;
+      }
+
+      // Waiting for the decoder to finish a macroblock. It's only stuck if it's still busy after the idle event.
+      TimingEvent* next_event = *TimingEvents::GetHeadEventPtr();
+      if (next_event == idle_event.get())
+      {
+        if (!(status & MDEC_STATUS_COMMAND_BUSY) || idle_without_progress)
+        {
+          stalled = (position < stream.size());
+          break;
+        }
+
+        idle_without_progress = true;
+      }
+
+      CPU::AddPendingTicks(next_event->GetDowncount());
+      TimingEvents::RunEvents();
+    }
+  }
+
+  const double elapsed_seconds = timer.GetTimeSeconds();
+
+  idle_event.reset();
+  g_mdec.Shutdown();
+  TimingEvents::Shutdown();
+
+  if (stalled)
+  {
+    Log_ErrorPrintf("MDEC stopped requesting data before the end of the stream");
+    return false;
+  }
+
+  writer.Key("benchmark");
+  writer.String("mdec");
+  writer.Key("stream");
+  writer.String((stream_filename && stream_filename[0] != '\0') ? stream_filename : "synthetic");
+  writer.Key("stream_words");
+  writer.Uint64(stream.size());
+  writer.Key("iterations");
+  writer.Uint(iterations);
+  writer.Key("macroblocks");
+  writer.Uint64(macroblocks);
+  writer.Key("elapsed_seconds");
+  writer.Double(elapsed_seconds);
+  writer.Key("macroblocks_per_second");
+  writer.Double((elapsed_seconds > 0.0) ? (static_cast<double>(macroblocks) / elapsed_seconds) : 0.0);
+  writer.Key("output_crc32");
+  writer.String(StringUtil::StdStringFromFormat("%08" PRIX32, static_cast<u32>(output_crc)).c_str());
+  return true;
+}
+
+bool RunTimingEvents(u32 num_events, u32 seconds, ReportWriter& writer)
+{
+  if (num_events == 0)
+    num_events = static_cast<u32>(s_timing_event_specs.size());
+  if (seconds == 0)
+    seconds = TIMING_EVENTS_DEFAULT_SECONDS;
+
+  TimingEvents::Initialize();
+
+  // Extra events repeat the stock set.
+  std::vector<std::unique_ptr<TimingEvent>> events;
+  events.reserve(num_events);
+  u64 callbacks = 0;
+  for (u32 i = 0; i < num_events; i++)
+  {
+    const TimingEventSpec& spec = s_timing_event_specs[i % s_timing_event_specs.size()];
+    const bool oneshot = spec.oneshot;
+    events.push_back(TimingEvents::CreateTimingEvent(spec.name, spec.interval, spec.interval,
+                                                     [&callbacks, &events, i, oneshot](TickCount, TickCount) {
+                                                       callbacks++;
+                                                       if (oneshot)
+                                                         events[i]->Deactivate();
+                                                     },
+                                                     true));
+  }
+
+  // Three in four slices are cut short by an IO write which reschedules an event, like the GPU, DMA, pad and CD-ROM
+  // do. The CPU then runs up to the next event.
+  std::mt19937 rng(1234);
+  u64 reschedules = 0;
+  Common::Timer timer;
+  for (u32 second = 0; second < seconds; second++)
+  {
+    TickCount elapsed = 0;
+    while (elapsed < static_cast<TickCount>(TICKS_PER_SECOND))
+    {
+      const u32 r = rng();
+      if ((r & 3) != 0)
+      {
+        const TickCount downcount = std::max<TickCount>((*TimingEvents::GetHeadEventPtr())->m_downcount, 1);
+        const TickCount partial = static_cast<TickCount>((r >> 8) % static_cast<u32>(downcount));
+        CPU::AddPendingTicks(partial);
+        elapsed += partial;
+
+        const u32 index = (r >> 24) % num_events;
+        events[index]->Schedule(s_timing_event_specs[index % s_timing_event_specs.size()].interval);
+        reschedules++;
+      }
+
+      const TickCount slice =
+        std::max<TickCount>((*TimingEvents::GetHeadEventPtr())->m_downcount - CPU::GetPendingTicks(), 1);
+      CPU::AddPendingTicks(slice);
+      elapsed += slice;
+      TimingEvents::RunEvents();
+      TimingEvents::UpdateCPUDowncount();
+    }
+  }
+
+  const double elapsed_seconds = timer.GetTimeSeconds();
+  const u32 global_tick_counter = TimingEvents::GetGlobalTickCounter();
+
+  events.clear();
+  TimingEvents::Shutdown();
+
+  writer.Key("benchmark");
+  writer.String("timing-events");
+  writer.Key("events");
+  writer.Uint(num_events);
+  writer.Key("emulated_seconds");
+  writer.Uint(seconds);
+  writer.Key("callbacks_per_second");
+  writer.Uint64(callbacks / seconds);
+  writer.Key("reschedules_per_second");
+  writer.Uint64(reschedules / seconds);
+  writer.Key("elapsed_seconds");
+  writer.Double(elapsed_seconds);
+  writer.Key("ms_per_emulated_second");
+  writer.Double(elapsed_seconds * 1000.0 / seconds);
+  writer.Key("global_tick_counter");
+  writer.Uint(global_tick_counter);
+  return true;
+}
+
+static std::vector<u32> GenerateSPUSample()
+{
+  // A looping noisy waveform, using all of the ADPCM filters and a range of shifts so the decoder isn't idle.
+  std::mt19937 rng(42);
+  std::vector<u8> blocks(SPU_SAMPLE_BLOCKS * 16);
+  for (u32 block = 0; block < SPU_SAMPLE_BLOCKS; block++)
+  {
+    u8* data = &blocks[block * 16];
+    data[0] = static_cast<u8>(((rng() % 5) << 4) | (4 + (rng() % 8)));
+    data[1] = (block == 0) ? SPU_ADPCM_FLAG_LOOP_START : 0;
+    if (block == (SPU_SAMPLE_BLOCKS - 1))
+      data[1] |= SPU_ADPCM_FLAG_LOOP_END | SPU_ADPCM_FLAG_LOOP_REPEAT;
+    for (u32 i = 2; i < 16; i++)
+      data[i] = static_cast<u8>(rng());
+  }
+
+  std::vector<u32> words(blocks.size() / sizeof(u32));
+  std::memcpy(words.data(), blocks.data(), blocks.size());
+  return words;
+}
+
+static void RunUntilSPUIdle()
+{
+  // Uploads go through the transfer FIFO, which drains on its own event.
+  while (!(g_spu.ReadRegister(SPU_REG_STATUS) & SPU_STATUS_DMA_WRITE_REQUEST))
+  {
+    CPU::AddPendingTicks((*TimingEvents::GetHeadEventPtr())->GetDowncount());
+    TimingEvents::RunEvents();
+  }
+}
+
+bool RunSPUReverb(u32 seconds, std::unique_ptr<AudioStream>& host_audio_stream, ReportWriter& writer)
+{
+  if (seconds == 0)
+    seconds = SPU_DEFAULT_SECONDS;
+
+  std::unique_ptr<ChecksumAudioStream> stream = std::make_unique<ChecksumAudioStream>();
+  if (!stream->Reconfigure(SPU_SAMPLE_RATE, 2, SPU_BUFFER_SIZE))
+    return false;
+
+  ChecksumAudioStream* const checksum_stream = stream.get();
+  std::unique_ptr<AudioStream> saved_audio_stream = std::move(host_audio_stream);
+  host_audio_stream = std::move(stream);
+
+  TimingEvents::Initialize();
+  g_spu.Initialize();
+
+  const std::vector<u32> sample = GenerateSPUSample();
+  g_spu.WriteRegister(SPU_REG_CONTROL, SPU_CONTROL_DMA_WRITE);
+  g_spu.WriteRegister(SPU_REG_TRANSFER_ADDRESS, SPU_SAMPLE_ADDRESS / 8);
+  for (size_t i = 0; i < sample.size(); i += SPU_DMA_BLOCK_SIZE)
+  {
+    g_spu.DMAWrite(&sample[i], static_cast<u32>(std::min<size_t>(sample.size() - i, SPU_DMA_BLOCK_SIZE)));
+    RunUntilSPUIdle();
+  }
+
+  for (u32 i = 0; i < static_cast<u32>(s_spu_hall_reverb_config.size()); i++)
+    g_spu.WriteRegister(SPU_REG_REVERB_CONFIG + i * 2, s_spu_hall_reverb_config[i]);
+  g_spu.WriteRegister(SPU_REG_REVERB_BASE_ADDRESS, s_spu_hall_reverb_base);
+  g_spu.WriteRegister(SPU_REG_REVERB_VOLUME_LEFT, 0x3000);
+  g_spu.WriteRegister(SPU_REG_REVERB_VOLUME_RIGHT, 0x3000);
+  g_spu.WriteRegister(SPU_REG_MAIN_VOLUME_LEFT, 0x3FFF);
+  g_spu.WriteRegister(SPU_REG_MAIN_VOLUME_RIGHT, 0x3FFF);
+
+  // Spread the voices across pitches and pans, with an instant attack and a held sustain.
+  for (u32 voice = 0; voice < SPU_NUM_VOICES; voice++)
+  {
+    const u32 base = voice * SPU_REG_VOICE_STRIDE;
+    g_spu.WriteRegister(base + SPU_REG_VOICE_VOLUME_LEFT, static_cast<u16>(0x0200 + voice * 0x40));
+    g_spu.WriteRegister(base + SPU_REG_VOICE_VOLUME_RIGHT, static_cast<u16>(0x0800 - voice * 0x40));
+    g_spu.WriteRegister(base + SPU_REG_VOICE_SAMPLE_RATE, static_cast<u16>(0x0400 + voice * 0x0100));
+    g_spu.WriteRegister(base + SPU_REG_VOICE_START_ADDRESS, SPU_SAMPLE_ADDRESS / 8);
+    g_spu.WriteRegister(base + SPU_REG_VOICE_ADSR_LOW, 0x000F);
+    g_spu.WriteRegister(base + SPU_REG_VOICE_ADSR_HIGH, 0x0000);
+  }
+
+  g_spu.WriteRegister(SPU_REG_CONTROL, SPU_CONTROL_ENABLE | SPU_CONTROL_UNMUTE | SPU_CONTROL_REVERB_MASTER_ENABLE);
+  g_spu.WriteRegister(SPU_REG_REVERB_ON_LOW, 0xFFFF);
+  g_spu.WriteRegister(SPU_REG_REVERB_ON_HIGH, 0x00FF);
+  g_spu.WriteRegister(SPU_REG_KEY_ON_LOW, 0xFFFF);
+  g_spu.WriteRegister(SPU_REG_KEY_ON_HIGH, 0x00FF);
+
+  g_spu.GeneratePendingSamples();
+  const u64 start_frame_count = checksum_stream->GetFrameCount();
+
+  // Nothing else is scheduled, so this runs from one batch of SPU samples to the next.
+  const u64 total_ticks = static_cast<u64>(seconds) * TICKS_PER_SECOND;
+  u64 elapsed_ticks = 0;
+  Common::Timer timer;
+  while (elapsed_ticks < total_ticks)
+  {
+    const TickCount slice =
+      std::max<TickCount>((*TimingEvents::GetHeadEventPtr())->m_downcount - CPU::GetPendingTicks(), 1);
+    CPU::AddPendingTicks(slice);
+    elapsed_ticks += static_cast<u64>(slice);
+    TimingEvents::RunEvents();
+  }
+
+  const double elapsed_seconds = timer.GetTimeSeconds();
+  const u64 frames = checksum_stream->GetFrameCount() - start_frame_count;
+  const u32 output_crc = checksum_stream->GetCRC();
+
+  g_spu.Shutdown();
+  TimingEvents::Shutdown();
+  host_audio_stream = std::move(saved_audio_stream);
+
+  writer.Key("benchmark");
+  writer.String("spu-reverb");
+  writer.Key("emulated_seconds");
+  writer.Uint(seconds);
+  writer.Key("frames");
+  writer.Uint64(frames);
+  writer.Key("elapsed_seconds");
+  writer.Double(elapsed_seconds);
+  writer.Key("ns_per_frame");
+  writer.Double((frames > 0) ? (elapsed_seconds * 1000000000.0 / static_cast<double>(frames)) : 0.0);
+  writer.Key("output_crc32");
+  writer.String(StringUtil::StdStringFromFormat("%08" PRIX32, output_crc).c_str());
+  return true;
+}
+
+} // namespace HeadlessBenchmarks
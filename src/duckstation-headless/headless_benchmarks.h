@@ -0,0 +1,26 @@
+#pragma once
+#include "core/types.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include <memory>
+
+class AudioStream;
+
+// Micro-benchmarks which drive a single subsystem, without booting the system.
+namespace HeadlessBenchmarks {
+
+using ReportWriter = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+/// Replays an MDEC input stream through the decoder, and reports macroblocks/s. The stream is what was written to the
+/// MDEC command/data port, as captured with -mdeccapture. Without one, a synthetic 24-bit movie is generated.
+bool RunMDEC(const char* stream_filename, u32 iterations, ReportWriter& writer);
+
+/// Measures RunEvents() and UpdateCPUDowncount() per emulated second, with IO writes rescheduling events part way
+/// through each slice. Without a count, the 14 events a game usually has active are used.
+bool RunTimingEvents(u32 num_events, u32 seconds, ReportWriter& writer);
+
+/// Plays all 24 voices through a hall reverb, and reports the time taken to mix each output frame. The SPU writes to
+/// the host's audio stream, so it's swapped for one which checksums the output for the duration.
+bool RunSPUReverb(u32 seconds, std::unique_ptr<AudioStream>& host_audio_stream, ReportWriter& writer);
+
+} // namespace HeadlessBenchmarks
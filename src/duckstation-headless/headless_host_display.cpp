@@ -0,0 +1,146 @@
+#include "headless_host_display.h"
+#include "common/align.h"
+#include "common/log.h"
+Log_SetChannel(HeadlessHostDisplay);
+
+HeadlessHostDisplay::HeadlessHostDisplay() = default;
+
+HeadlessHostDisplay::~HeadlessHostDisplay() = default;
+
+HostDisplay::RenderAPI HeadlessHostDisplay::GetRenderAPI() const
+{
+  return RenderAPI::None;
+}
+
+void* HeadlessHostDisplay::GetRenderDevice() const
+{
+  return nullptr;
+}
+
+void* HeadlessHostDisplay::GetRenderContext() const
+{
+  return nullptr;
+}
+
+bool HeadlessHostDisplay::HasRenderDevice() const
+{
+  return true;
+}
+
+bool HeadlessHostDisplay::HasRenderSurface() const
+{
+  return true;
+}
+
+bool HeadlessHostDisplay::CreateRenderDevice(const WindowInfo& wi, std::string_view adapter_name, bool debug_device)
+{
+  m_window_info = wi;
+  return true;
+}
+
+bool HeadlessHostDisplay::InitializeRenderDevice(std::string_view shader_cache_directory, bool debug_device)
+{
+  return true;
+}
+
+bool HeadlessHostDisplay::MakeRenderContextCurrent()
+{
+  return true;
+}
+
+bool HeadlessHostDisplay::DoneRenderContextCurrent()
+{
+  return true;
+}
+
+void HeadlessHostDisplay::DestroyRenderDevice() {}
+
+void HeadlessHostDisplay::DestroyRenderSurface() {}
+
+bool HeadlessHostDisplay::CreateResources()
+{
+  return true;
+}
+
+void HeadlessHostDisplay::DestroyResources() {}
+
+bool HeadlessHostDisplay::ChangeRenderWindow(const WindowInfo& wi)
+{
+  m_window_info = wi;
+  return true;
+}
+
+void HeadlessHostDisplay::ResizeRenderWindow(s32 new_window_width, s32 new_window_height)
+{
+  m_window_info.surface_width = new_window_width;
+  m_window_info.surface_height = new_window_height;
+}
+
+bool HeadlessHostDisplay::SupportsFullscreen() const
+{
+  return false;
+}
+
+bool HeadlessHostDisplay::IsFullscreen()
+{
+  return false;
+}
+
+bool HeadlessHostDisplay::SetFullscreen(bool fullscreen, u32 width, u32 height, float refresh_rate)
+{
+  return false;
+}
+
+bool HeadlessHostDisplay::SetPostProcessingChain(const std::string_view& config)
+{
+  return false;
+}
+
+std::unique_ptr<HostDisplayTexture> HeadlessHostDisplay::CreateTexture(u32 width, u32 height, const void* data,
+                                                                       u32 data_stride, bool dynamic)
+{
+  return nullptr;
+}
+
+void HeadlessHostDisplay::UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height,
+                                        const void* data, u32 data_stride)
+{
+}
+
+bool HeadlessHostDisplay::DownloadTexture(const void* texture_handle, HostDisplayPixelFormat texture_format, u32 x,
+                                          u32 y, u32 width, u32 height, void* out_data, u32 out_data_stride)
+{
+  return false;
+}
+
+bool HeadlessHostDisplay::SupportsDisplayPixelFormat(HostDisplayPixelFormat format) const
+{
+  return true;
+}
+
+bool HeadlessHostDisplay::BeginSetDisplayPixels(HostDisplayPixelFormat format, u32 width, u32 height,
+                                                void** out_buffer, u32* out_pitch)
+{
+  // Still hand out a real buffer, so the cost of the display conversion is included in the frame time.
+  const u32 pitch = Common::AlignUpPow2(width * GetDisplayPixelFormatSize(format), 4);
+  const u32 required_size = height * pitch;
+  if (m_frame_buffer.size() < (required_size / 4))
+    m_frame_buffer.resize(required_size / 4);
+
+  SetDisplayTexture(m_frame_buffer.data(), format, width, height, 0, 0, width, height);
+  *out_buffer = m_frame_buffer.data();
+  *out_pitch = pitch;
+  return true;
+}
+
+void HeadlessHostDisplay::EndSetDisplayPixels() {}
+
+void HeadlessHostDisplay::SetVSync(bool enabled)
+{
+  Log_DevPrintf("Ignoring SetVSync(%u)", BoolToUInt32(enabled));
+}
+
+bool HeadlessHostDisplay::Render()
+{
+  return true;
+}
@@ -0,0 +1,542 @@
+#include "headless_host_interface.h"
+#include "common/audio_stream.h"
+#include "common/byte_stream.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/string_util.h"
+#include "common/timer.h"
+#include "core/bus.h"
+#include "core/gpu.h"
+#include "core/mdec.h"
+#include "core/system.h"
+#include "headless_benchmarks.h"
+#include "headless_host_display.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include "scmversion/scmversion.h"
+#include "zlib.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+Log_SetChannel(HeadlessHostInterface);
+
+HeadlessHostInterface::HeadlessHostInterface()
+{
+  // Runs should only depend on the command line, not the user's configuration or memory cards.
+  SetUserDirectoryToProgramDirectory();
+  SetDefaultSettings(m_settings_interface);
+  m_settings_interface.SetStringValue("MemoryCards", "Card1Type", Settings::GetMemoryCardTypeName(MemoryCardType::None));
+  m_settings_interface.SetStringValue("MemoryCards", "Card2Type", Settings::GetMemoryCardTypeName(MemoryCardType::None));
+  m_settings_interface.SetBoolValue("Main", "ApplyGameSettings", false);
+
+  // The report goes to stdout by default, so all log output goes to stderr instead of the usual console output.
+  // Registered here so command line errors show up too.
+  m_settings_interface.SetStringValue("Logging", "LogLevel", Settings::GetLogLevelName(LOGLEVEL_WARNING));
+  m_settings_interface.SetBoolValue("Logging", "LogToConsole", true);
+  Log::SetFilterLevel(LOGLEVEL_WARNING);
+  Log::RegisterCallback(StderrLogCallback, this);
+}
+
+HeadlessHostInterface::~HeadlessHostInterface()
+{
+  Log::UnregisterCallback(StderrLogCallback, this);
+}
+
+void HeadlessHostInterface::StderrLogCallback(void* pUserParam, const char* channelName, const char* functionName,
+                                              LOGLEVEL level, const char* message)
+{
+  const HeadlessHostInterface* hi = static_cast<const HeadlessHostInterface*>(pUserParam);
+  if (!hi->m_log_to_stderr || (!hi->m_log_filter.empty() && hi->m_log_filter.find(channelName) != std::string::npos))
+    return;
+
+  static constexpr std::array<char, LOGLEVEL_COUNT> level_characters = {
+    {'X', 'E', 'W', 'P', 'I', 'V', 'D', 'R', 'B', 'T'}};
+  if (level <= LOGLEVEL_PERF)
+    std::fprintf(stderr, "%c(%s): %s\n", level_characters[level], functionName, message);
+  else
+    std::fprintf(stderr, "%c/%s: %s\n", level_characters[level], channelName, message);
+}
+
+static void PrintCommandLineHelp(const char* progname)
+{
+  std::fprintf(stderr, "DuckStation Headless Runner Version %s (%s)\n", g_scm_tag_str, g_scm_branch_str);
+  std::fprintf(stderr, "Usage: %s [parameters] [--] [boot filename]\n", progname);
+  std::fprintf(stderr, "\n");
+  std::fprintf(stderr, "  -help: Displays this information and exits.\n");
+  std::fprintf(stderr, "  -frames <count>: Number of frames to run (default %u).\n",
+               static_cast<u32>(HeadlessHostInterface::DEFAULT_FRAME_COUNT));
+  std::fprintf(stderr, "  -statefile <filename>: Loads state from the specified filename.\n"
+                       "    No boot filename is required with this option.\n");
+  std::fprintf(stderr, "  -bios <directory>: Searches the specified directory for BIOS images.\n");
+  std::fprintf(stderr, "  -fastboot: Force fast boot for provided filename.\n");
+  std::fprintf(stderr, "  -slowboot: Force slow boot for provided filename.\n");
+  std::fprintf(stderr, "  -setting <section>/<key>=<value>: Overrides a setting, e.g. CPU/ExecutionMode=Interpreter.\n"
+                       "    The software renderer and null audio backend are always used.\n");
+  std::fprintf(stderr, "  -report <filename>: Writes the JSON report to the specified file instead of stdout.\n");
+  std::fprintf(stderr, "  -timings: Adds per-subsystem frame times to the report.\n");
+  std::fprintf(stderr, "  -turbo: Runs frames in batches, presenting only the last of each. Frame times are then\n"
+                       "    averaged over the batch. Same as -setting Main/UnthrottledTurbo=true.\n");
+  std::fprintf(stderr, "  -timingcsv <filename>: Writes per-subsystem times for every frame to a CSV file.\n"
+                       "    Implies -timings.\n");
+  std::fprintf(stderr, "  -mdeccapture <filename>: Writes everything sent to the MDEC to a file.\n"
+                       "    Replay it with -benchmark mdec -benchmarkinput <filename>.\n");
+  std::fprintf(stderr, "  -benchmark <name>: Runs a micro-benchmark instead of the system. No boot filename is\n"
+                       "    required. Available benchmarks: mdec, timing-events, spu-reverb.\n");
+  std::fprintf(stderr, "  -benchmarkinput <filename>: Input for the micro-benchmark, e.g. an MDEC capture.\n");
+  std::fprintf(stderr, "  -iterations <count>: Number of times the micro-benchmark repeats its input. For\n"
+                       "    timing-events and spu-reverb, the number of emulated seconds.\n");
+  std::fprintf(stderr, "  -benchmarkevents <count>: Number of active events for the timing-events benchmark.\n");
+  std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
+                       "    parameters make up the filename. Use when the filename contains\n"
+                       "    spaces or starts with a dash.\n");
+  std::fprintf(stderr, "\n");
+}
+
+bool HeadlessHostInterface::ParseCommandLineParameters(int argc, char* argv[],
+                                                       std::unique_ptr<SystemBootParameters>* out_boot_params)
+{
+  std::optional<bool> force_fast_boot;
+  std::string state_filename;
+  std::string boot_filename;
+  bool no_more_args = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!no_more_args)
+    {
+#define CHECK_ARG(str) !std::strcmp(argv[i], str)
+#define CHECK_ARG_PARAM(str) (!std::strcmp(argv[i], str) && ((i + 1) < argc))
+
+      if (CHECK_ARG("-help"))
+      {
+        PrintCommandLineHelp(argv[0]);
+        return false;
+      }
+      else if (CHECK_ARG_PARAM("-frames"))
+      {
+        std::optional<u32> frame_count = StringUtil::FromChars<u32>(argv[++i]);
+        if (!frame_count.has_value() || frame_count.value() == 0)
+        {
+          Log_ErrorPrintf("Invalid frame count: '%s'", argv[i]);
+          return false;
+        }
+
+        m_frame_count = frame_count.value();
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-statefile"))
+      {
+        state_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-bios"))
+      {
+        m_settings_interface.SetStringValue("BIOS", "SearchDirectory", argv[++i]);
+        continue;
+      }
+      else if (CHECK_ARG("-fastboot"))
+      {
+        force_fast_boot = true;
+        continue;
+      }
+      else if (CHECK_ARG("-slowboot"))
+      {
+        force_fast_boot = false;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-setting"))
+      {
+        const std::string_view setting(argv[++i]);
+        const std::string_view::size_type key_pos = setting.find('/');
+        const std::string_view::size_type value_pos = setting.find('=');
+        if (key_pos == std::string_view::npos || value_pos == std::string_view::npos || value_pos < key_pos)
+        {
+          Log_ErrorPrintf("Invalid setting: '%s', expected <section>/<key>=<value>", argv[i]);
+          return false;
+        }
+
+        const std::string section(setting.substr(0, key_pos));
+        const std::string key(setting.substr(key_pos + 1, value_pos - key_pos - 1));
+        const std::string value(setting.substr(value_pos + 1));
+        m_settings_interface.SetStringValue(section.c_str(), key.c_str(), value.c_str());
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-report"))
+      {
+        m_report_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG("-turbo"))
+      {
+        m_settings_interface.SetBoolValue("Main", "UnthrottledTurbo", true);
+        continue;
+      }
+      else if (CHECK_ARG("-timings"))
+      {
+        m_subsystem_timings = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-timingcsv"))
+      {
+        m_timing_csv_filename = argv[++i];
+        m_subsystem_timings = true;
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-mdeccapture"))
+      {
+        m_mdec_capture_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        m_benchmark_name = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmarkinput"))
+      {
+        m_benchmark_input_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-iterations"))
+      {
+        std::optional<u32> iterations = StringUtil::FromChars<u32>(argv[++i]);
+        if (!iterations.has_value() || iterations.value() == 0)
+        {
+          Log_ErrorPrintf("Invalid iteration count: '%s'", argv[i]);
+          return false;
+        }
+
+        m_benchmark_iterations = iterations.value();
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmarkevents"))
+      {
+        std::optional<u32> events = StringUtil::FromChars<u32>(argv[++i]);
+        if (!events.has_value() || events.value() == 0)
+        {
+          Log_ErrorPrintf("Invalid event count: '%s'", argv[i]);
+          return false;
+        }
+
+        m_benchmark_events = events.value();
+        continue;
+      }
+      else if (CHECK_ARG("--"))
+      {
+        no_more_args = true;
+        continue;
+      }
+      else if (argv[i][0] == '-')
+      {
+        Log_ErrorPrintf("Unknown parameter: '%s'", argv[i]);
+        return false;
+      }
+
+#undef CHECK_ARG
+#undef CHECK_ARG_PARAM
+    }
+
+    if (!boot_filename.empty())
+      boot_filename += ' ';
+    boot_filename += argv[i];
+  }
+
+  std::unique_ptr<SystemBootParameters> boot_params = std::make_unique<SystemBootParameters>();
+  boot_params->filename = std::move(boot_filename);
+  boot_params->override_fast_boot = std::move(force_fast_boot);
+
+  if (!state_filename.empty())
+  {
+    std::unique_ptr<ByteStream> state_stream =
+      FileSystem::OpenFile(state_filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+    if (!state_stream)
+    {
+      Log_ErrorPrintf("Failed to open save state file '%s'", state_filename.c_str());
+      return false;
+    }
+
+    boot_params->state_stream = std::move(state_stream);
+  }
+
+  *out_boot_params = std::move(boot_params);
+  return true;
+}
+
+bool HeadlessHostInterface::Initialize()
+{
+  if (!HostInterface::Initialize())
+    return false;
+
+  LoadSettings();
+  FixIncompatibleSettings(false);
+
+  Log::SetFilterLevel(g_settings.log_level);
+  m_log_filter = g_settings.log_filter;
+  m_log_to_stderr = g_settings.log_to_console;
+  return true;
+}
+
+void HeadlessHostInterface::Shutdown()
+{
+  DestroySystem();
+  HostInterface::Shutdown();
+}
+
+void HeadlessHostInterface::GetGameInfo(const char* path, CDImage* image, std::string* code, std::string* title)
+{
+  // There's no game list, so just use the filename.
+  *title = System::GetTitleForPath(path);
+  if (image)
+    *code = System::GetGameCodeForImage(image);
+}
+
+std::string HeadlessHostInterface::GetStringSettingValue(const char* section, const char* key,
+                                                         const char* default_value /*= ""*/)
+{
+  return m_settings_interface.GetStringValue(section, key, default_value);
+}
+
+std::unique_ptr<ByteStream> HeadlessHostInterface::OpenPackageFile(const char* path, u32 flags)
+{
+  const u32 allowed_flags = (BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_SEEKABLE | BYTESTREAM_OPEN_STREAMED);
+  const std::string full_path(
+    StringUtil::StdStringFromFormat("%s" FS_OSPATH_SEPARATOR_STR "%s", m_program_directory.c_str(), path));
+  const u32 real_flags = (flags & allowed_flags) | BYTESTREAM_OPEN_READ;
+  Log_DevPrintf("Requesting package file '%s'", path);
+  return FileSystem::OpenFile(full_path.c_str(), real_flags);
+}
+
+bool HeadlessHostInterface::AcquireHostDisplay()
+{
+  m_display = std::make_unique<HeadlessHostDisplay>();
+  return true;
+}
+
+void HeadlessHostInterface::ReleaseHostDisplay()
+{
+  m_display.reset();
+}
+
+std::unique_ptr<AudioStream> HeadlessHostInterface::CreateAudioStream(AudioBackend backend)
+{
+  return AudioStream::CreateNullAudioStream();
+}
+
+void HeadlessHostInterface::LoadSettings()
+{
+  HostInterface::LoadSettings(m_settings_interface);
+
+  // Nothing else can run without a display, and nobody is listening to the audio.
+  g_settings.gpu_renderer = GPURenderer::Software;
+  g_settings.audio_backend = AudioBackend::Null;
+}
+
+bool HeadlessHostInterface::Run()
+{
+  std::vector<float> frame_times;
+  frame_times.reserve(m_frame_count);
+
+  SubsystemTimes subsystem_times = {};
+  if (m_subsystem_timings)
+  {
+    if (!PerfTimers::IsAvailable())
+      Log_WarningPrintf("Subsystem timings were not compiled into this build");
+    else if (!m_timing_csv_filename.empty() && !PerfTimers::StartCSVDump(m_timing_csv_filename.c_str()))
+      return false;
+
+    PerfTimers::SetEnabled(true);
+  }
+
+  std::unique_ptr<ByteStream> mdec_capture_stream;
+  if (!m_mdec_capture_filename.empty())
+  {
+    mdec_capture_stream =
+      FileSystem::OpenFile(m_mdec_capture_filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE |
+                                                               BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_STREAMED);
+    if (!mdec_capture_stream)
+    {
+      Log_ErrorPrintf("Failed to open MDEC capture file '%s'", m_mdec_capture_filename.c_str());
+      return false;
+    }
+
+    g_mdec.SetInputCaptureStream(mdec_capture_stream.get());
+  }
+
+  Common::Timer run_timer;
+  Common::Timer frame_timer;
+  while (frame_times.size() < m_frame_count && System::IsRunning())
+  {
+    frame_timer.Reset();
+
+    u32 frames_run = 1;
+    if (g_settings.unthrottled_turbo)
+      frames_run = System::RunTurboFrames(m_frame_count - static_cast<u32>(frame_times.size()), TURBO_BATCH_SECONDS);
+    else
+      System::RunFrame();
+
+    m_display->Render();
+    frame_times.insert(frame_times.end(), frames_run,
+                       static_cast<float>(frame_timer.GetTimeMilliseconds() / static_cast<double>(frames_run)));
+
+    if (PerfTimers::IsEnabled())
+    {
+      const PerfTimers::FrameTimes& times = PerfTimers::GetLastFrameTimes();
+      for (u32 i = 0; i < PerfTimers::NUM_CATEGORIES; i++)
+        subsystem_times[i] += times.ms[i];
+    }
+
+    System::UpdatePerformanceCounters();
+  }
+
+  const double elapsed_seconds = run_timer.GetTimeSeconds();
+  PerfTimers::StopCSVDump();
+  PerfTimers::SetEnabled(false);
+
+  if (mdec_capture_stream)
+  {
+    g_mdec.SetInputCaptureStream(nullptr);
+    if (!mdec_capture_stream->Commit())
+      Log_ErrorPrintf("Failed to write MDEC capture file '%s'", m_mdec_capture_filename.c_str());
+  }
+
+  if (frame_times.size() < m_frame_count)
+  {
+    Log_ErrorPrintf("System stopped after %u of %u frames", static_cast<u32>(frame_times.size()), m_frame_count);
+    if (System::IsShutdown())
+      return false;
+  }
+
+  return WriteReport(frame_times, subsystem_times, elapsed_seconds) && frame_times.size() == m_frame_count;
+}
+
+bool HeadlessHostInterface::WriteReport(const std::vector<float>& frame_times, const SubsystemTimes& subsystem_times,
+                                        double elapsed_seconds)
+{
+  std::vector<float> sorted_frame_times(frame_times);
+  std::sort(sorted_frame_times.begin(), sorted_frame_times.end());
+
+  const u32 num_frames = static_cast<u32>(sorted_frame_times.size());
+  const double fps = (elapsed_seconds > 0.0) ? (static_cast<double>(num_frames) / elapsed_seconds) : 0.0;
+  double total_frame_time = 0.0;
+  for (const float time : sorted_frame_times)
+    total_frame_time += time;
+
+  const u32 p99_index = static_cast<u32>(std::ceil(static_cast<double>(num_frames) * 0.99)) - 1;
+
+  // Hash the final memory contents, so runs can be checked for determinism.
+  const u16* vram = g_gpu->ReadbackVRAM();
+  const uLong vram_crc =
+    crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(vram), VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
+  const uLong ram_crc = crc32(crc32(0L, Z_NULL, 0), Bus::g_ram, Bus::RAM_SIZE);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("version");
+  writer.String(g_scm_tag_str);
+  writer.Key("path");
+  writer.String(System::GetRunningPath().c_str());
+  writer.Key("code");
+  writer.String(System::GetRunningCode().c_str());
+  writer.Key("title");
+  writer.String(System::GetRunningTitle().c_str());
+  writer.Key("cpu_execution_mode");
+  writer.String(Settings::GetCPUExecutionModeName(g_settings.cpu_execution_mode));
+  writer.Key("gpu_thread");
+  writer.Bool(g_settings.gpu_use_thread);
+  writer.Key("turbo");
+  writer.Bool(g_settings.unthrottled_turbo);
+  writer.Key("frames");
+  writer.Uint(num_frames);
+  writer.Key("elapsed_seconds");
+  writer.Double(elapsed_seconds);
+  writer.Key("fps");
+  writer.Double(fps);
+  writer.Key("speed");
+  writer.Double(fps / System::GetThrottleFrequency() * 100.0);
+
+  writer.Key("frame_time_ms");
+  writer.StartObject();
+  writer.Key("min");
+  writer.Double((num_frames > 0) ? sorted_frame_times.front() : 0.0);
+  writer.Key("avg");
+  writer.Double((num_frames > 0) ? (total_frame_time / num_frames) : 0.0);
+  writer.Key("p99");
+  writer.Double((num_frames > 0) ? sorted_frame_times[p99_index] : 0.0);
+  writer.Key("max");
+  writer.Double((num_frames > 0) ? sorted_frame_times.back() : 0.0);
+  writer.EndObject();
+
+  if (m_subsystem_timings && PerfTimers::IsAvailable())
+  {
+    // Average time per frame. GPUBackend overlaps the rest when the GPU thread is enabled.
+    writer.Key("subsystem_time_ms");
+    writer.StartObject();
+    for (u32 i = 0; i < PerfTimers::NUM_CATEGORIES; i++)
+    {
+      writer.Key(PerfTimers::GetCategoryName(static_cast<PerfTimers::Category>(i)));
+      writer.Double((num_frames > 0) ? (subsystem_times[i] / num_frames) : 0.0);
+    }
+    writer.EndObject();
+  }
+
+  writer.Key("vram_crc32");
+  writer.String(StringUtil::StdStringFromFormat("%08" PRIX32, static_cast<u32>(vram_crc)).c_str());
+  writer.Key("ram_crc32");
+  writer.String(StringUtil::StdStringFromFormat("%08" PRIX32, static_cast<u32>(ram_crc)).c_str());
+  writer.EndObject();
+
+  return WriteReportBuffer(buffer);
+}
+
+bool HeadlessHostInterface::RunMicroBenchmark()
+{
+  rapidjson::StringBuffer buffer;
+  HeadlessBenchmarks::ReportWriter writer(buffer);
+  writer.StartObject();
+  writer.Key("version");
+  writer.String(g_scm_tag_str);
+
+  bool result;
+  if (m_benchmark_name == "mdec")
+  {
+    result = HeadlessBenchmarks::RunMDEC(m_benchmark_input_filename.c_str(), m_benchmark_iterations, writer);
+  }
+  else if (m_benchmark_name == "timing-events")
+  {
+    result = HeadlessBenchmarks::RunTimingEvents(m_benchmark_events, m_benchmark_iterations, writer);
+  }
+  else if (m_benchmark_name == "spu-reverb")
+  {
+    result = HeadlessBenchmarks::RunSPUReverb(m_benchmark_iterations, m_audio_stream, writer);
+  }
+  else
+  {
+    Log_ErrorPrintf("Unknown benchmark: '%s'", m_benchmark_name.c_str());
+    return false;
+  }
+
+  writer.EndObject();
+  return result && WriteReportBuffer(buffer);
+}
+
+bool HeadlessHostInterface::WriteReportBuffer(const rapidjson::StringBuffer& buffer)
+{
+  if (m_report_filename.empty())
+  {
+    std::fprintf(stdout, "%s\n", buffer.GetString());
+    std::fflush(stdout);
+    return true;
+  }
+
+  auto fp = FileSystem::OpenManagedCFile(m_report_filename.c_str(), "wb");
+  if (!fp || std::fwrite(buffer.GetString(), buffer.GetSize(), 1, fp.get()) != 1)
+  {
+    Log_ErrorPrintf("Failed to write report to '%s'", m_report_filename.c_str());
+    return false;
+  }
+
+  return true;
+}
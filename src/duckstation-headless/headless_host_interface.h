@@ -0,0 +1,71 @@
+#pragma once
+#include "core/host_interface.h"
+#include "core/perf_timers.h"
+#include "headless_settings_interface.h"
+#include "rapidjson/stringbuffer.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+class HeadlessHostInterface final : public HostInterface
+{
+public:
+  enum : u32
+  {
+    DEFAULT_FRAME_COUNT = 3600
+  };
+
+  /// Length of each batch in turbo mode, as if presenting to a 60hz display.
+  static constexpr float TURBO_BATCH_SECONDS = 1.0f / 60.0f;
+
+  HeadlessHostInterface();
+  ~HeadlessHostInterface() override;
+
+  bool ParseCommandLineParameters(int argc, char* argv[], std::unique_ptr<SystemBootParameters>* out_boot_params);
+
+  bool Initialize() override;
+  void Shutdown() override;
+
+  void GetGameInfo(const char* path, CDImage* image, std::string* code, std::string* title) override;
+  std::string GetStringSettingValue(const char* section, const char* key, const char* default_value = "") override;
+  std::unique_ptr<ByteStream> OpenPackageFile(const char* path, u32 flags) override;
+
+  /// Runs the requested number of frames unthrottled, then writes the report. Returns false if the system stopped
+  /// early or the report couldn't be written.
+  bool Run();
+
+  /// Micro-benchmarks replace the run, and don't need a boot filename.
+  bool IsRunningMicroBenchmark() const { return !m_benchmark_name.empty(); }
+  bool RunMicroBenchmark();
+
+protected:
+  bool AcquireHostDisplay() override;
+  void ReleaseHostDisplay() override;
+  std::unique_ptr<AudioStream> CreateAudioStream(AudioBackend backend) override;
+
+  void LoadSettings() override;
+
+private:
+  using SubsystemTimes = std::array<double, PerfTimers::NUM_CATEGORIES>;
+
+  bool WriteReport(const std::vector<float>& frame_times, const SubsystemTimes& subsystem_times,
+                   double elapsed_seconds);
+  bool WriteReportBuffer(const rapidjson::StringBuffer& buffer);
+
+  static void StderrLogCallback(void* pUserParam, const char* channelName, const char* functionName, LOGLEVEL level,
+                                const char* message);
+
+  HeadlessSettingsInterface m_settings_interface;
+  std::string m_report_filename;
+  std::string m_timing_csv_filename;
+  std::string m_benchmark_name;
+  std::string m_benchmark_input_filename;
+  std::string m_mdec_capture_filename;
+  std::string m_log_filter;
+  u32 m_benchmark_iterations = 0;
+  u32 m_benchmark_events = 0;
+  u32 m_frame_count = DEFAULT_FRAME_COUNT;
+  bool m_subsystem_timings = false;
+  bool m_log_to_stderr = true;
+};
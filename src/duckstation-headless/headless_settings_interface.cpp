@@ -0,0 +1,117 @@
+#include "headless_settings_interface.h"
+#include "common/string_util.h"
+#include <algorithm>
+
+HeadlessSettingsInterface::HeadlessSettingsInterface() = default;
+
+HeadlessSettingsInterface::~HeadlessSettingsInterface() = default;
+
+void HeadlessSettingsInterface::Clear()
+{
+  m_values.clear();
+  m_lists.clear();
+}
+
+int HeadlessSettingsInterface::GetIntValue(const char* section, const char* key, int default_value /*= 0*/)
+{
+  auto it = m_values.find(KeyType(section, key));
+  if (it == m_values.end())
+    return default_value;
+
+  return StringUtil::FromChars<int>(it->second).value_or(default_value);
+}
+
+float HeadlessSettingsInterface::GetFloatValue(const char* section, const char* key, float default_value /*= 0.0f*/)
+{
+  auto it = m_values.find(KeyType(section, key));
+  if (it == m_values.end())
+    return default_value;
+
+  return StringUtil::FromChars<float>(it->second).value_or(default_value);
+}
+
+bool HeadlessSettingsInterface::GetBoolValue(const char* section, const char* key, bool default_value /*= false*/)
+{
+  auto it = m_values.find(KeyType(section, key));
+  if (it == m_values.end())
+    return default_value;
+
+  return StringUtil::FromChars<bool>(it->second).value_or(default_value);
+}
+
+std::string HeadlessSettingsInterface::GetStringValue(const char* section, const char* key,
+                                                      const char* default_value /*= ""*/)
+{
+  auto it = m_values.find(KeyType(section, key));
+  return (it != m_values.end()) ? it->second : std::string(default_value);
+}
+
+void HeadlessSettingsInterface::SetIntValue(const char* section, const char* key, int value)
+{
+  m_values[KeyType(section, key)] = StringUtil::StdStringFromFormat("%d", value);
+}
+
+void HeadlessSettingsInterface::SetFloatValue(const char* section, const char* key, float value)
+{
+  m_values[KeyType(section, key)] = StringUtil::StdStringFromFormat("%f", value);
+}
+
+void HeadlessSettingsInterface::SetBoolValue(const char* section, const char* key, bool value)
+{
+  m_values[KeyType(section, key)] = value ? "true" : "false";
+}
+
+void HeadlessSettingsInterface::SetStringValue(const char* section, const char* key, const char* value)
+{
+  m_values[KeyType(section, key)] = value;
+}
+
+std::vector<std::string> HeadlessSettingsInterface::GetStringList(const char* section, const char* key)
+{
+  auto it = m_lists.find(KeyType(section, key));
+  return (it != m_lists.end()) ? it->second : std::vector<std::string>();
+}
+
+void HeadlessSettingsInterface::SetStringList(const char* section, const char* key,
+                                              const std::vector<std::string>& items)
+{
+  m_lists[KeyType(section, key)] = items;
+}
+
+bool HeadlessSettingsInterface::RemoveFromStringList(const char* section, const char* key, const char* item)
+{
+  auto it = m_lists.find(KeyType(section, key));
+  if (it == m_lists.end())
+    return false;
+
+  auto item_it = std::find(it->second.begin(), it->second.end(), item);
+  if (item_it == it->second.end())
+    return false;
+
+  it->second.erase(item_it);
+  return true;
+}
+
+bool HeadlessSettingsInterface::AddToStringList(const char* section, const char* key, const char* item)
+{
+  std::vector<std::string>& items = m_lists[KeyType(section, key)];
+  if (std::find(items.begin(), items.end(), item) != items.end())
+    return false;
+
+  items.emplace_back(item);
+  return true;
+}
+
+void HeadlessSettingsInterface::DeleteValue(const char* section, const char* key)
+{
+  m_values.erase(KeyType(section, key));
+  m_lists.erase(KeyType(section, key));
+}
+
+void HeadlessSettingsInterface::ClearSection(const char* section)
+{
+  for (auto it = m_values.begin(); it != m_values.end();)
+    it = (it->first.first == section) ? m_values.erase(it) : std::next(it);
+  for (auto it = m_lists.begin(); it != m_lists.end();)
+    it = (it->first.first == section) ? m_lists.erase(it) : std::next(it);
+}
@@ -0,0 +1,38 @@
+#include "core/system.h"
+#include "headless_host_interface.h"
+#include <cstdlib>
+
+int main(int argc, char* argv[])
+{
+  std::unique_ptr<HeadlessHostInterface> host_interface = std::make_unique<HeadlessHostInterface>();
+  std::unique_ptr<SystemBootParameters> boot_params;
+  if (!host_interface->ParseCommandLineParameters(argc, argv, &boot_params))
+    return EXIT_FAILURE;
+
+  if (!host_interface->Initialize())
+  {
+    host_interface->Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  if (host_interface->IsRunningMicroBenchmark())
+  {
+    const bool result = host_interface->RunMicroBenchmark();
+    host_interface->Shutdown();
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (!host_interface->BootSystem(*boot_params))
+  {
+    host_interface->Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  boot_params.reset();
+
+  const bool result = host_interface->Run();
+  host_interface->Shutdown();
+  host_interface.reset();
+
+  return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -195,6 +195,29 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(QtHostInterface* host_interface,
 
   addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Increase Timer Resolution"), "Main",
                         "IncreaseTimerResolution", true);
+
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Save State Compression Level"), "Main",
+                         "SaveStateCompressionLevel", 0, 9, Settings::DEFAULT_SAVE_STATE_COMPRESSION_LEVEL);
+
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Enable Rewind"), "Main", "RewindEnable", false);
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Rewind Save Frequency (Frames)"), "Main",
+                         "RewindFrequency", 1, 3600, Settings::DEFAULT_REWIND_SAVE_FREQUENCY);
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Rewind Memory Budget (MB)"), "Main",
+                         "RewindMaxMemory", 1, 4096, Settings::DEFAULT_REWIND_MAX_MEMORY);
+
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Run-Ahead Frames"), "Main", "RunaheadFrameCount",
+                         0, Settings::MAX_RUNAHEAD_FRAMES, 0);
+
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Precise Frame Pacing"), "Main",
+                        "PreciseThrottle", false);
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Sync To Host Refresh Rate"), "Main",
+                        "SyncToHostRefreshRate", false);
+
+  addBooleanTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Create Save State Backups"), "Main",
+                        "CreateSaveStateBackups", false);
+
+  addIntRangeTweakOption(m_host_interface, m_ui.tweakOptionTable, tr("Game List Scan Threads (0 = Auto)"), "GameList",
+                         "ScanThreads", 0, 64, 0);
 }
 
 AdvancedSettingsWidget::~AdvancedSettingsWidget() = default;
@@ -222,4 +245,13 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   setIntRangeTweakOption(m_ui.tweakOptionTable, 18, static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD));
   setBooleanTweakOption(m_ui.tweakOptionTable, 19, false);
   setBooleanTweakOption(m_ui.tweakOptionTable, 20, true);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 21, static_cast<int>(Settings::DEFAULT_SAVE_STATE_COMPRESSION_LEVEL));
+  setBooleanTweakOption(m_ui.tweakOptionTable, 22, false);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 23, static_cast<int>(Settings::DEFAULT_REWIND_SAVE_FREQUENCY));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 24, static_cast<int>(Settings::DEFAULT_REWIND_MAX_MEMORY));
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 25, 0);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 26, false);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 27, false);
+  setBooleanTweakOption(m_ui.tweakOptionTable, 28, false);
+  setIntRangeTweakOption(m_ui.tweakOptionTable, 29, 0);
 }
@@ -21,6 +21,7 @@ AudioSettingsWidget::AudioSettingsWidget(QtHostInterface* host_interface, QWidge
                                                &Settings::ParseAudioBackend, &Settings::GetAudioBackendName,
                                                Settings::DEFAULT_AUDIO_BACKEND);
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.syncToOutput, "Audio", "Sync");
+  SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.timeStretch, "Audio", "TimeStretch");
   SettingWidgetBinder::BindWidgetToIntSetting(m_host_interface, m_ui.bufferSize, "Audio", "BufferSize");
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.startDumpingOnBoot, "Audio", "DumpOnBoot");
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.muteCDAudio, "CDROM", "MuteCDAudio");
@@ -52,6 +53,11 @@ AudioSettingsWidget::AudioSettingsWidget(QtHostInterface* host_interface, QWidge
                              tr("Throttles the emulation speed based on the audio backend pulling audio frames. This "
                                 "helps to remove noises or crackling if emulation is too fast. Sync will "
                                 "automatically be disabled if not running at 100% speed."));
+  dialog->registerWidgetHelp(
+    m_ui.timeStretch, tr("Time Stretch"), tr("Unchecked"),
+    tr("Changes the tempo of the audio to match the emulation speed without changing its pitch, and continuously "
+       "adjusts it to keep the output buffer at a steady level. Avoids crackling and pitch changes when not running "
+       "at 100% speed, at the cost of a small amount of additional latency."));
   dialog->registerWidgetHelp(
     m_ui.startDumpingOnBoot, tr("Start Dumping On Boot"), tr("Unchecked"),
     tr("Start dumping audio to file as soon as the emulator is started. Mainly useful as a debug option."));
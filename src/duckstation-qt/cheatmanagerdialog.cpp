@@ -779,13 +779,7 @@ void CheatManagerDialog::updateResults()
     for (const MemoryScan::Result& res : m_scanner.GetResults())
     {
       if (row == MAX_DISPLAYED_SCAN_RESULTS)
-      {
-        QMessageBox::information(this, tr("Memory Scan"),
-                                 tr("Memory scan found %1 addresses, but only the first %2 are displayed.")
-                                   .arg(m_scanner.GetResultCount())
-                                   .arg(MAX_DISPLAYED_SCAN_RESULTS));
         break;
-      }
 
       m_ui.scanTable->insertRow(row);
 
@@ -801,6 +795,14 @@ void CheatManagerDialog::updateResults()
       m_ui.scanTable->setItem(row, 2, previous_item);
       row++;
     }
+
+    if (m_scanner.GetResultCount() > static_cast<u32>(row))
+    {
+      QMessageBox::information(this, tr("Memory Scan"),
+                               tr("Memory scan found %1 addresses, but only the first %2 are displayed.")
+                                 .arg(m_scanner.GetResultCount())
+                                 .arg(row));
+    }
   }
 
   m_ui.scanResetSearch->setEnabled(!results.empty());
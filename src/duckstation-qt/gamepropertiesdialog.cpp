@@ -88,7 +88,8 @@ void GamePropertiesDialog::populate(const GameListEntry* ge)
 
 void GamePropertiesDialog::populateCompatibilityInfo(const std::string& game_code)
 {
-  const GameListCompatibilityEntry* entry = m_host_interface->getGameList()->GetCompatibilityEntryForCode(game_code);
+  const std::optional<GameListCompatibilityEntry> entry =
+    m_host_interface->getGameList()->GetCompatibilityEntryForCode(game_code);
 
   {
     QSignalBlocker blocker(m_ui.compatibility);
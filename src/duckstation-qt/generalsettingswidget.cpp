@@ -33,6 +33,8 @@ GeneralSettingsWidget::GeneralSettingsWidget(QtHostInterface* host_interface, QW
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.applyGameSettings, "Main", "ApplyGameSettings",
                                                true);
   SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.autoLoadCheats, "Main", "AutoLoadCheats", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(m_host_interface, m_ui.unthrottledTurbo, "Main", "UnthrottledTurbo",
+                                               false);
 
   SettingWidgetBinder::BindWidgetToEnumSetting(
     m_host_interface, m_ui.controllerBackend, "Main", "ControllerBackend", &ControllerInterface::ParseBackendName,
@@ -91,6 +93,11 @@ GeneralSettingsWidget::GeneralSettingsWidget(QtHostInterface* host_interface, QW
     m_ui.fastForwardSpeed, tr("Fast Forward Speed"), "100%",
     tr(
       "Sets the fast forward (turbo) speed. This speed will be used when the fast forward hotkey is pressed/toggled."));
+  dialog->registerWidgetHelp(
+    m_ui.unthrottledTurbo, tr("Turbo When Unthrottled"), tr("Unchecked"),
+    tr("When running at unlimited speed, runs as many frames as fit in one refresh of your display and only shows the "
+       "last one. Audio is discarded. Much faster for skipping through intros and loading, but frames in between "
+       "are never seen, and rewind states are not saved."));
   dialog->registerWidgetHelp(m_ui.controllerBackend, tr("Controller Backend"),
                              qApp->translate("ControllerInterface", ControllerInterface::GetBackendName(
                                                                       ControllerInterface::GetDefaultBackend())),
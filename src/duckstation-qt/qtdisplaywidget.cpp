@@ -89,9 +89,16 @@ std::optional<WindowInfo> QtDisplayWidget::getWindowInfo() const
   wi.surface_scale = devicePixelRatioFromScreen();
   wi.surface_format = WindowInfo::SurfaceFormat::RGB8;
 
+  wi.surface_refresh_rate = refreshRateFromScreen();
   return wi;
 }
 
+float QtDisplayWidget::refreshRateFromScreen() const
+{
+  const QScreen* screen = windowHandle() ? windowHandle()->screen() : nullptr;
+  return screen ? static_cast<float>(screen->refreshRate()) : 0.0f;
+}
+
 QPaintEngine* QtDisplayWidget::paintEngine() const
 {
   return nullptr;
@@ -137,6 +144,14 @@ bool QtDisplayWidget::event(QEvent* event)
       return true;
     }
 
+    case QEvent::ScreenChangeInternal:
+    {
+      QWidget::event(event);
+
+      emit windowRefreshRateChangedEvent(refreshRateFromScreen());
+      return true;
+    }
+
     case QEvent::Close:
     {
       emit windowClosedEvent();
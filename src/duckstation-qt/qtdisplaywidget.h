@@ -19,9 +19,11 @@ public:
   qreal devicePixelRatioFromScreen() const;
 
   std::optional<WindowInfo> getWindowInfo() const;
+  float refreshRateFromScreen() const;
 
 Q_SIGNALS:
   void windowResizedEvent(int width, int height);
+  void windowRefreshRateChangedEvent(float refresh_rate);
   void windowRestoredEvent();
   void windowClosedEvent();
   void windowKeyEvent(int key_code, bool pressed);
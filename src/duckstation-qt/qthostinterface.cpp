@@ -457,6 +457,15 @@ void QtHostInterface::onHostDisplayWindowResized(int width, int height)
   }
 }
 
+void QtHostInterface::onHostDisplayRefreshRateChanged(float refresh_rate)
+{
+  if (!m_display || refresh_rate == m_display->GetWindowRefreshRate())
+    return;
+
+  m_display->SetWindowRefreshRate(refresh_rate);
+  System::UpdateThrottlePeriod();
+}
+
 void QtHostInterface::redrawDisplayWindow()
 {
   if (!isOnWorkerThread())
@@ -548,6 +557,8 @@ void QtHostInterface::connectDisplaySignals(QtDisplayWidget* widget)
   widget->disconnect(this);
 
   connect(widget, &QtDisplayWidget::windowResizedEvent, this, &QtHostInterface::onHostDisplayWindowResized);
+  connect(widget, &QtDisplayWidget::windowRefreshRateChangedEvent, this,
+          &QtHostInterface::onHostDisplayRefreshRateChanged);
   connect(widget, &QtDisplayWidget::windowRestoredEvent, this, &QtHostInterface::redrawDisplayWindow);
   connect(widget, &QtDisplayWidget::windowClosedEvent, this, &QtHostInterface::powerOffSystem,
           Qt::BlockingQueuedConnection);
@@ -1351,7 +1362,7 @@ void QtHostInterface::threadEntryPoint()
       continue;
     }
 
-    System::RunFrame();
+    RunFrames();
     UpdateControllerRumble();
     if (m_frame_step_request)
     {
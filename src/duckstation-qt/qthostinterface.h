@@ -180,6 +180,7 @@ public Q_SLOTS:
 private Q_SLOTS:
   void doStopThread();
   void onHostDisplayWindowResized(int width, int height);
+  void onHostDisplayRefreshRateChanged(float refresh_rate);
   void doBackgroundControllerPoll();
   void doSaveSettings();
 
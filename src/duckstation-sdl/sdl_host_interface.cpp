@@ -206,6 +206,16 @@ void SDLHostInterface::UpdateFramebufferScale()
   ImGui::GetIO().DisplayFramebufferScale.y = framebuffer_scale;
 }
 
+void SDLHostInterface::UpdateRefreshRate()
+{
+  const float refresh_rate = SDLUtil::GetRefreshRate(m_window);
+  if (refresh_rate == m_display->GetWindowRefreshRate())
+    return;
+
+  m_display->SetWindowRefreshRate(refresh_rate);
+  System::UpdateThrottlePeriod();
+}
+
 bool SDLHostInterface::AcquireHostDisplay()
 {
   // Handle renderer switch if required.
@@ -362,6 +372,7 @@ bool SDLHostInterface::SetFullscreen(bool enabled)
   int window_width, window_height;
   SDL_GetWindowSize(m_window, &window_width, &window_height);
   m_display->ResizeRenderWindow(window_width, window_height);
+  UpdateRefreshRate();
 
   if (!System::IsShutdown())
     g_gpu->UpdateResolutionScale();
@@ -553,7 +564,9 @@ void SDLHostInterface::HandleSDLEvent(const SDL_Event* event)
       }
       else if (event->window.event == SDL_WINDOWEVENT_MOVED)
       {
+        // The window may now be on another display.
         UpdateFramebufferScale();
+        UpdateRefreshRate();
       }
     }
     break;
@@ -1169,6 +1182,7 @@ void SDLHostInterface::DrawDebugMenu()
   settings_changed |= ImGui::MenuItem("Show Timers State", nullptr, &debug_settings.show_timers_state);
   settings_changed |= ImGui::MenuItem("Show MDEC State", nullptr, &debug_settings.show_mdec_state);
   settings_changed |= ImGui::MenuItem("Show DMA State", nullptr, &debug_settings.show_dma_state);
+  settings_changed |= ImGui::MenuItem("Show Subsystem Timings", nullptr, &debug_settings.show_perf_timers);
 
   if (settings_changed)
   {
@@ -1183,6 +1197,7 @@ void SDLHostInterface::DrawDebugMenu()
     debug_settings_copy.show_timers_state = debug_settings.show_timers_state;
     debug_settings_copy.show_mdec_state = debug_settings.show_mdec_state;
     debug_settings_copy.show_dma_state = debug_settings.show_dma_state;
+    debug_settings_copy.show_perf_timers = debug_settings.show_perf_timers;
     RunLater([this]() { SaveAndUpdateSettings(); });
   }
 }
@@ -1343,13 +1358,29 @@ void SDLHostInterface::DrawSettingsWindow()
 
         settings_changed |= ImGui::SliderFloat("##speed", &m_settings_copy.emulation_speed, 0.25f, 5.0f);
         settings_changed |= ImGui::Checkbox("Increase Timer Resolution", &m_settings_copy.increase_timer_resolution);
+        settings_changed |= ImGui::Checkbox("Precise Frame Pacing", &m_settings_copy.precise_throttle);
+        settings_changed |=
+          ImGui::Checkbox("Sync To Host Refresh Rate", &m_settings_copy.sync_to_host_refresh_rate);
+        settings_changed |= ImGui::Checkbox("Turbo When Unthrottled", &m_settings_copy.unthrottled_turbo);
         settings_changed |= ImGui::Checkbox("Pause On Start", &m_settings_copy.start_paused);
         settings_changed |= ImGui::Checkbox("Start Fullscreen", &m_settings_copy.start_fullscreen);
         settings_changed |= ImGui::Checkbox("Save State On Exit", &m_settings_copy.save_state_on_exit);
+        settings_changed |= ImGui::Checkbox("Create Save State Backups", &m_settings_copy.save_state_backups);
         settings_changed |= ImGui::Checkbox("Apply Game Settings", &m_settings_copy.apply_game_settings);
         settings_changed |= ImGui::Checkbox("Automatically Load Cheats", &m_settings_copy.auto_load_cheats);
         settings_changed |=
           ImGui::Checkbox("Load Devices From Save States", &m_settings_copy.load_devices_from_save_states);
+        settings_changed |= ImGui::Checkbox("Enable Rewind", &m_settings_copy.rewind_enable);
+
+        ImGui::Text("Run-Ahead Frames:");
+        ImGui::SameLine(indent);
+
+        int runahead_frames = static_cast<int>(m_settings_copy.runahead_frames);
+        if (ImGui::SliderInt("##runahead_frames", &runahead_frames, 0, Settings::MAX_RUNAHEAD_FRAMES))
+        {
+          m_settings_copy.runahead_frames = static_cast<u32>(runahead_frames);
+          settings_changed = true;
+        }
       }
 
       ImGui::NewLine();
@@ -1380,6 +1411,7 @@ void SDLHostInterface::DrawSettingsWindow()
         }
 
         settings_changed |= ImGui::Checkbox("Output Sync", &m_settings_copy.audio_sync_enabled);
+        settings_changed |= ImGui::Checkbox("Time Stretch", &m_settings_copy.audio_time_stretch);
         settings_changed |= ImGui::Checkbox("Start Dumping On Boot", &m_settings_copy.audio_dump_on_boot);
         settings_changed |= ImGui::Checkbox("Mute CD Audio", &m_settings_copy.cdrom_mute_cd_audio);
       }
@@ -1810,7 +1842,7 @@ void SDLHostInterface::Run()
 
     if (System::IsRunning())
     {
-      System::RunFrame();
+      RunFrames();
       UpdateControllerRumble();
       if (m_frame_step_request)
       {
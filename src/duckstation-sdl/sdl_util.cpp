@@ -35,6 +35,8 @@ std::optional<WindowInfo> GetWindowInfoForSDLWindow(SDL_Window* window)
   wi.surface_scale = GetDPIScaleFactor(window);
   wi.surface_format = WindowInfo::SurfaceFormat::RGB8;
 
+  wi.surface_refresh_rate = GetRefreshRate(window);
+
   switch (syswm.subsystem)
   {
 #ifdef SDL_VIDEO_DRIVER_WINDOWS
@@ -104,4 +106,13 @@ float GetDPIScaleFactor(SDL_Window* window)
 
   return display_dpi / DEFAULT_DPI;
 }
+
+float GetRefreshRate(SDL_Window* window)
+{
+  SDL_DisplayMode display_mode;
+  if (SDL_GetWindowDisplayMode(window, &display_mode) != 0 || display_mode.refresh_rate <= 0)
+    return 0.0f;
+
+  return static_cast<float>(display_mode.refresh_rate);
+}
 } // namespace SDLUtil
\ No newline at end of file
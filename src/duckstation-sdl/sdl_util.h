@@ -8,4 +8,5 @@ struct SDL_Window;
 namespace SDLUtil {
 std::optional<WindowInfo> GetWindowInfoForSDLWindow(SDL_Window* window);
 float GetDPIScaleFactor(SDL_Window* window);
+float GetRefreshRate(SDL_Window* window);
 }
\ No newline at end of file
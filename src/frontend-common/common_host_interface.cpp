@@ -13,6 +13,7 @@
 #include "core/gpu.h"
 #include "core/host_display.h"
 #include "core/mdec.h"
+#include "core/perf_timers.h"
 #include "core/pgxp.h"
 #include "core/save_state_version.h"
 #include "core/spu.h"
@@ -24,12 +25,14 @@
 #include "icon.h"
 #include "imgui.h"
 #include "ini_settings_interface.h"
+#include "save_state_io_thread.h"
 #include "save_state_selector_ui.h"
 #include "scmversion/scmversion.h"
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <limits>
 
 #ifdef WITH_SDL2
 #include "sdl_audio_stream.h"
@@ -74,8 +77,12 @@ bool CommonHostInterface::Initialize()
   m_game_list->SetUserDatabaseFilename(GetUserDirectoryRelativePath("redump.dat"));
   m_game_list->SetUserCompatibilityListFilename(GetUserDirectoryRelativePath("compatibility.xml"));
   m_game_list->SetUserGameSettingsFilename(GetUserDirectoryRelativePath("gamesettings.ini"));
+  m_game_list->SetCompiledDatabaseFilename(GetUserDirectoryRelativePath("cache/redump.bin"));
+  m_game_list->SetCompiledCompatibilityListFilename(GetUserDirectoryRelativePath("cache/compatibility.bin"));
 
   m_save_state_selector_ui = std::make_unique<FrontendCommon::SaveStateSelectorUI>(this);
+  m_save_state_io = std::make_unique<FrontendCommon::SaveStateIOThread>();
+  m_save_state_io->StartThread();
 
   RegisterGeneralHotkeys();
   RegisterGraphicsHotkeys();
@@ -90,6 +97,13 @@ void CommonHostInterface::Shutdown()
 {
   HostInterface::Shutdown();
 
+  if (m_save_state_io)
+  {
+    m_save_state_io->StopThread();
+    ProcessSaveStateWriteResults();
+    m_save_state_io.reset();
+  }
+
 #ifdef WITH_DISCORD_PRESENCE
   ShutdownDiscordPresence();
 #endif
@@ -165,6 +179,8 @@ void CommonHostInterface::DestroySystem()
   SetTimerResolutionIncreased(false);
   m_save_state_selector_ui->Close();
   m_display->SetPostProcessingChain({});
+  m_save_state_io->WaitForWrites();
+  ProcessSaveStateWriteResults();
 
   HostInterface::DestroySystem();
 }
@@ -419,6 +435,8 @@ bool CommonHostInterface::ParseCommandLineParameters(int argc, char* argv[],
 
 void CommonHostInterface::PollAndUpdate()
 {
+  ProcessSaveStateWriteResults();
+
 #ifdef WITH_DISCORD_PRESENCE
   PollDiscordPresence();
 #endif
@@ -526,7 +544,11 @@ bool CommonHostInterface::LoadState(bool global, s32 slot)
 
   std::string save_path =
     global ? GetGlobalSaveStateFileName(slot) : GetGameSaveStateFileName(System::GetRunningCode().c_str(), slot);
-  return LoadState(save_path.c_str());
+  std::unique_ptr<ByteStream> stream = m_save_state_io->OpenForReading(save_path.c_str());
+  if (!stream)
+    return false;
+
+  return LoadState(save_path.c_str(), std::move(stream));
 }
 
 bool CommonHostInterface::SaveState(bool global, s32 slot)
@@ -539,13 +561,48 @@ bool CommonHostInterface::SaveState(bool global, s32 slot)
   }
 
   std::string save_path = global ? GetGlobalSaveStateFileName(slot) : GetGameSaveStateFileName(code.c_str(), slot);
-  if (!SaveState(save_path.c_str()))
+
+  // Only the snapshot is taken here, compressing and writing it out happens on the I/O thread.
+  std::unique_ptr<GrowableMemoryByteStream> state = ByteStream_CreateGrowableMemoryStream();
+  if (!System::SaveState(state.get(), 128, 0))
+  {
+    ReportFormattedError(TranslateString("OSDMessage", "Saving state to '%s' failed."), save_path.c_str());
     return false;
+  }
+
+  m_save_state_io->QueueWrite(std::move(save_path), std::move(state), g_settings.save_state_compression_level,
+                              g_settings.save_state_backups, global, slot);
+
+  // Nothing polls for the result while paused.
+  if (System::IsPaused())
+  {
+    m_save_state_io->WaitForWrites();
+    ProcessSaveStateWriteResults();
+  }
 
-  OnSystemStateSaved(global, slot);
   return true;
 }
 
+void CommonHostInterface::ProcessSaveStateWriteResults()
+{
+  for (const FrontendCommon::SaveStateIOThread::WriteResult& result : m_save_state_io->TakeWriteResults())
+  {
+    if (!result.success)
+    {
+      ReportFormattedError(TranslateString("OSDMessage", "Saving state to '%s' failed."), result.path.c_str());
+      continue;
+    }
+
+    AddFormattedOSDMessage(5.0f, TranslateString("OSDMessage", "State saved to '%s'."), result.path.c_str());
+    OnSystemStateSaved(result.global, result.slot);
+  }
+}
+
+void CommonHostInterface::PrefetchSaveState(const char* path)
+{
+  m_save_state_io->Prefetch(path);
+}
+
 bool CommonHostInterface::ResumeSystemFromState(const char* filename, bool boot_on_failure)
 {
   SystemBootParameters boot_params;
@@ -602,21 +659,25 @@ void CommonHostInterface::UpdateSpeedLimiterState()
 {
   const float target_speed = m_fast_forward_enabled ? g_settings.fast_forward_speed : g_settings.emulation_speed;
   m_speed_limiter_enabled = (target_speed != 0.0f);
+  m_turbo_enabled = (!m_speed_limiter_enabled && g_settings.unthrottled_turbo);
 
   const bool is_non_standard_speed = (std::abs(target_speed - 1.0f) > 0.05f);
   const bool audio_sync_enabled =
     !System::IsRunning() || (m_speed_limiter_enabled && g_settings.audio_sync_enabled && !is_non_standard_speed);
   const bool video_sync_enabled =
     !System::IsRunning() || (m_speed_limiter_enabled && g_settings.video_sync_enabled && !is_non_standard_speed);
-  const float max_display_fps = m_speed_limiter_enabled ? 0.0f : g_settings.display_max_fps;
+  const float max_display_fps = (m_speed_limiter_enabled || m_turbo_enabled) ? 0.0f : g_settings.display_max_fps;
   Log_InfoPrintf("Syncing to %s%s", audio_sync_enabled ? "audio" : "",
                  (audio_sync_enabled && video_sync_enabled) ? " and video" : (video_sync_enabled ? "video" : ""));
   Log_InfoPrintf("Max display fps: %f", max_display_fps);
+  if (m_turbo_enabled)
+    Log_InfoPrintf("Turbo enabled, presenting at host refresh rate");
 
   if (m_audio_stream)
   {
     m_audio_stream->SetOutputVolume(GetAudioOutputVolume());
     m_audio_stream->SetSync(audio_sync_enabled);
+    m_audio_stream->SetTimeStretch(g_settings.audio_time_stretch && m_speed_limiter_enabled, target_speed);
     if (audio_sync_enabled)
       m_audio_stream->EmptyBuffers();
   }
@@ -637,6 +698,21 @@ void CommonHostInterface::UpdateSpeedLimiterState()
   }
 }
 
+void CommonHostInterface::RunFrames()
+{
+  // Frame stepping wants exactly one frame.
+  if (!m_turbo_enabled || m_frame_step_request)
+  {
+    System::RunFrame();
+    return;
+  }
+
+  const float refresh_rate = (m_display && m_display->GetWindowRefreshRate() > 0.0f) ?
+                               m_display->GetWindowRefreshRate() :
+                               DEFAULT_TURBO_PRESENT_RATE;
+  System::RunTurboFrames(std::numeric_limits<u32>::max(), 1.0f / refresh_rate);
+}
+
 void CommonHostInterface::RecreateSystem()
 {
   const bool was_paused = System::IsPaused();
@@ -793,13 +869,16 @@ void CommonHostInterface::DrawImGuiWindows()
 void CommonHostInterface::DrawFPSWindow()
 {
   if (!(g_settings.display_show_fps | g_settings.display_show_vps | g_settings.display_show_speed |
-        g_settings.display_show_resolution))
+        g_settings.display_show_resolution | g_settings.display_show_frame_pacing | g_settings.rewind_enable))
   {
     return;
   }
 
-  const ImVec2 window_size =
-    ImVec2(175.0f * ImGui::GetIO().DisplayFramebufferScale.x, 48.0f * ImGui::GetIO().DisplayFramebufferScale.y);
+  const bool wide = (g_settings.rewind_enable || g_settings.display_show_frame_pacing);
+  const float height = 48.0f + (g_settings.rewind_enable ? 16.0f : 0.0f) +
+                       (g_settings.display_show_frame_pacing ? 16.0f : 0.0f);
+  const ImVec2 window_size = ImVec2((wide ? 300.0f : 175.0f) * ImGui::GetIO().DisplayFramebufferScale.x,
+                                    height * ImGui::GetIO().DisplayFramebufferScale.y);
   ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - window_size.x, 0.0f), ImGuiCond_Always);
   ImGui::SetNextWindowSize(window_size);
 
@@ -863,6 +942,22 @@ void CommonHostInterface::DrawFPSWindow()
     ImGui::Text("%ux%u (%s)", effective_width, effective_height, interlaced ? "interlaced" : "progressive");
   }
 
+  if (g_settings.display_show_frame_pacing)
+  {
+    ImGui::Text("Pacing: %.3fms dev / %.3fms worst", System::GetFramePacingDeviation(),
+                System::GetFramePacingWorstError());
+  }
+
+  if (g_settings.rewind_enable)
+  {
+    // history size, and how fast it grows, so the memory budget can be picked sensibly
+    const float memory_mb = static_cast<float>(System::GetRewindMemoryUsage()) / 1048576.0f;
+    const float history_length = System::GetRewindHistoryLength();
+    const float mb_per_minute = (history_length > 0.0f) ? (memory_mb * 60.0f / history_length) : 0.0f;
+    ImGui::Text("Rewind: %.0fs %.1fMB (%.1fMB/min) %.2fms", history_length, memory_mb, mb_per_minute,
+                System::GetAverageRewindSaveTime());
+  }
+
   ImGui::End();
 }
 
@@ -950,6 +1045,8 @@ void CommonHostInterface::DrawDebugWindows()
     g_mdec.DrawDebugStateWindow();
   if (g_settings.debugging.show_dma_state)
     g_dma.DrawDebugStateWindow();
+  if (g_settings.debugging.show_perf_timers)
+    PerfTimers::DrawDebugWindow();
 }
 
 void CommonHostInterface::DoFrameStep()
@@ -1453,6 +1550,12 @@ void CommonHostInterface::RegisterGeneralHotkeys()
                    }
                  });
 
+  RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("Rewind"),
+                 StaticString(TRANSLATABLE("Hotkeys", "Rewind")), [this](bool pressed) {
+                   if (System::IsValid())
+                     System::SetRewinding(pressed);
+                 });
+
   RegisterHotkey(StaticString(TRANSLATABLE("Hotkeys", "General")), StaticString("ToggleFullscreen"),
                  StaticString(TRANSLATABLE("Hotkeys", "Toggle Fullscreen")), [this](bool pressed) {
                    if (pressed)
@@ -2007,7 +2110,7 @@ std::optional<CommonHostInterface::SaveStateInfo> CommonHostInterface::GetSaveSt
 }
 
 std::optional<CommonHostInterface::ExtendedSaveStateInfo>
-CommonHostInterface::GetExtendedSaveStateInfo(const char* game_code, s32 slot)
+CommonHostInterface::GetExtendedSaveStateInfo(const char* game_code, s32 slot, bool load_screenshot /* = true */)
 {
   const bool global = (!game_code || game_code[0] == 0);
   std::string path = global ? GetGlobalSaveStateFileName(slot) : GetGameSaveStateFileName(game_code, slot);
@@ -2045,7 +2148,7 @@ CommonHostInterface::GetExtendedSaveStateInfo(const char* game_code, s32 slot)
   header.game_code[sizeof(header.game_code) - 1] = 0;
   ssi.game_code = header.game_code;
 
-  if (header.screenshot_width > 0 && header.screenshot_height > 0 && header.screenshot_size > 0 &&
+  if (load_screenshot && header.screenshot_width > 0 && header.screenshot_height > 0 && header.screenshot_size > 0 &&
       (static_cast<u64>(header.offset_to_screenshot) + static_cast<u64>(header.screenshot_size)) <= stream->GetSize())
   {
     stream->SeekAbsolute(header.offset_to_screenshot);
@@ -2178,9 +2281,11 @@ void CommonHostInterface::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.audio_buffer_size != old_settings.audio_buffer_size ||
         g_settings.video_sync_enabled != old_settings.video_sync_enabled ||
         g_settings.audio_sync_enabled != old_settings.audio_sync_enabled ||
+        g_settings.audio_time_stretch != old_settings.audio_time_stretch ||
         g_settings.increase_timer_resolution != old_settings.increase_timer_resolution ||
         g_settings.emulation_speed != old_settings.emulation_speed ||
         g_settings.fast_forward_speed != old_settings.fast_forward_speed ||
+        g_settings.unthrottled_turbo != old_settings.unthrottled_turbo ||
         g_settings.display_max_fps != old_settings.display_max_fps)
     {
       UpdateSpeedLimiterState();
@@ -2299,8 +2404,9 @@ void CommonHostInterface::GetGameInfo(const char* path, CDImage* image, std::str
     if (image)
       *code = System::GetGameCodeForImage(image);
 
-    const GameListDatabaseEntry* db_entry = (!code->empty()) ? m_game_list->GetDatabaseEntryForCode(*code) : nullptr;
-    if (db_entry)
+    const std::optional<GameListDatabaseEntry> db_entry =
+      (!code->empty()) ? m_game_list->GetDatabaseEntryForCode(*code) : std::nullopt;
+    if (db_entry.has_value())
       *title = db_entry->title;
     else
       *title = System::GetTitleForPath(path);
@@ -18,6 +18,7 @@ class HostDisplayTexture;
 class ControllerInterface;
 
 namespace FrontendCommon {
+class SaveStateIOThread;
 class SaveStateSelectorUI;
 }
 
@@ -104,8 +105,12 @@ public:
   bool LoadState(bool global, s32 slot);
 
   /// Saves the current emulation state to a file. Specifying a slot of -1 saves the "resume" save state.
+  /// The file is written in the background, OnSystemStateSaved() is called once it is on disk.
   bool SaveState(bool global, s32 slot);
 
+  /// Reads the save state file into memory in the background, so a following LoadState() doesn't hit the disk.
+  void PrefetchSaveState(const char* path);
+
   /// Loads the resume save state for the given game. Optionally boots the game anyway if loading fails.
   bool ResumeSystemFromState(const char* filename, bool boot_on_failure);
 
@@ -123,7 +128,8 @@ public:
   std::optional<SaveStateInfo> GetSaveStateInfo(const char* game_code, s32 slot);
 
   /// Returns save state info if present. If game_code is null or empty, assumes global state.
-  std::optional<ExtendedSaveStateInfo> GetExtendedSaveStateInfo(const char* game_code, s32 slot);
+  std::optional<ExtendedSaveStateInfo> GetExtendedSaveStateInfo(const char* game_code, s32 slot,
+                                                                bool load_screenshot = true);
 
   /// Deletes save states for the specified game code. If resume is set, the resume state is deleted too.
   void DeleteSaveStates(const char* game_code, bool resume);
@@ -202,6 +208,9 @@ protected:
     SETTINGS_VERSION = 3
   };
 
+  /// Presentation rate in turbo mode when the host display doesn't report a refresh rate.
+  static constexpr float DEFAULT_TURBO_PRESENT_RATE = 60.0f;
+
   struct OSDMessage
   {
     std::string text;
@@ -318,6 +327,9 @@ protected:
 
   void UpdateSpeedLimiterState();
 
+  /// Runs a single frame, or in unthrottled turbo mode, as many frames as fit in one host refresh.
+  void RunFrames();
+
   void RecreateSystem() override;
 
   void ApplyGameSettings(bool display_osd_messages);
@@ -346,12 +358,14 @@ protected:
   bool m_fast_forward_enabled = false;
   bool m_timer_resolution_increased = false;
   bool m_speed_limiter_enabled = true;
+  bool m_turbo_enabled = false;
 
 private:
   void InitializeUserDirectory();
   void RegisterGeneralHotkeys();
   void RegisterGraphicsHotkeys();
   void RegisterSaveStateHotkeys();
+  void ProcessSaveStateWriteResults();
   void RegisterAudioHotkeys();
   void FindInputProfiles(const std::string& base_path, InputProfileList* out_list) const;
   void UpdateControllerInputMap(SettingsInterface& si);
@@ -370,6 +384,7 @@ private:
   HotkeyInfoList m_hotkeys;
 
   std::unique_ptr<FrontendCommon::SaveStateSelectorUI> m_save_state_selector_ui;
+  std::unique_ptr<FrontendCommon::SaveStateIOThread> m_save_state_io;
 
   // input key maps
   std::map<HostKeyCode, InputButtonHandler> m_keyboard_input_handlers;
@@ -13,10 +13,17 @@
 #include "core/system.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
 #include <string_view>
+#include <thread>
 #include <tinyxml2.h>
 #include <utility>
+#include <zlib.h>
 Log_SetChannel(GameList);
 
 GameList::GameList() = default;
@@ -143,9 +150,10 @@ bool GameList::GetM3UListEntry(const char* path, GameListEntry* entry)
     if (entry->compatibility_rating == GameListCompatibilityRating::Unknown)
     {
       std::string code = System::GetGameCodeForImage(entry_image.get());
-      const GameListCompatibilityEntry* compatibility_entry = GetCompatibilityEntryForCode(entry->code);
-      if (compatibility_entry)
-        entry->compatibility_rating = compatibility_entry->compatibility_rating;
+      const std::optional<GameListCompatibilityRating> compatibility_rating =
+        GetCompatibilityRatingForCode(entry->code);
+      if (compatibility_rating.has_value())
+        entry->compatibility_rating = compatibility_rating.value();
       else
         Log_WarningPrintf("'%s' (%s) not found in compatibility list", entry->code.c_str(), entry->title.c_str());
     }
@@ -186,8 +194,8 @@ bool GameList::GetGameListEntry(const std::string& path, GameListEntry* entry)
   }
   else
   {
-    const GameListDatabaseEntry* database_entry = GetDatabaseEntryForCode(entry->code);
-    if (database_entry)
+    const std::optional<GameListDatabaseEntry> database_entry = GetDatabaseEntryForCode(entry->code);
+    if (database_entry.has_value())
     {
       entry->title = database_entry->title;
 
@@ -200,9 +208,9 @@ bool GameList::GetGameListEntry(const std::string& path, GameListEntry* entry)
       entry->title = System::GetTitleForPath(path.c_str());
     }
 
-    const GameListCompatibilityEntry* compatibility_entry = GetCompatibilityEntryForCode(entry->code);
-    if (compatibility_entry)
-      entry->compatibility_rating = compatibility_entry->compatibility_rating;
+    const std::optional<GameListCompatibilityRating> compatibility_rating = GetCompatibilityRatingForCode(entry->code);
+    if (compatibility_rating.has_value())
+      entry->compatibility_rating = compatibility_rating.value();
     else
       Log_WarningPrintf("'%s' (%s) not found in compatibility list", entry->code.c_str(), entry->title.c_str());
 
@@ -237,11 +245,13 @@ void GameList::LoadCache()
   if (m_cache_filename.empty())
     return;
 
-  std::unique_ptr<ByteStream> stream =
-    FileSystem::OpenFile(m_cache_filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
-  if (!stream)
+  // Parsing from memory rather than the file saves a read call per field, which adds up with large libraries.
+  std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(m_cache_filename.c_str());
+  if (!data.has_value())
     return;
 
+  std::unique_ptr<ByteStream> stream =
+    ByteStream_CreateReadOnlyMemoryStream(data->data(), static_cast<u32>(data->size()));
   if (!LoadEntriesFromCache(stream.get()))
   {
     Log_WarningPrintf("Deleting corrupted cache file '%s'", m_cache_filename.c_str());
@@ -353,6 +363,8 @@ bool GameList::LoadEntriesFromCache(ByteStream* stream)
       iter->second = std::move(ge);
     else
       m_cache_map.emplace(std::move(path), std::move(ge));
+
+    m_cache_record_count++;
   }
 
   return true;
@@ -435,6 +447,7 @@ void GameList::RewriteCacheFile()
       }
     }
 
+    m_cache_record_count = static_cast<u32>(m_entries.size());
     CloseCacheFileStream();
   }
 }
@@ -442,6 +455,7 @@ void GameList::RewriteCacheFile()
 void GameList::DeleteCacheFile()
 {
   Assert(!m_cache_write_stream);
+  m_cache_record_count = 0;
   if (!FileSystem::FileExists(m_cache_filename.c_str()))
     return;
 
@@ -451,22 +465,46 @@ void GameList::DeleteCacheFile()
     Log_WarningPrintf("Failed to delete game list cache '%s'", m_cache_filename.c_str());
 }
 
-void GameList::ScanDirectory(const char* path, bool recursive, ProgressCallback* progress)
+void GameList::ScanDirectory(const char* path, bool recursive, ProgressCallback* progress, DirectoryScanState* state)
 {
   Log_DevPrintf("Scanning %s%s", path, recursive ? " (recursively)" : "");
 
   progress->PushState();
   progress->SetFormattedStatusText("Scanning directory '%s'%s...", path, recursive ? " (recursively)" : "");
 
+  // Times only have a resolution of one second, so a directory which changed in the same second as the scan could
+  // look unchanged next time. Those are recorded with a zero time, which never matches.
+  const u64 scan_time = static_cast<u64>(Timestamp::Now().AsUnixTimestamp());
+  auto add_directory_time = [state, scan_time](const std::string& dir_path, const Timestamp& modification_time) {
+    const u64 time = static_cast<u64>(modification_time.AsUnixTimestamp());
+    state->directory_times.emplace_back(dir_path, (time < scan_time) ? time : 0);
+  };
+
+  FILESYSTEM_STAT_DATA sd;
+  if (FileSystem::StatFile(path, &sd))
+    add_directory_time(path, sd.ModificationTime);
+
   FileSystem::FindResultsArray files;
-  FileSystem::FindFiles(path, "*", FILESYSTEM_FIND_FILES | (recursive ? FILESYSTEM_FIND_RECURSIVE : 0), &files);
+  FileSystem::FindFiles(path, "*",
+                        FILESYSTEM_FIND_FILES | (recursive ? (FILESYSTEM_FIND_FOLDERS | FILESYSTEM_FIND_RECURSIVE) : 0),
+                        &files);
 
-  GameListEntry entry;
   progress->SetProgressRange(static_cast<u32>(files.size()));
   progress->SetProgressValue(0);
 
+  // Anything not in the cache is collected first, so the images can be opened in parallel.
+  std::vector<GameListEntry> entries;
+  std::vector<u32> probe_indices;
+  entries.reserve(files.size());
+
   for (const FILESYSTEM_FIND_DATA& ffd : files)
   {
+    if (ffd.Attributes & FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY)
+    {
+      add_directory_time(ffd.FileName, ffd.ModificationTime);
+      continue;
+    }
+
     // if this is a .bin, check if we have a .cue. if there is one, skip it
     const char* extension = std::strrchr(ffd.FileName.c_str(), '.');
     if (extension && StringUtil::Strcasecmp(extension, ".bin") == 0)
@@ -486,49 +524,329 @@ void GameList::ScanDirectory(const char* path, bool recursive, ProgressCallback*
     }
 
     std::string entry_path(ffd.FileName);
-    if (std::any_of(m_entries.begin(), m_entries.end(),
-                    [&entry_path](const GameListEntry& other) { return other.path == entry_path; }))
-    {
+    const GameListEntry* existing_entry = GetEntryForPath(entry_path.c_str());
+    if (existing_entry && StringUtil::Strcasecmp(existing_entry->path.c_str(), entry_path.c_str()) == 0)
       continue;
-    }
     Log_DebugPrintf("Trying '%s'...", entry_path.c_str());
 
-    // try opening the image
+    GameListEntry entry;
     if (!GetGameListEntryFromCache(entry_path, &entry) ||
         entry.last_modified_time != ffd.ModificationTime.AsUnixTimestamp())
     {
-      const char* file_part_slash =
-        std::max(std::strrchr(entry_path.c_str(), '/'), std::strrchr(entry_path.c_str(), '\\'));
-      progress->SetFormattedStatusText("Scanning '%s'...",
-                                       file_part_slash ? (file_part_slash + 1) : entry_path.c_str());
+      entry = {};
+      entry.path = std::move(entry_path);
+      probe_indices.push_back(static_cast<u32>(entries.size()));
+    }
+
+    entries.push_back(std::move(entry));
+  }
+
+  ProbeEntries(entries, probe_indices, progress);
+
+  // Failed probes are left with an empty path.
+  for (const u32 index : probe_indices)
+  {
+    const GameListEntry& entry = entries[index];
+    if (!entry.path.empty() && (m_cache_write_stream || OpenCacheForWriting()))
+    {
+      if (WriteEntryToCache(&entry, m_cache_write_stream.get()))
+        m_cache_record_count++;
+      else
+        Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+    }
+  }
+
+  for (GameListEntry& entry : entries)
+  {
+    if (entry.path.empty())
+      continue;
+
+    state->entry_paths.push_back(entry.path);
+    AddEntry(std::move(entry));
+  }
+
+  progress->SetProgressValue(static_cast<u32>(files.size()));
+  progress->PopState();
+}
+
+void GameList::ProbeEntries(std::vector<GameListEntry>& entries, const std::vector<u32>& indices,
+                            ProgressCallback* progress)
+{
+  auto probe_entry = [this](GameListEntry& entry) {
+    const std::string path(std::move(entry.path));
+    if (!GetGameListEntry(path, &entry))
+      entry = {};
+  };
+  auto set_status = [progress](const std::string& path) {
+    const char* file_part_slash = std::max(std::strrchr(path.c_str(), '/'), std::strrchr(path.c_str(), '\\'));
+    progress->SetFormattedStatusText("Scanning '%s'...", file_part_slash ? (file_part_slash + 1) : path.c_str());
+  };
+
+  const u32 num_threads = std::min(GetScanThreadCount(), static_cast<u32>(indices.size()));
+  if (num_threads <= 1)
+  {
+    for (const u32 index : indices)
+    {
+      set_status(entries[index].path);
       progress->IncrementProgressValue();
+      probe_entry(entries[index]);
+    }
+
+    return;
+  }
+
+  Log_DevPrintf("Opening %zu images with %u threads", indices.size(), num_threads);
+
+  // The lookups done while probing would otherwise load these lazily, from whichever worker gets there first.
+  LoadDatabase();
+  LoadCompatibilityList();
+  LoadGameSettings();
+
+  // Progress callbacks can touch the UI, so they're only made from this thread.
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  std::string last_path;
+  u32 num_done = 0;
+  std::atomic<u32> next_index{0};
 
-      if (GetGameListEntry(entry_path, &entry))
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
+  {
+    threads.emplace_back([&]() {
+      for (;;)
       {
-        if (m_cache_write_stream || OpenCacheForWriting())
+        const u32 next = next_index.fetch_add(1, std::memory_order_relaxed);
+        if (next >= static_cast<u32>(indices.size()))
+          break;
+
+        GameListEntry& entry = entries[indices[next]];
+        std::string path(entry.path);
+        probe_entry(entry);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        last_path = std::move(path);
+        num_done++;
+        done_cv.notify_one();
+      }
+    });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  u32 num_reported = 0;
+  while (num_reported < static_cast<u32>(indices.size()))
+  {
+    done_cv.wait(lock, [&]() { return num_done != num_reported; });
+
+    const std::string path(last_path);
+    const u32 count = num_done - num_reported;
+    num_reported = num_done;
+    lock.unlock();
+
+    set_status(path);
+    for (u32 i = 0; i < count; i++)
+      progress->IncrementProgressValue();
+
+    lock.lock();
+  }
+  lock.unlock();
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+u32 GameList::GetScanThreadCount() const
+{
+  if (m_scan_thread_count > 0)
+    return std::min<u32>(m_scan_thread_count, MAX_SCAN_THREADS);
+
+  // Opening images mostly waits on the disk, so it's worth having a few threads even on small machines.
+  return std::clamp<u32>(std::thread::hardware_concurrency(), MIN_AUTO_SCAN_THREADS, MAX_SCAN_THREADS);
+}
+
+/// Sorted records of a key and a fixed number of other strings, plus a value. The strings are pooled after the records,
+/// so the file is used as-is once loaded, and lookups are a binary search which doesn't allocate.
+class GameList::CompiledTable
+{
+public:
+  struct Entry
+  {
+    std::vector<std::string> strings; // key first
+    u32 value;
+  };
+
+  using EntryMap = std::unordered_map<std::string, Entry>;
+  using ParseFunction = std::function<bool(EntryMap*)>;
+
+  u32 GetRecordCount() const { return m_num_records; }
+
+  /// Returns the record index, or -1 if it's not present.
+  s32 Find(std::string_view key) const
+  {
+    u32 low = 0;
+    u32 high = m_num_records;
+    while (low < high)
+    {
+      const u32 mid = low + (high - low) / 2;
+      const int result = GetString(mid, 0).compare(key);
+      if (result == 0)
+        return static_cast<s32>(mid);
+      else if (result < 0)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+
+    return -1;
+  }
+
+  std::string_view GetString(u32 record, u32 index) const
+  {
+    u32 location[2];
+    std::memcpy(location, GetRecord(record) + sizeof(u32) + (sizeof(location) * index), sizeof(location));
+    return std::string_view(reinterpret_cast<const char*>(m_data.data()) + m_pool_offset + location[0], location[1]);
+  }
+
+  u32 GetValue(u32 record) const
+  {
+    u32 value;
+    std::memcpy(&value, GetRecord(record), sizeof(value));
+    return value;
+  }
+
+  /// Loads the table from filename if it was compiled from the same source, otherwise parses the source and saves the
+  /// compiled table to filename.
+  bool LoadOrCompile(const std::string& filename, u32 source_crc, u32 num_strings, const ParseFunction& parse)
+  {
+    if (!filename.empty())
+    {
+      std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(filename.c_str());
+      if (data.has_value() && Load(std::move(data.value()), source_crc, num_strings))
+        return true;
+    }
+
+    EntryMap entries;
+    if (!parse(&entries))
+      return false;
+
+    std::vector<u8> data = Compile(entries, source_crc, num_strings);
+    if (!filename.empty() && !FileSystem::WriteBinaryFile(filename.c_str(), data.data(), data.size()))
+      Log_WarningPrintf("Failed to save '%s'", filename.c_str());
+
+    return Load(std::move(data), source_crc, num_strings);
+  }
+
+private:
+  enum : u32
+  {
+    SIGNATURE = 0x4244434C,
+    VERSION = 1
+  };
+
+  struct Header
+  {
+    u32 signature;
+    u32 version;
+    u32 source_crc;
+    u32 num_strings;
+    u32 num_records;
+    u32 pool_size;
+  };
+
+  static u32 GetRecordSize(u32 num_strings) { return sizeof(u32) + (sizeof(u32) * 2 * num_strings); }
+
+  const u8* GetRecord(u32 record) const { return m_data.data() + sizeof(Header) + (record * m_record_size); }
+
+  static std::vector<u8> Compile(const EntryMap& entries, u32 source_crc, u32 num_strings)
+  {
+    std::vector<const Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& it : entries)
+      sorted.push_back(&it.second);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Entry* lhs, const Entry* rhs) { return lhs->strings[0] < rhs->strings[0]; });
+
+    // Titles are often shared between several codes.
+    std::string pool;
+    std::unordered_map<std::string_view, u32> pool_offsets;
+    std::vector<u32> records;
+    records.reserve(sorted.size() * (GetRecordSize(num_strings) / sizeof(u32)));
+    for (const Entry* entry : sorted)
+    {
+      records.push_back(entry->value);
+      for (u32 i = 0; i < num_strings; i++)
+      {
+        const std::string& str = entry->strings[i];
+        auto iter = pool_offsets.find(str);
+        if (iter == pool_offsets.end())
         {
-          if (!WriteEntryToCache(&entry, m_cache_write_stream.get()))
-            Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+          iter = pool_offsets.emplace(str, static_cast<u32>(pool.size())).first;
+          pool.append(str);
         }
+
+        records.push_back(iter->second);
+        records.push_back(static_cast<u32>(str.size()));
       }
-      else
+    }
+
+    const Header header = {SIGNATURE,   VERSION, source_crc, num_strings, static_cast<u32>(sorted.size()),
+                           static_cast<u32>(pool.size())};
+    std::vector<u8> data(sizeof(header) + (records.size() * sizeof(u32)) + pool.size());
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), records.data(), records.size() * sizeof(u32));
+    std::memcpy(data.data() + sizeof(header) + (records.size() * sizeof(u32)), pool.data(), pool.size());
+    return data;
+  }
+
+  bool Load(std::vector<u8> data, u32 source_crc, u32 num_strings)
+  {
+    Header header;
+    if (data.size() < sizeof(header))
+      return false;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    const u32 record_size = GetRecordSize(num_strings);
+    if (header.signature != SIGNATURE || header.version != VERSION || header.source_crc != source_crc ||
+        header.num_strings != num_strings ||
+        data.size() != (sizeof(header) + (static_cast<size_t>(header.num_records) * record_size) + header.pool_size))
+    {
+      return false;
+    }
+
+    m_data = std::move(data);
+    m_num_records = header.num_records;
+    m_record_size = record_size;
+    m_pool_offset = static_cast<u32>(sizeof(header) + (header.num_records * record_size));
+
+    // Don't trust the file not to point outside the pool.
+    for (u32 i = 0; i < m_num_records; i++)
+    {
+      for (u32 j = 0; j < num_strings; j++)
       {
-        continue;
+        u32 location[2];
+        std::memcpy(location, GetRecord(i) + sizeof(u32) + (sizeof(location) * j), sizeof(location));
+        if ((static_cast<u64>(location[0]) + location[1]) > header.pool_size)
+        {
+          m_data.clear();
+          m_num_records = 0;
+          return false;
+        }
       }
     }
 
-    m_entries.push_back(std::move(entry));
-    entry = {};
+    return true;
   }
 
-  progress->SetProgressValue(static_cast<u32>(files.size()));
-  progress->PopState();
-}
+  std::vector<u8> m_data;
+  u32 m_num_records = 0;
+  u32 m_record_size = 0;
+  u32 m_pool_offset = 0;
+};
 
 class GameList::RedumpDatVisitor final : public tinyxml2::XMLVisitor
 {
 public:
-  RedumpDatVisitor(DatabaseMap& database) : m_database(database) {}
+  RedumpDatVisitor(CompiledTable::EntryMap& database) : m_database(database) {}
 
   static std::string FixupSerial(const std::string_view str)
   {
@@ -579,11 +897,9 @@ public:
       auto iter = m_database.find(code);
       if (iter == m_database.end())
       {
-        GameListDatabaseEntry gde;
-        gde.code = std::move(code);
-        gde.region = System::GetRegionForCode(gde.code);
-        gde.title = name;
-        m_database.emplace(gde.code, std::move(gde));
+        const DiscRegion region = System::GetRegionForCode(code);
+        CompiledTable::Entry entry{{code, name}, static_cast<u32>(region)};
+        m_database.emplace(std::move(code), std::move(entry));
       }
 
       if (!end)
@@ -600,7 +916,7 @@ public:
   }
 
 private:
-  DatabaseMap& m_database;
+  CompiledTable::EntryMap& m_database;
 };
 
 void GameList::AddDirectory(std::string path, bool recursive)
@@ -616,46 +932,95 @@ void GameList::AddDirectory(std::string path, bool recursive)
   m_search_directories.push_back({path, recursive});
 }
 
-const GameListEntry* GameList::GetEntryForPath(const char* path) const
+static std::string GetEntryIndexKey(const char* path)
 {
-  const size_t path_length = std::strlen(path);
-  for (const GameListEntry& entry : m_entries)
-  {
-    if (entry.path.size() == path_length && StringUtil::Strcasecmp(entry.path.c_str(), path) == 0)
-      return &entry;
-  }
+  // Lookups have always been case-insensitive.
+  std::string key(path);
+  std::transform(key.begin(), key.end(), key.begin(),
+                 [](char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); });
+  return key;
+}
 
-  return nullptr;
+const GameListEntry* GameList::GetEntryForPath(const char* path) const
+{
+  auto iter = m_entry_index.find(GetEntryIndexKey(path));
+  return (iter != m_entry_index.end()) ? &m_entries[iter->second] : nullptr;
 }
 
 GameListEntry* GameList::GetMutableEntryForPath(const char* path)
 {
-  const size_t path_length = std::strlen(path);
-  for (GameListEntry& entry : m_entries)
-  {
-    if (entry.path.size() == path_length && StringUtil::Strcasecmp(entry.path.c_str(), path) == 0)
-      return &entry;
-  }
+  auto iter = m_entry_index.find(GetEntryIndexKey(path));
+  return (iter != m_entry_index.end()) ? &m_entries[iter->second] : nullptr;
+}
 
-  return nullptr;
+void GameList::AddEntry(GameListEntry entry)
+{
+  m_entry_index.emplace(GetEntryIndexKey(entry.path.c_str()), static_cast<u32>(m_entries.size()));
+  m_entries.push_back(std::move(entry));
+}
+
+void GameList::ClearEntries()
+{
+  m_entries.clear();
+  m_entry_index.clear();
 }
 
-const GameListDatabaseEntry* GameList::GetDatabaseEntryForCode(const std::string& code) const
+std::optional<GameListDatabaseEntry> GameList::GetDatabaseEntryForCode(std::string_view code) const
 {
   if (!m_database_load_tried)
     const_cast<GameList*>(this)->LoadDatabase();
 
-  auto iter = m_database.find(code);
-  return (iter != m_database.end()) ? &iter->second : nullptr;
+  const s32 index = m_compiled_database ? m_compiled_database->Find(code) : -1;
+  if (index < 0)
+    return std::nullopt;
+
+  return GameListDatabaseEntry{m_compiled_database->GetString(index, 0), m_compiled_database->GetString(index, 1),
+                               static_cast<DiscRegion>(m_compiled_database->GetValue(index))};
 }
 
-const GameListCompatibilityEntry* GameList::GetCompatibilityEntryForCode(const std::string& code) const
+std::optional<GameListCompatibilityEntry> GameList::GetCompatibilityEntryForCode(const std::string& code) const
 {
   if (!m_compatibility_list_load_tried)
     const_cast<GameList*>(this)->LoadCompatibilityList();
 
   auto iter = m_compatibility_list.find(code);
-  return (iter != m_compatibility_list.end()) ? &iter->second : nullptr;
+  if (iter != m_compatibility_list.end())
+    return iter->second;
+
+  const s32 index = m_compiled_compatibility_list ? m_compiled_compatibility_list->Find(code) : -1;
+  if (index < 0)
+    return std::nullopt;
+
+  const CompiledTable& table = *m_compiled_compatibility_list;
+  const u32 value = table.GetValue(index);
+  GameListCompatibilityEntry entry;
+  entry.code = table.GetString(index, 0);
+  entry.title = table.GetString(index, 1);
+  entry.version_tested = table.GetString(index, 2);
+  entry.upscaling_issues = table.GetString(index, 3);
+  entry.comments = table.GetString(index, 4);
+  entry.region = static_cast<DiscRegion>(value & 0xFFu);
+  entry.compatibility_rating = static_cast<GameListCompatibilityRating>(value >> 8);
+  return entry;
+}
+
+std::optional<GameListCompatibilityRating> GameList::GetCompatibilityRatingForCode(std::string_view code) const
+{
+  if (!m_compatibility_list_load_tried)
+    const_cast<GameList*>(this)->LoadCompatibilityList();
+
+  if (!m_compatibility_list.empty())
+  {
+    auto iter = m_compatibility_list.find(std::string(code));
+    if (iter != m_compatibility_list.end())
+      return iter->second.compatibility_rating;
+  }
+
+  const s32 index = m_compiled_compatibility_list ? m_compiled_compatibility_list->Find(code) : -1;
+  if (index < 0)
+    return std::nullopt;
+
+  return static_cast<GameListCompatibilityRating>(m_compiled_compatibility_list->GetValue(index) >> 8);
 }
 
 void GameList::SetSearchDirectoriesFromSettings(SettingsInterface& si)
@@ -669,6 +1034,37 @@ void GameList::SetSearchDirectoriesFromSettings(SettingsInterface& si)
   dirs = si.GetStringList("GameList", "RecursivePaths");
   for (std::string& dir : dirs)
     m_search_directories.push_back({std::move(dir), true});
+
+  m_scan_thread_count = static_cast<u32>(std::max(si.GetIntValue("GameList", "ScanThreads", 0), 0));
+}
+
+bool GameList::RestoreDirectory(DirectoryScanState& state)
+{
+  if (state.directory_times.empty())
+    return false;
+
+  for (const auto& it : state.directory_times)
+  {
+    FILESYSTEM_STAT_DATA sd;
+    if (!FileSystem::StatFile(it.first.c_str(), &sd) ||
+        static_cast<u64>(sd.ModificationTime.AsUnixTimestamp()) != it.second)
+    {
+      return false;
+    }
+  }
+
+  for (const std::string& path : state.entry_paths)
+  {
+    // Entries already claimed by an earlier search directory won't be in the map any more.
+    auto iter = m_cache_map.find(path);
+    if (iter == m_cache_map.end())
+      continue;
+
+    AddEntry(std::move(iter->second));
+    m_cache_map.erase(iter);
+  }
+
+  return true;
 }
 
 void GameList::Refresh(bool invalidate_cache, bool invalidate_database, ProgressCallback* progress /* = nullptr */)
@@ -676,15 +1072,29 @@ void GameList::Refresh(bool invalidate_cache, bool invalidate_database, Progress
   if (!progress)
     progress = ProgressCallback::NullProgressCallback;
 
+  // Entries from the last refresh stand in for the cache file, so only new or modified files have to be opened.
+  const bool incremental = (!invalidate_cache && !invalidate_database && !m_directory_scan_state.empty());
+
   if (invalidate_cache)
     DeleteCacheFile();
-  else
+  else if (!incremental)
     LoadCache();
 
   if (invalidate_database)
     ClearDatabase();
 
-  m_entries.clear();
+  if (incremental)
+  {
+    for (GameListEntry& entry : m_entries)
+    {
+      std::string path(entry.path);
+      m_cache_map.emplace(std::move(path), std::move(entry));
+    }
+  }
+
+  std::vector<DirectoryScanState> last_scan_state;
+  last_scan_state.swap(m_directory_scan_state);
+  ClearEntries();
 
   if (!m_search_directories.empty())
   {
@@ -694,7 +1104,23 @@ void GameList::Refresh(bool invalidate_cache, bool invalidate_database, Progress
     for (u32 i = 0; i < static_cast<u32>(m_search_directories.size()); i++)
     {
       const DirectoryEntry& de = m_search_directories[i];
-      ScanDirectory(de.path.c_str(), de.recursive, progress);
+      auto last_state =
+        std::find_if(last_scan_state.begin(), last_scan_state.end(), [&de](const DirectoryScanState& state) {
+          return (state.path == de.path && state.recursive == de.recursive);
+        });
+      if (incremental && last_state != last_scan_state.end() && RestoreDirectory(*last_state))
+      {
+        Log_DevPrintf("Directory '%s' is unchanged", de.path.c_str());
+        m_directory_scan_state.push_back(std::move(*last_state));
+        last_scan_state.erase(last_state);
+      }
+      else
+      {
+        DirectoryScanState state{de.path, de.recursive, {}, {}};
+        ScanDirectory(de.path.c_str(), de.recursive, progress, &state);
+        m_directory_scan_state.push_back(std::move(state));
+      }
+
       progress->SetProgressValue(i + 1);
     }
   }
@@ -702,6 +1128,13 @@ void GameList::Refresh(bool invalidate_cache, bool invalidate_database, Progress
   // don't need unused cache entries
   CloseCacheFileStream();
   m_cache_map.clear();
+
+  // Replaced entries are only appended to the cache file, so drop them once they outnumber the live ones.
+  if (!m_cache_filename.empty() && m_cache_record_count > static_cast<u32>(m_entries.size()) * 2u)
+  {
+    Log_InfoPrintf("Compacting game list cache (%u records for %zu entries)", m_cache_record_count, m_entries.size());
+    RewriteCacheFile();
+  }
 }
 
 void GameList::UpdateCompatibilityEntry(GameListCompatibilityEntry new_entry, bool save_to_list /*= true*/)
@@ -736,53 +1169,59 @@ void GameList::LoadDatabase()
 
   m_database_load_tried = true;
 
-  tinyxml2::XMLDocument doc;
-  if (FileSystem::FileExists(m_user_database_filename.c_str()))
-  {
-    std::unique_ptr<ByteStream> stream =
-      FileSystem::OpenFile(m_user_database_filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
-    if (stream)
-    {
-      const std::string xml(FileSystem::ReadStreamToString(stream.get()));
+  auto load_from_xml = [this](const std::string& xml) {
+    auto parse = [&xml](CompiledTable::EntryMap* entries) {
+      tinyxml2::XMLDocument doc;
       tinyxml2::XMLError error = doc.Parse(xml.data(), xml.size());
       if (error != tinyxml2::XML_SUCCESS)
       {
         Log_ErrorPrintf("Failed to parse redump dat: %s", tinyxml2::XMLDocument::ErrorIDToName(error));
-        doc.Clear();
+        return false;
       }
-    }
-  }
-  if (!doc.RootElement())
-  {
-    std::unique_ptr<ByteStream> stream = g_host_interface->OpenPackageFile(
-      "database" FS_OSPATH_SEPARATOR_STR "redump.dat", BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
-    if (stream)
-    {
-      const std::string xml(FileSystem::ReadStreamToString(stream.get()));
-      tinyxml2::XMLError error = doc.Parse(xml.data(), xml.size());
-      if (error != tinyxml2::XML_SUCCESS)
+
+      const tinyxml2::XMLElement* datafile_elem = doc.FirstChildElement("datafile");
+      if (!datafile_elem)
       {
-        Log_ErrorPrintf("Failed to parse redump dat: %s", tinyxml2::XMLDocument::ErrorIDToName(error));
-        return;
+        Log_ErrorPrintf("Failed to get datafile element in redump dat");
+        return false;
       }
+
+      RedumpDatVisitor visitor(*entries);
+      datafile_elem->Accept(&visitor);
+      Log_InfoPrintf("Compiled %zu entries from Redump.org database", entries->size());
+      return true;
+    };
+
+    const u32 crc =
+      static_cast<u32>(crc32(0, reinterpret_cast<const Bytef*>(xml.data()), static_cast<uInt>(xml.size())));
+    m_compiled_database = std::make_unique<CompiledTable>();
+    if (!m_compiled_database->LoadOrCompile(m_compiled_database_filename, crc, 2, parse))
+    {
+      m_compiled_database.reset();
+      return false;
     }
-  }
 
-  const tinyxml2::XMLElement* datafile_elem = doc.FirstChildElement("datafile");
-  if (!datafile_elem)
+    Log_InfoPrintf("Loaded %u entries from Redump.org database", m_compiled_database->GetRecordCount());
+    return true;
+  };
+
+  if (FileSystem::FileExists(m_user_database_filename.c_str()))
   {
-    Log_ErrorPrintf("Failed to get datafile element in redump dat");
-    return;
+    std::unique_ptr<ByteStream> stream =
+      FileSystem::OpenFile(m_user_database_filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+    if (stream && load_from_xml(FileSystem::ReadStreamToString(stream.get())))
+      return;
   }
 
-  RedumpDatVisitor visitor(m_database);
-  datafile_elem->Accept(&visitor);
-  Log_InfoPrintf("Loaded %zu entries from Redump.org database", m_database.size());
+  std::unique_ptr<ByteStream> stream = g_host_interface->OpenPackageFile(
+    "database" FS_OSPATH_SEPARATOR_STR "redump.dat", BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+  if (stream)
+    load_from_xml(FileSystem::ReadStreamToString(stream.get()));
 }
 
 void GameList::ClearDatabase()
 {
-  m_database.clear();
+  m_compiled_database.reset();
   m_database_load_tried = false;
 }
 
@@ -876,30 +1315,63 @@ void GameList::LoadCompatibilityList()
   m_compatibility_list_load_tried = true;
 
   // list we ship with
+  std::string package_xml;
   {
     std::unique_ptr<ByteStream> file =
       g_host_interface->OpenPackageFile("database/compatibility.xml", BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
     if (file)
-    {
-      LoadCompatibilityListFromXML(FileSystem::ReadStreamToString(file.get()));
-    }
+      package_xml = FileSystem::ReadStreamToString(file.get());
     else
-    {
       Log_ErrorPrintf("Failed to load compatibility.xml from package");
-    }
   }
 
   // user's list
+  std::string user_xml;
   if (!m_user_compatibility_list_filename.empty() && FileSystem::FileExists(m_user_compatibility_list_filename.c_str()))
   {
     std::unique_ptr<ByteStream> file =
       FileSystem::OpenFile(m_user_compatibility_list_filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
     if (file)
-      LoadCompatibilityListFromXML(FileSystem::ReadStreamToString(file.get()));
+      user_xml = FileSystem::ReadStreamToString(file.get());
   }
+
+  auto parse = [&package_xml, &user_xml](CompiledTable::EntryMap* entries) {
+    // user's entries replace the ones we ship with
+    CompatibilityMap list;
+    if (!package_xml.empty())
+      LoadCompatibilityListFromXML(package_xml, &list);
+    if (!user_xml.empty())
+      LoadCompatibilityListFromXML(user_xml, &list);
+
+    for (auto& it : list)
+    {
+      GameListCompatibilityEntry& entry = it.second;
+      const u32 value = static_cast<u32>(entry.region) | (static_cast<u32>(entry.compatibility_rating) << 8);
+      entries->emplace(it.first, CompiledTable::Entry{{std::move(entry.code), std::move(entry.title),
+                                                       std::move(entry.version_tested),
+                                                       std::move(entry.upscaling_issues), std::move(entry.comments)},
+                                                      value});
+    }
+
+    Log_InfoPrintf("Compiled %zu entries from compatibility list", entries->size());
+    return true;
+  };
+
+  u32 crc = static_cast<u32>(
+    crc32(0, reinterpret_cast<const Bytef*>(package_xml.data()), static_cast<uInt>(package_xml.size())));
+  crc =
+    static_cast<u32>(crc32(crc, reinterpret_cast<const Bytef*>(user_xml.data()), static_cast<uInt>(user_xml.size())));
+  m_compiled_compatibility_list = std::make_unique<CompiledTable>();
+  if (!m_compiled_compatibility_list->LoadOrCompile(m_compiled_compatibility_list_filename, crc, 5, parse))
+  {
+    m_compiled_compatibility_list.reset();
+    return;
+  }
+
+  Log_InfoPrintf("Loaded %u entries from compatibility list", m_compiled_compatibility_list->GetRecordCount());
 }
 
-bool GameList::LoadCompatibilityListFromXML(const std::string& xml)
+bool GameList::LoadCompatibilityListFromXML(const std::string& xml, CompatibilityMap* list)
 {
   tinyxml2::XMLDocument doc;
   tinyxml2::XMLError error = doc.Parse(xml.c_str(), xml.size());
@@ -916,9 +1388,8 @@ bool GameList::LoadCompatibilityListFromXML(const std::string& xml)
     return false;
   }
 
-  CompatibilityListVisitor visitor(m_compatibility_list);
+  CompatibilityListVisitor visitor(*list);
   datafile_elem->Accept(&visitor);
-  Log_InfoPrintf("Loaded %zu entries from compatibility list", m_compatibility_list.size());
   return true;
 }
 
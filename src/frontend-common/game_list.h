@@ -32,10 +32,11 @@ enum class GameListCompatibilityRating
   Count,
 };
 
+/// Points into the compiled database, valid until the database is reloaded.
 struct GameListDatabaseEntry
 {
-  std::string code;
-  std::string title;
+  std::string_view code;
+  std::string_view title;
   DiscRegion region;
 };
 
@@ -81,16 +82,32 @@ public:
   const u32 GetEntryCount() const { return static_cast<u32>(m_entries.size()); }
 
   const GameListEntry* GetEntryForPath(const char* path) const;
-  const GameListDatabaseEntry* GetDatabaseEntryForCode(const std::string& code) const;
-  const GameListCompatibilityEntry* GetCompatibilityEntryForCode(const std::string& code) const;
+  std::optional<GameListDatabaseEntry> GetDatabaseEntryForCode(std::string_view code) const;
+  std::optional<GameListCompatibilityEntry> GetCompatibilityEntryForCode(const std::string& code) const;
+  std::optional<GameListCompatibilityRating> GetCompatibilityRatingForCode(std::string_view code) const;
 
   void SetCacheFilename(std::string filename) { m_cache_filename = std::move(filename); }
   void SetUserDatabaseFilename(std::string filename) { m_user_database_filename = std::move(filename); }
   void SetUserCompatibilityListFilename(std::string filename) { m_user_compatibility_list_filename = std::move(filename); }
   void SetUserGameSettingsFilename(std::string filename) { m_user_game_settings_filename = std::move(filename); }
+
+  /// Where the database and compatibility list are saved once compiled from XML. They're only compiled again when the
+  /// XML changes. Without filenames, they're compiled on every load.
+  void SetCompiledDatabaseFilename(std::string filename) { m_compiled_database_filename = std::move(filename); }
+  void SetCompiledCompatibilityListFilename(std::string filename)
+  {
+    m_compiled_compatibility_list_filename = std::move(filename);
+  }
   void SetSearchDirectoriesFromSettings(SettingsInterface& si);
 
+  /// Number of threads used to open images when scanning. 0 picks one per CPU (at least four), 1 scans on the
+  /// calling thread.
+  void SetScanThreadCount(u32 count) { m_scan_thread_count = count; }
+
   void AddDirectory(std::string path, bool recursive);
+
+  /// Without invalidation, only directories which have changed since the last refresh are scanned again. Files which
+  /// are modified in place, without being renamed, aren't picked up until the cache is invalidated.
   void Refresh(bool invalidate_cache, bool invalidate_database, ProgressCallback* progress = nullptr);
 
   void UpdateCompatibilityEntry(GameListCompatibilityEntry new_entry, bool save_to_list = true);
@@ -108,11 +125,13 @@ private:
   enum : u32
   {
     GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-    GAME_LIST_CACHE_VERSION = 19
+    GAME_LIST_CACHE_VERSION = 19,
+    MIN_AUTO_SCAN_THREADS = 4,
+    MAX_SCAN_THREADS = 64
   };
 
-  using DatabaseMap = std::unordered_map<std::string, GameListDatabaseEntry>;
   using CacheMap = std::unordered_map<std::string, GameListEntry>;
+  using EntryIndexMap = std::unordered_map<std::string, u32>;
   using CompatibilityMap = std::unordered_map<std::string, GameListCompatibilityEntry>;
 
   struct DirectoryEntry
@@ -121,17 +140,33 @@ private:
     bool recursive;
   };
 
+  /// What a search directory contained when it was last scanned. Adding, removing or renaming a file changes the
+  /// modification time of the directory containing it, so the directories are all that need checking.
+  struct DirectoryScanState
+  {
+    std::string path;
+    bool recursive;
+    std::vector<std::pair<std::string, u64>> directory_times;
+    std::vector<std::string> entry_paths;
+  };
+
+  class CompiledTable;
   class RedumpDatVisitor;
   class CompatibilityListVisitor;
 
   GameListEntry* GetMutableEntryForPath(const char* path);
+  void AddEntry(GameListEntry entry);
+  void ClearEntries();
 
   static bool GetExeListEntry(const char* path, GameListEntry* entry);
   bool GetM3UListEntry(const char* path, GameListEntry* entry);
 
   bool GetGameListEntry(const std::string& path, GameListEntry* entry);
   bool GetGameListEntryFromCache(const std::string& path, GameListEntry* entry);
-  void ScanDirectory(const char* path, bool recursive, ProgressCallback* progress);
+  void ScanDirectory(const char* path, bool recursive, ProgressCallback* progress, DirectoryScanState* state);
+  bool RestoreDirectory(DirectoryScanState& state);
+  void ProbeEntries(std::vector<GameListEntry>& entries, const std::vector<u32>& indices, ProgressCallback* progress);
+  u32 GetScanThreadCount() const;
 
   void LoadCache();
   bool LoadEntriesFromCache(ByteStream* stream);
@@ -146,15 +181,19 @@ private:
   void ClearDatabase();
 
   void LoadCompatibilityList();
-  bool LoadCompatibilityListFromXML(const std::string& xml);
+  static bool LoadCompatibilityListFromXML(const std::string& xml, CompatibilityMap* list);
   bool SaveCompatibilityDatabaseForEntry(const GameListCompatibilityEntry* entry);
 
   void LoadGameSettings();
 
-  DatabaseMap m_database;
+  std::unique_ptr<CompiledTable> m_compiled_database;
+  std::unique_ptr<CompiledTable> m_compiled_compatibility_list;
   EntryList m_entries;
+  EntryIndexMap m_entry_index;
   CacheMap m_cache_map;
-  CompatibilityMap m_compatibility_list;
+  std::vector<DirectoryScanState> m_directory_scan_state;
+  u32 m_cache_record_count = 0;
+  CompatibilityMap m_compatibility_list; // changed entries, on top of the compiled list
   GameSettings::Database m_game_settings;
   std::unique_ptr<ByteStream> m_cache_write_stream;
 
@@ -163,6 +202,9 @@ private:
   std::string m_user_database_filename;
   std::string m_user_compatibility_list_filename;
   std::string m_user_game_settings_filename;
+  std::string m_compiled_database_filename;
+  std::string m_compiled_compatibility_list_filename;
+  u32 m_scan_thread_count = 0;
   bool m_database_load_tried = false;
   bool m_compatibility_list_load_tried = false;
   bool m_game_settings_load_tried = false;
@@ -0,0 +1,252 @@
+#include "save_state_io_thread.h"
+#include "common/byte_stream.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/timer.h"
+#include "core/system.h"
+Log_SetChannel(SaveStateIOThread);
+
+namespace FrontendCommon {
+
+SaveStateIOThread::SaveStateIOThread() = default;
+
+SaveStateIOThread::~SaveStateIOThread()
+{
+  StopThread();
+}
+
+void SaveStateIOThread::StartThread()
+{
+  if (IsUsingThread())
+    return;
+
+  m_shutdown_flag = false;
+  m_thread = std::thread(&SaveStateIOThread::WorkerThreadEntryPoint, this);
+}
+
+void SaveStateIOThread::StopThread()
+{
+  if (!IsUsingThread())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_prefetch_path.clear();
+    m_shutdown_flag = true;
+    m_work_cv.notify_one();
+  }
+
+  m_thread.join();
+}
+
+void SaveStateIOThread::QueueWrite(std::string path, std::unique_ptr<GrowableMemoryByteStream> state,
+                                   u32 compression_level, bool create_backup, bool global, s32 slot)
+{
+  WriteRequest request{std::move(path), std::move(state), compression_level, create_backup, global, slot};
+  if (!IsUsingThread())
+  {
+    const bool result = DoWrite(request);
+    m_write_results.push_back(WriteResult{std::move(request.path), request.slot, request.global, result});
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_write_queue.push_back(std::move(request));
+  m_work_cv.notify_one();
+}
+
+void SaveStateIOThread::WaitForWrites()
+{
+  if (!IsUsingThread())
+    return;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_write_queue.empty() && !m_write_in_progress)
+    return;
+
+  Common::Timer wait_timer;
+  m_writes_done_cv.wait(lock, [this]() { return m_write_queue.empty() && !m_write_in_progress; });
+  Log_DevPrintf("Waited %.2f msec for save state writes", wait_timer.GetTimeMilliseconds());
+}
+
+std::vector<SaveStateIOThread::WriteResult> SaveStateIOThread::TakeWriteResults()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::vector<WriteResult> results;
+  results.swap(m_write_results);
+  return results;
+}
+
+void SaveStateIOThread::Prefetch(std::string path)
+{
+  if (!IsUsingThread())
+    return;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_cached_file.data && m_cached_file.path == path)
+    return;
+
+  m_prefetch_path = std::move(path);
+  m_work_cv.notify_one();
+}
+
+std::unique_ptr<ByteStream> SaveStateIOThread::OpenForReading(const char* path)
+{
+  WaitForWrites();
+
+  FILESYSTEM_STAT_DATA sd;
+  if (FileSystem::StatFile(path, &sd))
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_cached_file.data && m_cached_file.path == path &&
+        m_cached_file.modification_time == static_cast<u64>(sd.ModificationTime.AsUnixTimestamp()) &&
+        m_cached_file.size == sd.Size)
+    {
+      Log_DevPrintf("Using cached copy of '%s'", path);
+      m_cached_file.path.clear();
+      return std::move(m_cached_file.data);
+    }
+  }
+
+  return FileSystem::OpenFile(path, BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+}
+
+bool SaveStateIOThread::DoWrite(WriteRequest& request)
+{
+  Common::Timer timer;
+
+  std::unique_ptr<GrowableMemoryByteStream> compressed = ByteStream_CreateGrowableMemoryStream();
+  if (!System::CompressState(request.state->GetMemoryPointer(), static_cast<u32>(request.state->GetSize()),
+                             compressed.get(), request.compression_level))
+  {
+    Log_ErrorPrintf("Failed to compress save state for '%s'", request.path.c_str());
+    return false;
+  }
+  request.state.reset();
+
+  const u32 compressed_size = static_cast<u32>(compressed->GetSize());
+  std::unique_ptr<ByteStream> stream =
+    FileSystem::OpenFile(request.path.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE |
+                                                 BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_ATOMIC_UPDATE |
+                                                 BYTESTREAM_OPEN_STREAMED | BYTESTREAM_OPEN_SYNC_ON_COMMIT);
+  if (!stream)
+  {
+    Log_ErrorPrintf("Failed to open '%s' for writing", request.path.c_str());
+    return false;
+  }
+
+  if (!stream->Write2(compressed->GetMemoryPointer(), compressed_size))
+  {
+    Log_ErrorPrintf("Failed to write save state to '%s'", request.path.c_str());
+    stream->Discard();
+    return false;
+  }
+
+  // The old file is copied rather than moved, so the slot still holds a state if the commit below fails.
+  if (request.create_backup && FileSystem::FileExists(request.path.c_str()))
+  {
+    const std::string backup_path(request.path + ".backup");
+    const std::optional<std::vector<u8>> old_data = FileSystem::ReadBinaryFile(request.path.c_str());
+    if (!old_data.has_value() ||
+        !FileSystem::WriteBinaryFile(backup_path.c_str(), old_data->data(), old_data->size()))
+    {
+      Log_WarningPrintf("Failed to back up '%s'", request.path.c_str());
+    }
+  }
+
+  if (!stream->Commit())
+  {
+    Log_ErrorPrintf("Failed to commit save state to '%s'", request.path.c_str());
+    return false;
+  }
+
+  stream.reset();
+  Log_InfoPrintf("Wrote %u bytes to '%s' in %.2f msec", compressed_size, request.path.c_str(),
+                 timer.GetTimeMilliseconds());
+
+  // Loading the state we just saved is common, keep it around.
+  compressed->SeekAbsolute(0);
+  SetCachedFile(request.path, std::move(compressed));
+  return true;
+}
+
+void SaveStateIOThread::DoPrefetch(const std::string& path)
+{
+  Common::Timer timer;
+
+  std::unique_ptr<ByteStream> stream = FileSystem::OpenFile(path.c_str(), BYTESTREAM_OPEN_READ);
+  if (!stream)
+    return;
+
+  const u32 size = static_cast<u32>(stream->GetSize());
+  std::unique_ptr<GrowableMemoryByteStream> data = ByteStream_CreateGrowableMemoryStream(nullptr, size);
+  data->Resize(size);
+  if (!stream->Read2(data->GetMemoryPointer(), size))
+  {
+    Log_WarningPrintf("Failed to prefetch '%s'", path.c_str());
+    return;
+  }
+
+  Log_DevPrintf("Prefetched %u bytes from '%s' in %.2f msec", size, path.c_str(), timer.GetTimeMilliseconds());
+  SetCachedFile(path, std::move(data));
+}
+
+void SaveStateIOThread::SetCachedFile(const std::string& path, std::unique_ptr<GrowableMemoryByteStream> data)
+{
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(path.c_str(), &sd))
+    return;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cached_file.path = path;
+  m_cached_file.modification_time = static_cast<u64>(sd.ModificationTime.AsUnixTimestamp());
+  m_cached_file.size = sd.Size;
+  m_cached_file.data = std::move(data);
+}
+
+void SaveStateIOThread::WorkerThreadEntryPoint()
+{
+  Log_DevPrintf("Save state I/O thread started");
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;)
+  {
+    m_work_cv.wait(lock, [this]() { return m_shutdown_flag || !m_write_queue.empty() || !m_prefetch_path.empty(); });
+
+    // Writes take priority, and are always finished before shutting down.
+    if (!m_write_queue.empty())
+    {
+      WriteRequest request(std::move(m_write_queue.front()));
+      m_write_queue.pop_front();
+      m_write_in_progress = true;
+      lock.unlock();
+
+      const bool result = DoWrite(request);
+
+      lock.lock();
+      m_write_results.push_back(WriteResult{std::move(request.path), request.slot, request.global, result});
+      m_write_in_progress = false;
+      if (m_write_queue.empty())
+        m_writes_done_cv.notify_all();
+
+      continue;
+    }
+
+    if (!m_prefetch_path.empty())
+    {
+      const std::string path(std::move(m_prefetch_path));
+      m_prefetch_path.clear();
+      lock.unlock();
+      DoPrefetch(path);
+      lock.lock();
+      continue;
+    }
+
+    if (m_shutdown_flag)
+      break;
+  }
+
+  Log_DevPrintf("Save state I/O thread exiting");
+}
+
+} // namespace FrontendCommon
@@ -0,0 +1,93 @@
+#pragma once
+#include "common/types.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ByteStream;
+class GrowableMemoryByteStream;
+
+namespace FrontendCommon {
+
+/// Moves save state disk access off the emulation thread. The emulation thread captures an uncompressed snapshot into
+/// memory, this thread compresses it, writes it out, syncs it to disk and keeps the previous file as a backup. Slot
+/// files can also be read ahead of time, so loading doesn't have to wait for the disk.
+class SaveStateIOThread
+{
+public:
+  struct WriteResult
+  {
+    std::string path;
+    s32 slot;
+    bool global;
+    bool success;
+  };
+
+  SaveStateIOThread();
+  ~SaveStateIOThread();
+
+  bool IsUsingThread() const { return m_thread.joinable(); }
+  void StartThread();
+
+  /// Finishes any queued writes before stopping.
+  void StopThread();
+
+  /// Queues a state from System::SaveState(), which must be uncompressed, to be written in the background.
+  void QueueWrite(std::string path, std::unique_ptr<GrowableMemoryByteStream> state, u32 compression_level,
+                  bool create_backup, bool global, s32 slot);
+
+  /// Blocks until every queued write has finished.
+  void WaitForWrites();
+
+  /// Returns the results of writes which have finished since the last call.
+  std::vector<WriteResult> TakeWriteResults();
+
+  /// Reads the file into memory in the background.
+  void Prefetch(std::string path);
+
+  /// Opens the file for reading. If it was prefetched or just written, and hasn't changed on disk since, the copy in
+  /// memory is used instead. Waits for any pending write first.
+  std::unique_ptr<ByteStream> OpenForReading(const char* path);
+
+private:
+  struct WriteRequest
+  {
+    std::string path;
+    std::unique_ptr<GrowableMemoryByteStream> state;
+    u32 compression_level;
+    bool create_backup;
+    bool global;
+    s32 slot;
+  };
+
+  struct CachedFile
+  {
+    std::string path;
+    u64 modification_time = 0;
+    u64 size = 0;
+    std::unique_ptr<GrowableMemoryByteStream> data;
+  };
+
+  bool DoWrite(WriteRequest& request);
+  void DoPrefetch(const std::string& path);
+  void SetCachedFile(const std::string& path, std::unique_ptr<GrowableMemoryByteStream> data);
+  void WorkerThreadEntryPoint();
+
+  std::mutex m_mutex;
+  std::thread m_thread;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_writes_done_cv;
+
+  std::deque<WriteRequest> m_write_queue;
+  std::vector<WriteResult> m_write_results;
+  std::string m_prefetch_path;
+  CachedFile m_cached_file;
+  bool m_write_in_progress = false;
+  bool m_shutdown_flag = true;
+};
+
+} // namespace FrontendCommon
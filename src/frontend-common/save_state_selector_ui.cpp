@@ -48,7 +48,7 @@ void SaveStateSelectorUI::RefreshList()
     for (s32 i = 1; i <= CommonHostInterface::PER_GAME_SAVE_STATE_SLOTS; i++)
     {
       std::optional<CommonHostInterface::ExtendedSaveStateInfo> ssi =
-        m_host_interface->GetExtendedSaveStateInfo(System::GetRunningCode().c_str(), i);
+        m_host_interface->GetExtendedSaveStateInfo(System::GetRunningCode().c_str(), i, false);
 
       ListEntry li;
       if (ssi)
@@ -63,7 +63,7 @@ void SaveStateSelectorUI::RefreshList()
   for (s32 i = 1; i <= CommonHostInterface::GLOBAL_SAVE_STATE_SLOTS; i++)
   {
     std::optional<CommonHostInterface::ExtendedSaveStateInfo> ssi =
-      m_host_interface->GetExtendedSaveStateInfo(nullptr, i);
+      m_host_interface->GetExtendedSaveStateInfo(nullptr, i, false);
 
     ListEntry li;
     if (ssi)
@@ -76,6 +76,8 @@ void SaveStateSelectorUI::RefreshList()
 
   if (m_slots.empty() || m_current_selection >= m_slots.size())
     m_current_selection = 0;
+
+  PrefetchSelectedSlot();
 }
 
 const char* SaveStateSelectorUI::GetSelectedStatePath() const
@@ -104,6 +106,7 @@ void SaveStateSelectorUI::SelectNextSlot()
 
   ResetOpenTimer();
   m_current_selection = (m_current_selection == static_cast<u32>(m_slots.size() - 1)) ? 0 : (m_current_selection + 1);
+  PrefetchSelectedSlot();
 }
 
 void SaveStateSelectorUI::SelectPreviousSlot()
@@ -117,6 +120,14 @@ void SaveStateSelectorUI::SelectPreviousSlot()
   ResetOpenTimer();
   m_current_selection =
     (m_current_selection == 0) ? (static_cast<u32>(m_slots.size()) - 1u) : (m_current_selection - 1);
+  PrefetchSelectedSlot();
+}
+
+void SaveStateSelectorUI::PrefetchSelectedSlot()
+{
+  const char* path = GetSelectedStatePath();
+  if (path)
+    m_host_interface->PrefetchSaveState(path);
 }
 
 void SaveStateSelectorUI::InitializeListEntry(ListEntry* li, CommonHostInterface::ExtendedSaveStateInfo* ssi)
@@ -127,6 +138,7 @@ void SaveStateSelectorUI::InitializeListEntry(ListEntry* li, CommonHostInterface
   li->formatted_timestamp = Timestamp::FromUnixTimestamp(ssi->timestamp).ToString("%c");
   li->slot = ssi->slot;
   li->global = ssi->global;
+  li->preview_loaded = !ssi->screenshot_data.empty();
 
   li->preview_texture.reset();
   if (ssi && !ssi->screenshot_data.empty())
@@ -146,6 +158,28 @@ void SaveStateSelectorUI::InitializeListEntry(ListEntry* li, CommonHostInterface
     Log_ErrorPrintf("Failed to upload save state image to GPU");
 }
 
+void SaveStateSelectorUI::LoadListEntryPreview(ListEntry* li)
+{
+  li->preview_loaded = true;
+
+  std::optional<CommonHostInterface::ExtendedSaveStateInfo> ssi = m_host_interface->GetExtendedSaveStateInfo(
+    li->global ? nullptr : System::GetRunningCode().c_str(), li->slot);
+  if (!ssi || ssi->screenshot_data.empty())
+    return;
+
+  std::unique_ptr<HostDisplayTexture> texture =
+    m_host_interface->GetDisplay()->CreateTexture(ssi->screenshot_width, ssi->screenshot_height,
+                                                  ssi->screenshot_data.data(), sizeof(u32) * ssi->screenshot_width,
+                                                  false);
+  if (!texture)
+  {
+    Log_ErrorPrintf("Failed to upload save state image to GPU");
+    return;
+  }
+
+  li->preview_texture = std::move(texture);
+}
+
 std::pair<s32, bool> SaveStateSelectorUI::GetSlotTypeFromSelection(u32 selection) const
 {
   if (selection < CommonHostInterface::PER_GAME_SAVE_STATE_SLOTS)
@@ -164,6 +198,7 @@ void SaveStateSelectorUI::InitializePlaceholderListEntry(ListEntry* li, s32 slot
   std::string().swap(li->formatted_timestamp);
   li->slot = slot;
   li->global = global;
+  li->preview_loaded = true;
 
   li->preview_texture =
     m_host_interface->GetDisplay()->CreateTexture(PLACEHOLDER_ICON_WIDTH, PLACEHOLDER_ICON_HEIGHT,
@@ -194,9 +229,12 @@ void SaveStateSelectorUI::Draw()
     const float item_height = image_size.y + padding * 2.0f;
     const float text_indent = image_size.x + padding + padding;
 
+    // Screenshots are only read once they scroll into view, and at most one per frame.
+    bool loaded_preview = false;
+
     for (size_t i = 0; i < m_slots.size(); i++)
     {
-      const ListEntry& entry = m_slots[i];
+      ListEntry& entry = m_slots[i];
       const float y_start = item_height * static_cast<float>(i);
 
       if (i == m_current_selection)
@@ -209,13 +247,17 @@ void SaveStateSelectorUI::Draw()
         ImGui::GetWindowDrawList()->AddRectFilled(p_start, p_end, ImColor(0.22f, 0.30f, 0.34f, 0.9f), rounding);
       }
 
-      if (entry.preview_texture)
+      ImGui::SetCursorPosY(y_start + padding);
+      ImGui::SetCursorPosX(padding);
+      if (!entry.preview_loaded && !loaded_preview && ImGui::IsRectVisible(image_size))
       {
-        ImGui::SetCursorPosY(y_start + padding);
-        ImGui::SetCursorPosX(padding);
-        ImGui::Image(reinterpret_cast<ImTextureID>(entry.preview_texture->GetHandle()), image_size);
+        LoadListEntryPreview(&entry);
+        loaded_preview = true;
       }
 
+      if (entry.preview_texture)
+        ImGui::Image(reinterpret_cast<ImTextureID>(entry.preview_texture->GetHandle()), image_size);
+
       ImGui::SetCursorPosY(y_start + padding);
 
       ImGui::Indent(text_indent);
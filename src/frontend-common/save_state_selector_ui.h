@@ -45,10 +45,13 @@ private:
     std::unique_ptr<HostDisplayTexture> preview_texture;
     s32 slot;
     bool global;
+    bool preview_loaded;
   };
 
   void InitializePlaceholderListEntry(ListEntry* li, s32 slot, bool global);
   void InitializeListEntry(ListEntry* li, CommonHostInterface::ExtendedSaveStateInfo* ssi);
+  void LoadListEntryPreview(ListEntry* li);
+  void PrefetchSelectedSlot();
   std::pair<s32, bool> GetSlotTypeFromSelection(u32 selection) const;
 
   CommonHostInterface* m_host_interface;